@@ -0,0 +1,164 @@
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "DiskRecorder.h"
+
+DiskRecorder::DiskRecorder (int numChannels, int fifoSizeInSamples) :
+	juce::Thread( "ARMor8 Disk Recorder" ),
+	m_Fifo( fifoSizeInSamples ),
+	m_FifoBuffer( numChannels, fifoSizeInSamples ),
+	m_Writer(),
+	m_Recording( false ),
+	m_Pushing( false ),
+	m_NumDroppedBlocks( 0 )
+{
+}
+
+DiskRecorder::~DiskRecorder()
+{
+	this->stopRecording();
+}
+
+bool DiskRecorder::startRecording (const juce::File& file, double sampleRate)
+{
+	this->stopRecording();
+
+	file.deleteFile();
+	std::unique_ptr<juce::FileOutputStream> outStream( file.createOutputStream() );
+	if ( outStream == nullptr )
+	{
+		return false;
+	}
+
+	std::unique_ptr<juce::AudioFormat> format;
+	if ( file.hasFileExtension("flac") )
+	{
+		format.reset( new juce::FlacAudioFormat() );
+	}
+	else
+	{
+		format.reset( new juce::WavAudioFormat() );
+	}
+
+	// flac only goes up to 24 bits, so just use the deepest bit depth each format supports
+	int bitDepth = format->getPossibleBitDepths().getLast();
+	juce::AudioFormatWriter* writer = format->createWriterFor( outStream.get(), sampleRate, m_FifoBuffer.getNumChannels(),
+									bitDepth, juce::StringPairArray(), 0 );
+	if ( writer == nullptr )
+	{
+		return false;
+	}
+
+	outStream.release(); // the writer owns the stream now
+	m_Writer.reset( writer );
+
+	m_Fifo.reset();
+	m_NumDroppedBlocks = 0;
+
+	this->startThread();
+	m_Recording = true;
+
+	return true;
+}
+
+void DiskRecorder::stopRecording()
+{
+	m_Recording = false;
+
+	// a pushBlock() that saw m_Recording before it was cleared may still be writing to the fifo, so wait for it before
+	// the final drain (and before startRecording() resets the fifo)
+	this->waitForPushBlock();
+
+	this->stopThread( 1000 );
+
+	if ( m_Writer != nullptr )
+	{
+		// anything the thread didn't get to before stopping
+		this->drainFifo();
+		m_Writer.reset();
+	}
+}
+
+bool DiskRecorder::isRecording()
+{
+	return m_Recording;
+}
+
+void DiskRecorder::pushBlock (const juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+	// set before m_Recording is checked, so stopRecording() either sees us pushing or we see it stopped
+	m_Pushing = true;
+
+	if ( ! m_Recording )
+	{
+		m_Pushing = false;
+		return;
+	}
+
+	if ( m_Fifo.getFreeSpace() < numSamples )
+	{
+		m_NumDroppedBlocks++;
+		m_Pushing = false;
+		return;
+	}
+
+	int start1, size1, start2, size2;
+	m_Fifo.prepareToWrite( numSamples, start1, size1, start2, size2 );
+
+	int numChannels = juce::jmin( buffer.getNumChannels(), m_FifoBuffer.getNumChannels() );
+	for ( int channel = 0; channel < numChannels; channel++ )
+	{
+		if ( size1 > 0 )
+		{
+			m_FifoBuffer.copyFrom( channel, start1, buffer, channel, startSample, size1 );
+		}
+
+		if ( size2 > 0 )
+		{
+			m_FifoBuffer.copyFrom( channel, start2, buffer, channel, startSample + size1, size2 );
+		}
+	}
+
+	m_Fifo.finishedWrite( size1 + size2 );
+
+	m_Pushing = false;
+}
+
+unsigned int DiskRecorder::getNumDroppedBlocks()
+{
+	return m_NumDroppedBlocks;
+}
+
+void DiskRecorder::run()
+{
+	while ( ! this->threadShouldExit() )
+	{
+		this->drainFifo();
+		this->wait( 5 );
+	}
+}
+
+void DiskRecorder::waitForPushBlock()
+{
+	// only ever as long as copying one block
+	while ( m_Pushing )
+	{
+		juce::Thread::yield();
+	}
+}
+
+void DiskRecorder::drainFifo()
+{
+	int start1, size1, start2, size2;
+	m_Fifo.prepareToRead( m_Fifo.getNumReady(), start1, size1, start2, size2 );
+
+	if ( size1 > 0 )
+	{
+		m_Writer->writeFromAudioSampleBuffer( m_FifoBuffer, start1, size1 );
+	}
+
+	if ( size2 > 0 )
+	{
+		m_Writer->writeFromAudioSampleBuffer( m_FifoBuffer, start2, size2 );
+	}
+
+	m_Fifo.finishedRead( size1 + size2 );
+}
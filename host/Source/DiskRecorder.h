@@ -0,0 +1,43 @@
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+#include <atomic>
+
+// The DiskRecorder class records the rendered audio to a wav or flac file. The audio thread only copies blocks into a
+// lock-free fifo, a background thread drains the fifo and does the actual disk writes. If the disk falls behind and the
+// fifo fills up, whole blocks are dropped and counted instead of blocking the audio thread.
+class DiskRecorder 	: public juce::Thread
+{
+	public:
+		DiskRecorder (int numChannels, int fifoSizeInSamples);
+		~DiskRecorder() override;
+
+		// the file extension decides the format, .flac for flac and anything else for wav
+		bool startRecording (const juce::File& file, double sampleRate);
+		void stopRecording();
+		bool isRecording();
+
+		// called from the audio thread, never blocks
+		void pushBlock (const juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+
+		unsigned int getNumDroppedBlocks();
+
+		// thread virtual functions
+		void run() override;
+
+	private:
+		juce::AbstractFifo m_Fifo;
+		juce::AudioBuffer<float> m_FifoBuffer;
+
+		std::unique_ptr<juce::AudioFormatWriter> m_Writer;
+
+		std::atomic<bool> m_Recording;
+		std::atomic<bool> m_Pushing; // set by the audio thread for the whole of pushBlock()
+		std::atomic<unsigned int> m_NumDroppedBlocks;
+
+		void waitForPushBlock();
+		void drainFifo();
+
+		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DiskRecorder)
+};
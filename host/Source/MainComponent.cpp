@@ -13,9 +13,12 @@
 #endif
 
 #include "MainComponent.h"
+#include "RealtimeSafetyChecker.h"
 
 #include "CPPFile.hpp"
 #include "ARMor8PresetUpgrader.hpp"
+#include "ARMor8PresetCodec.hpp"
+#include "ARMor8FactoryPresetStore.hpp"
 #include "ARMor8Constants.hpp"
 #include "ColorProfile.hpp"
 #include "FrameBuffer.hpp"
@@ -25,18 +28,34 @@
 const unsigned int FONT_FILE_SIZE = 779;
 const unsigned int LOGO_FILE_SIZE = 119;
 
+const uint32_t BOOT_STEPS_BUDGET_MICROSECONDS = 10000; // per timer tick, so the window stays responsive while booting
+const int LCD_FRAME_PERIOD_MILLISECONDS = 33; // the lcd refreshes are published once per timer tick
+
 const int OpRadioId = 1001;
 const int WaveRadioId = 1002;
 
+// microseconds for the boot sequencer, wrapping is fine
+static uint32_t bootClock()
+{
+	return static_cast<uint32_t>( static_cast<juce::uint64>(juce::Time::getMillisecondCounterHiRes() * 1000.0) );
+}
+
 //==============================================================================
 MainComponent::MainComponent() :
-	presetManager( sizeof(ARMor8PresetHeader), 20, new CPPFile("ARMor8Presets.spf") ),
+	presetManager( sizeof(ARMor8PresetHeader), ARMOR8_NUM_PRESETS, new CPPFile("ARMor8Presets.spf") ),
+	presetStore( &presetManager ),
+	presetBank(),
+	presetCacheMemory(),
+	presetCache( &presetBank, &presetCacheMemory ),
+	delayMemory(),
+	presetStorageService( &presetBank ),
+	presetStorageThread( presetStorageService ),
 	midiHandler(),
 	lastInputIndex( 0 ),
-	sAudioBuffer(),
-	armor8VoiceManager( &midiHandler, &presetManager ),
+	armor8VoiceManager( &midiHandler, &presetCache ),
 	keyButtonRelease( false ),
-	writer(),
+	bootSequencer( bootClock, 1 ), // already in microseconds
+	diskRecorder( 2, 1 << 17 ), // about 3 seconds of headroom at 44.1kHz before blocks are dropped
 	freqSldr(),
 	freqLbl(),
 	detuneSldr(),
@@ -86,6 +105,9 @@ MainComponent::MainComponent() :
 	glideLbl(),
 	egRetriggerBtn( "Glide Retrigger" ),
 	audioSettingsBtn( "Audio Settings" ),
+	recordBtn( "Record" ),
+	effectList(),
+	unisonList(),
 	midiInputList(),
 	midiInputListLbl(),
 	monoBtn( "Global: Monophonic" ),
@@ -152,11 +174,11 @@ MainComponent::MainComponent() :
 	Sprite* logo = new Sprite( (uint8_t*)logoBytes );
 	uiSim.setLogo( logo );
 
-	// this is to avoid unwanted audio on startup
-	armor8VoiceManager.setOperatorAmplitude(0, 0.0f);
-	armor8VoiceManager.setOperatorAmplitude(1, 0.0f);
-	armor8VoiceManager.setOperatorAmplitude(2, 0.0f);
-	armor8VoiceManager.setOperatorAmplitude(3, 0.0f);
+	// the audio starts with the init preset straight away, the presets are loaded in the background
+	armor8VoiceManager.setState( ARMor8FactoryPresetStore::getFactoryPreset(0) );
+
+	// the host has the headroom for rendering heavily modulated voices at up to 4x
+	armor8VoiceManager.setOversampling( true );
 
 	// Some platforms require permissions to open input channels so request that here
 	if ( juce::RuntimePermissions::isRequired (juce::RuntimePermissions::recordAudio)
@@ -171,32 +193,19 @@ MainComponent::MainComponent() :
 		setAudioChannels (2, 2);
 	}
 
-	// connecting the audio buffer to the voice manager
-	sAudioBuffer.registerCallback( &armor8VoiceManager );
-
 	// juce audio device setup
 	juce::AudioDeviceManager::AudioDeviceSetup deviceSetup = juce::AudioDeviceManager::AudioDeviceSetup();
 	deviceSetup.sampleRate = 44100;
 	deviceManager.initialise( 2, 2, 0, true, juce::String(), &deviceSetup );
 
+	bootSequencer.markAudioRunning();
+
 	// basic juce logging
 	// juce::Logger* log = juce::Logger::getCurrentLogger();
 	// int sampleRate = deviceManager.getCurrentAudioDevice()->getCurrentSampleRate();
 	// log->writeToLog( juce::String(sampleRate) );
 	// log->writeToLog( juce::String(deviceManager.getCurrentAudioDevice()->getCurrentBufferSizeSamples()) );
 
-	// optionally we can write wav files for debugging
-	// juce::WavAudioFormat wav;
-	// juce::File tempFile( "TestAudio.wav" );
-	// juce::OutputStream* outStream( tempFile.createOutputStream() );
-	// writer = wav.createWriterFor( outStream, sampleRate, 2, wav.getPossibleBitDepths().getLast(), NULL, 0 );
-
-	// log->writeToLog( juce::String(wav.getPossibleBitDepths().getLast()) );
-	// log->writeToLog( tempFile.getFullPathName() );
-
-	// this file can also be used for debugging
-	testFile.open( "JuceMainComponentOutput.txt" );
-
 	// adding all child components
 	addAndMakeVisible( freqSldr );
 	freqSldr.setRange( ARMOR8_FREQUENCY_MIN, ARMOR8_FREQUENCY_MAX );
@@ -401,6 +410,32 @@ MainComponent::MainComponent() :
 	addAndMakeVisible( audioSettingsBtn );
 	audioSettingsBtn.addListener( this );
 
+	addAndMakeVisible( recordBtn );
+	recordBtn.onClick = [this] { updateToggleState(&recordBtn); };
+
+	armor8VoiceManager.setDelayEffectMemory( &delayMemory, 0, sizeof(delayMemory) );
+	addAndMakeVisible( effectList );
+	effectList.addItem( "Effect: Off", 1 );
+	effectList.addItem( "Effect: Delay", 2 );
+	effectList.addItem( "Effect: Chorus", 3 );
+	effectList.setSelectedId( 1, juce::dontSendNotification );
+	effectList.onChange = [this] {
+		armor8VoiceManager.setDelayEffectMode( static_cast<DELAY_EFFECT_MODE>(effectList.getSelectedItemIndex()) );
+	};
+
+	// unison only stacks voices in monophonic mode, the stacked voices are spread across the stereo field
+	armor8VoiceManager.setUnisonDetune( 10 );
+	armor8VoiceManager.setUnisonSpread( 1.0f );
+	addAndMakeVisible( unisonList );
+	unisonList.addItem( "Unison: Off", 1 );
+	unisonList.addItem( "Unison: 2 Voices", 2 );
+	unisonList.addItem( "Unison: 4 Voices", 4 );
+	unisonList.addItem( "Unison: 6 Voices", 6 );
+	unisonList.setSelectedId( 1, juce::dontSendNotification );
+	unisonList.onChange = [this] {
+		armor8VoiceManager.setUnison( static_cast<unsigned int>(unisonList.getSelectedId()) );
+	};
+
 	addAndMakeVisible( midiInputList );
 	midiInputList.setTextWhenNoChoicesAvailable( "No MIDI Inputs Enabled" );
 	auto midiInputs = juce::MidiInput::getDevices();
@@ -427,172 +462,169 @@ MainComponent::MainComponent() :
 	monoBtn.onClick = [this] { updateToggleState(&monoBtn); };
 	monoBtn.addListener( this );
 
+	// the preset buttons stay disabled until the preset cache is loaded (see bootLoadFirstPreset()), before that browsing
+	// would read presets that aren't in the cache yet and a write would be overwritten (and forgotten) by the load
 	addAndMakeVisible( prevPresetBtn );
 	prevPresetBtn.addListener( this );
+	prevPresetBtn.setEnabled( false );
 
 	addAndMakeVisible( presetNumLbl );
 
 	addAndMakeVisible( nextPresetBtn );
 	nextPresetBtn.addListener( this );
+	nextPresetBtn.setEnabled( false );
 
 	addAndMakeVisible( writePresetBtn );
 	writePresetBtn.addListener( this );
+	writePresetBtn.setEnabled( false );
 
 	// Make sure you set the size of the component after
 	// you add any child components.
 	setSize( 800, 600 );
 
-	// TODO this should be done somewhere else
-	// upgrade presets if necessary
-	ARMor8VoiceState initPreset =
-	{
-		// operator 1
-		1000.0f,
-		false,
-		OscillatorMode::SINE,
-		0.0f,
-		2.0f,
-		0.0f,
-		2.0f,
-		1.0f,
-		0.0f,
-		2.0f,
-		false,
-		false,
-		false,
-		0.0f,
-		0.0f,
-		0.0f,
-		0.0f,
-		0.0f,
-		20000.0f,
-		0.0f,
-		0.0f,
-		0.0f,
-		0,
-
-		// operator 2
-		1000.0f,
-		false,
-		OscillatorMode::SINE,
-		0.0f,
-		2.0f,
-		0.0f,
-		2.0f,
-		1.0f,
-		0.0f,
-		2.0f,
-		false,
-		false,
-		false,
-		0.0f,
-		0.0f,
-		0.0f,
-		0.0f,
-		0.0f,
-		20000.0f,
-		0.0f,
-		0.0f,
-		0.0f,
-		0,
-
-		// operator 3
-		1000.0f,
-		false,
-		OscillatorMode::SINE,
-		0.0f,
-		2.0f,
-		0.0f,
-		2.0f,
-		1.0f,
-		0.0f,
-		2.0f,
-		false,
-		false,
-		false,
-		0.0f,
-		0.0f,
-		0.0f,
-		0.0f,
-		0.0f,
-		20000.0f,
-		0.0f,
-		0.0f,
-		0.0f,
-		0,
-
-		// operator 4
-		1000.0f,
-		false,
-		OscillatorMode::SINE,
-		0.0f,
-		2.0f,
-		0.0f,
-		2.0f,
-		1.0f,
-		0.0f,
-		2.0f,
-		false,
-		false,
-		false,
-		0.0f,
-		0.0f,
-		0.0f,
-		0.0f,
-		0.0f,
-		20000.0f,
-		0.0f,
-		0.0f,
-		0.0f,
-		0,
-
-		// global
-		false,
-		1,
-		0.0f,
-		false
-	};
-	ARMor8PresetUpgrader presetUpgrader( initPreset, armor8VoiceManager.getPresetHeader() );
-	presetManager.upgradePresets( &presetUpgrader );
+	bootSequencer.addTask( "upgrade presets", bootUpgradePresets, this );
+	bootSequencer.addTask( "open preset bank", bootOpenPresetBank, this );
+	bootSequencer.addTask( "load preset cache", bootLoadPresetCache, this );
+	bootSequencer.addTask( "start preset storage", bootStartPresetStorage, this );
+	bootSequencer.addTask( "load first preset", bootLoadFirstPreset, this );
 
 	// UI initialization
 	uiSim.draw();
 
-	// start timer for fake loading
-	this->startTimer( 33 );
+	// the boot tasks are run from the timer, with the loading logo up until they're done
+	this->startTimer( LCD_FRAME_PERIOD_MILLISECONDS );
 }
 
 MainComponent::~MainComponent()
 {
 	// This shuts down the audio device and clears the audio source.
 	shutdownAudio();
-	delete writer;
-	testFile.close();
+	diskRecorder.stopRecording();
+
+	// finish any queued writes, then write whatever is still dirty directly
+	presetStorageThread.stopThread( 1000 );
+	presetStorageService.processAllRequests();
+	presetCache.setStorageService( nullptr );
+	presetCache.flushAllPresets();
 }
 
 void MainComponent::timerCallback()
 {
-	static unsigned int fakeLoadingCounter = 0;
+	RealtimeSafetyChecker::reportViolations();
 
-	if ( fakeLoadingCounter == 100 )
+	if ( ! bootSequencer.isFinished() )
 	{
-		fakeLoadingCounter++;
+		uiSim.drawLoadingLogo();
 
-		// set preset to first preset
-		armor8VoiceManager.setState( presetManager.retrievePreset<ARMor8VoiceState>(0) );
+		if ( bootSequencer.runSteps(BOOT_STEPS_BUDGET_MICROSECONDS) )
+		{
+			uiSim.publishLCDRefreshes();
+			return;
+		}
 
-		// force UI to refresh
-		op1Btn.triggerClick();
+		this->printBootReport();
+	}
+	else
+	{
+		uiSim.tickForChangingBackToStatus();
 	}
-	else if ( fakeLoadingCounter < 100 )
+
+	// everything drawn since the last tick goes out as one frame
+	uiSim.publishLCDRefreshes();
+
+	// hand edited presets to the storage thread, the message thread never waits on the preset file
+	if ( presetCache.flushDirtyPreset() )
 	{
-		uiSim.drawLoadingLogo();
-		fakeLoadingCounter++;
+		presetStorageThread.notify();
+	}
+}
+
+// TODO this should be done somewhere else
+// upgrade presets if necessary
+bool MainComponent::bootUpgradePresets (void* context)
+{
+	MainComponent* mainComponent = static_cast<MainComponent*>( context );
+
+	ARMor8PresetUpgrader presetUpgrader( ARMor8FactoryPresetStore::getFactoryPreset(0),
+						mainComponent->armor8VoiceManager.getPresetHeader() );
+	mainComponent->presetManager.upgradePresets( &presetUpgrader );
+
+	return true;
+}
+
+// presets missing from the bank are taken from the (upgraded) preset file, and the factory presets go in any slots that
+// are still the init preset.
+// if the bank can't be mapped the preset file is used directly instead, so there are fewer presets but nothing is lost
+bool MainComponent::bootOpenPresetBank (void* context)
+{
+	MainComponent* mainComponent = static_cast<MainComponent*>( context );
+
+	if ( mainComponent->presetBank.open(juce::File::getCurrentWorkingDirectory().getChildFile("ARMor8Presets.apb"),
+						ARMOR8_PRESET_CACHE_MAX_PRESETS) )
+	{
+		mainComponent->presetBank.importPresets( mainComponent->presetStore );
 	}
 	else
 	{
-		uiSim.tickForChangingBackToStatus();
+		std::cout << "FAILED TO OPEN PRESET BANK, USING THE PRESET FILE INSTEAD!" << std::endl;
+
+		mainComponent->presetCache.setPresetStore( &mainComponent->presetStore );
+		mainComponent->presetStorageService.setPresetStore( &mainComponent->presetStore );
+	}
+
+	mainComponent->presetCache.beginLoad();
+
+	return true;
+}
+
+// a preset per step, so a big bank doesn't hold up the message thread
+bool MainComponent::bootLoadPresetCache (void* context)
+{
+	MainComponent* mainComponent = static_cast<MainComponent*>( context );
+
+	return mainComponent->presetCache.loadNextPreset();
+}
+
+// from here on the preset bank is only written by the storage thread
+bool MainComponent::bootStartPresetStorage (void* context)
+{
+	MainComponent* mainComponent = static_cast<MainComponent*>( context );
+
+	mainComponent->presetCache.setStorageService( &mainComponent->presetStorageService );
+	mainComponent->presetStorageThread.startThread();
+
+	return true;
+}
+
+bool MainComponent::bootLoadFirstPreset (void* context)
+{
+	MainComponent* mainComponent = static_cast<MainComponent*>( context );
+
+	// set preset to first preset
+	mainComponent->armor8VoiceManager.setState( ARMor8PresetCodec::unpack(mainComponent->presetCache.retrievePreset(0)) );
+
+	// force UI to refresh
+	mainComponent->op1Btn.triggerClick();
+
+	// the cache is loaded and the storage thread is running, so presets can be browsed and written now
+	mainComponent->prevPresetBtn.setEnabled( true );
+	mainComponent->nextPresetBtn.setEnabled( true );
+	mainComponent->writePresetBtn.setEnabled( true );
+
+	return true;
+}
+
+void MainComponent::printBootReport()
+{
+	std::cout << "audio running after " << bootSequencer.getTimeToAudio() << "us" << std::endl;
+
+	for ( unsigned int taskNum = 0; taskNum < bootSequencer.getNumTasks(); taskNum++ )
+	{
+		const ARMor8BootTask& task = bootSequencer.getTask( taskNum );
+		std::cout << task.name << ": " << task.elapsedMicroseconds << "us in " << task.numSteps << " steps" << std::endl;
 	}
+
+	std::cout << "boot finished after " << bootSequencer.getTimeToFinish() << "us" << std::endl;
 }
 
 //==============================================================================
@@ -605,6 +637,9 @@ void MainComponent::prepareToPlay (int samplesPerBlockExpected, double sampleRat
 	// but be careful - it will be called on the audio thread, not the GUI thread.
 
 	// For more details, see the help for AudioProcessor::prepareToPlay()
+
+	// the block size doesn't matter since renderBlock() renders whatever it's asked for
+	armor8VoiceManager.setSampleRate( static_cast<float>(sampleRate) );
 }
 
 void MainComponent::getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill)
@@ -616,21 +651,36 @@ void MainComponent::getNextAudioBlock (const juce::AudioSourceChannelInfo& buffe
 	// Right now we are not producing any data, in which case we need to clear the buffer
 	// (to prevent the output of random noise)
 	// bufferToFill.clearActiveBufferRegion();
+
+	// flush denormals to zero while rendering, decaying filter and envelope tails get very slow on x86 otherwise
+	juce::ScopedNoDenormals noDenormals;
+
 	try
 	{
-		float* writePtrR = bufferToFill.buffer->getWritePointer( 1 );
-		float* writePtrL = bufferToFill.buffer->getWritePointer( 0 );
-		const float* readPtrR = bufferToFill.buffer->getReadPointer( 0 );
+		// the voice manager renders straight into the left and right channels at the host's block size, then the left
+		// channel is copied to any others
+		const int numChannels = bufferToFill.buffer->getNumChannels();
+		float* writePtrL = bufferToFill.buffer->getWritePointer( 0, bufferToFill.startSample );
+		{
+			RealtimeSafetyScope realtimeSafetyScope; // only does anything in ARMOR8_RT_SAFETY_CHECK builds
+			if ( numChannels > 1 )
+			{
+				float* writePtrR = bufferToFill.buffer->getWritePointer( 1, bufferToFill.startSample );
+				armor8VoiceManager.renderBlock( writePtrL, writePtrR, static_cast<unsigned int>(bufferToFill.numSamples) );
+			}
+			else
+			{
+				armor8VoiceManager.renderBlock( writePtrL, static_cast<unsigned int>(bufferToFill.numSamples) );
+			}
+		}
 
-		for ( int i = 0; i < bufferToFill.numSamples; i++ )
+		for ( int channel = 2; channel < numChannels; channel++ )
 		{
-			float value = sAudioBuffer.getNextSample();
-			writePtrR[i] = value;
-			writePtrL[i] = value;
-			// testFile << readPtrR[i] << std::endl;
+			float* writePtr = bufferToFill.buffer->getWritePointer( channel, bufferToFill.startSample );
+			juce::FloatVectorOperations::copy( writePtr, writePtrL, bufferToFill.numSamples );
 		}
 
-		sAudioBuffer.pollToFillBuffers();
+		diskRecorder.pushBlock( *bufferToFill.buffer, bufferToFill.startSample, bufferToFill.numSamples );
 	}
 	catch ( std::exception& e )
 	{
@@ -698,7 +748,10 @@ void MainComponent::resized()
 	pitchBendSldr.setBounds   (sliderLeft, 890, getWidth() - sliderLeft - 10, 20);
 	glideSldr.setBounds       (sliderLeft + (getWidth() / 5) * 0, 920, (getWidth() / 5) * 4 - sliderLeft - 10, 20);
 	egRetriggerBtn.setBounds  (sliderLeft + (getWidth() / 5) * 4, 920, (getWidth() / 5) * 1 - sliderLeft - 10, 20);
-	audioSettingsBtn.setBounds(sliderLeft, 950, getWidth() - sliderLeft - 10, 20);
+	audioSettingsBtn.setBounds(sliderLeft + (getWidth() / 5) * 0, 950, (getWidth() / 5) * 2 - sliderLeft - 10, 20);
+	unisonList.setBounds      (sliderLeft + (getWidth() / 5) * 2, 950, (getWidth() / 5) * 1 - sliderLeft - 10, 20);
+	effectList.setBounds      (sliderLeft + (getWidth() / 5) * 3, 950, (getWidth() / 5) * 1 - sliderLeft - 10, 20);
+	recordBtn.setBounds       (sliderLeft + (getWidth() / 5) * 4, 950, (getWidth() / 5) * 1 - sliderLeft - 10, 20);
 	midiInputList.setBounds   (sliderLeft, 980, getWidth() - sliderLeft - 10, 20);
 	monoBtn.setBounds         (sliderLeft + (getWidth() / 5) * 0, 1010, ((getWidth() - sliderLeft - 10) / 5), 20);
 	prevPresetBtn.setBounds   (sliderLeft + (getWidth() / 5) * 1, 1010, ((getWidth() - sliderLeft - 10) / 5), 20);
@@ -1287,6 +1340,28 @@ void MainComponent::updateToggleState (juce::Button* button)
 			uiSim.processGlideRetrigBtn( false ); // released
 			uiSim.processGlideRetrigBtn( false ); // floating
 		}
+		else if (button == &recordBtn)
+		{
+			if (isPressed)
+			{
+				juce::AudioIODevice* device = deviceManager.getCurrentAudioDevice();
+				double sampleRate = ( device != nullptr ) ? device->getCurrentSampleRate() : 44100.0;
+				if ( ! diskRecorder.startRecording(juce::File::getCurrentWorkingDirectory().getChildFile("ARMor8Recording.wav"), sampleRate) )
+				{
+					std::cout << "Couldn't start recording to ARMor8Recording.wav" << std::endl;
+					recordBtn.setToggleState( false, juce::dontSendNotification );
+				}
+			}
+			else
+			{
+				diskRecorder.stopRecording();
+
+				if ( diskRecorder.getNumDroppedBlocks() > 0 )
+				{
+					std::cout << "Recording dropped " << diskRecorder.getNumDroppedBlocks() << " blocks" << std::endl;
+				}
+			}
+		}
 	}
 	catch (std::exception& e)
 	{
@@ -1296,7 +1371,8 @@ void MainComponent::updateToggleState (juce::Button* button)
 
 void MainComponent::onARMor8PresetChangedEvent (const ARMor8PresetEvent& presetEvent)
 {
-	this->setFromARMor8VoiceState( presetEvent.getPreset(), presetEvent.getOpToEdit(), presetEvent.getPresetNum() );
+	this->setFromARMor8VoiceState( presetEvent.getPreset(), presetEvent.getOpToEdit(), presetEvent.getPresetNum(),
+					presetEvent.getChangedFields() );
 }
 
 void MainComponent::onARMor8LCDRefreshEvent (const ARMor8LCDRefreshEvent& lcdRefreshEvent)
@@ -1306,438 +1382,166 @@ void MainComponent::onARMor8LCDRefreshEvent (const ARMor8LCDRefreshEvent& lcdRef
 	this->repaint();
 }
 
-void MainComponent::setFromARMor8VoiceState (const ARMor8VoiceState& state, unsigned int opToEdit, unsigned int presetNum)
+void MainComponent::setFromARMor8VoiceState (const ARMor8VoiceState& state, unsigned int opToEdit, unsigned int presetNum,
+						unsigned int changedFields)
 {
+	// only the widgets for values that changed since the last preset event are touched
+	auto changed = [changedFields] (const ARMor8PresetField& field)
+	{
+		return ( changedFields & static_cast<unsigned int>(field) ) != 0;
+	};
+
 	try
 	{
 		// set preset num label
-		juce::String presetNumStr( presetNum + 1 );
-		presetNumLbl.setText( presetNumStr, juce::dontSendNotification );
+		if ( changed(ARMor8PresetField::PRESET_NUM) )
+		{
+			juce::String presetNumStr( presetNum + 1 );
+			presetNumLbl.setText( presetNumStr, juce::dontSendNotification );
+		}
 
 		// handle global states first
-		pitchBendSldr.setValue( state.pitchBendSemitones, juce::dontSendNotification );
-		glideSldr.setValue( state.glideTime, juce::dontSendNotification );
-		if ( !egRetriggerBtn.getToggleState() )
+		if ( changed(ARMor8PresetField::PITCH_BEND) )
 		{
-			if ( state.glideRetrigger )
-			{
-				egRetriggerBtn.setToggleState( true, juce::dontSendNotification );
-			}
+			pitchBendSldr.setValue( state.pitchBendSemitones, juce::dontSendNotification );
 		}
-		else
+		if ( changed(ARMor8PresetField::GLIDE_TIME) )
 		{
-			if ( !state.glideRetrigger )
-			{
-				egRetriggerBtn.setToggleState( false, juce::dontSendNotification );
-			}
+			glideSldr.setValue( state.glideTime, juce::dontSendNotification );
 		}
-		if ( !monoBtn.getToggleState() )
+		if ( changed(ARMor8PresetField::GLIDE_RETRIGGER) )
 		{
-			if ( state.monophonic )
+			egRetriggerBtn.setToggleState( state.glideRetrigger, juce::dontSendNotification );
+		}
+		if ( changed(ARMor8PresetField::MONOPHONIC) )
+		{
+			monoBtn.setToggleState( state.monophonic, juce::dontSendNotification );
+		}
+
+		if ( changed(ARMor8PresetField::OP_TO_EDIT) )
+		{
+			switch ( opToEdit )
 			{
-				monoBtn.setToggleState( true, juce::dontSendNotification );
+				case 0:
+					op1Btn.setToggleState( true, juce::dontSendNotification );
+					break;
+				case 1:
+					op2Btn.setToggleState( true, juce::dontSendNotification );
+					break;
+				case 2:
+					op3Btn.setToggleState( true, juce::dontSendNotification );
+					break;
+				case 3:
+					op4Btn.setToggleState( true, juce::dontSendNotification );
+					break;
+				default:
+					std::cout << "Something is terribly, terribly wrong in setFromARMor8VoiceState..." << std::endl;
 			}
 		}
-		else
+
+		ARMor8OperatorState op = ARMor8PatchSnapshot::getOperatorState( state, opToEdit );
+
+		if ( changed(ARMor8PresetField::FREQUENCY) )
 		{
-			if ( !state.monophonic )
+			freqSldr.setValue( op.frequency, juce::dontSendNotification );
+		}
+		if ( changed(ARMor8PresetField::RATIO) )
+		{
+			ratioBtn.setToggleState( op.useRatio, juce::dontSendNotification );
+		}
+		if ( changed(ARMor8PresetField::WAVE) )
+		{
+			switch ( op.wave )
 			{
-				monoBtn.setToggleState( false, juce::dontSendNotification );
+				case OscillatorMode::SINE:
+					sineBtn.setToggleState( true, juce::dontSendNotification );
+					break;
+				case OscillatorMode::TRIANGLE:
+					triangleBtn.setToggleState( true, juce::dontSendNotification );
+					break;
+				case OscillatorMode::SQUARE:
+					squareBtn.setToggleState( true, juce::dontSendNotification );
+					break;
+				case OscillatorMode::SAWTOOTH:
+					sawBtn.setToggleState( true, juce::dontSendNotification );
+					break;
+				default:
+					std::cout << "Wave not recognized in setFromARMor8VoiceState..." << std::endl;
 			}
 		}
-
-		switch ( opToEdit )
+		if ( changed(ARMor8PresetField::ATTACK) )
 		{
-			case 0:
-				op1Btn.setToggleState( true, juce::dontSendNotification );
-
-				freqSldr.setValue( state.frequency1, juce::dontSendNotification );
-				if ( ratioBtn.getToggleState() )
-				{
-					if ( !state.useRatio1 )
-					{
-						ratioBtn.setToggleState( false, juce::dontSendNotification );
-					}
-				}
-				else
-				{
-					if ( state.useRatio1 )
-					{
-						ratioBtn.setToggleState( true, juce::dontSendNotification );
-					}
-				}
-				switch ( state.wave1 )
-				{
-					case OscillatorMode::SINE:
-						sineBtn.setToggleState( true, juce::dontSendNotification );
-						break;
-					case OscillatorMode::TRIANGLE:
-						triangleBtn.setToggleState( true, juce::dontSendNotification );
-						break;
-					case OscillatorMode::SQUARE:
-						squareBtn.setToggleState( true, juce::dontSendNotification );
-						break;
-					case OscillatorMode::SAWTOOTH:
-						sawBtn.setToggleState( true, juce::dontSendNotification );
-						break;
-					default:
-						std::cout << "Wave not recognized in setFromARMor8VoiceState..." << std::endl;
-				}
-				attackSldr.setValue( state.attack1, juce::dontSendNotification );
-				attackExpoSldr.setValue( state.attackExpo1, juce::dontSendNotification );
-				decaySldr.setValue( state.decay1, juce::dontSendNotification );
-				decayExpoSldr.setValue( state.decayExpo1, juce::dontSendNotification );
-				sustainSldr.setValue( state.sustain1, juce::dontSendNotification );
-				releaseSldr.setValue( state.release1, juce::dontSendNotification );
-				releaseExpoSldr.setValue( state.releaseExpo1, juce::dontSendNotification );
-				if ( amplitudeDestBtn.getToggleState() )
-				{
-					if ( !state.egAmplitudeMod1 )
-					{
-						amplitudeDestBtn.setToggleState( false, juce::dontSendNotification );
-					}
-				}
-				else
-				{
-					if ( state.egAmplitudeMod1 )
-					{
-						amplitudeDestBtn.setToggleState( true, juce::dontSendNotification );
-					}
-				}
-				if ( frequencyDestBtn.getToggleState() )
-				{
-					if (!state.egFrequencyMod1)
-					{
-						frequencyDestBtn.setToggleState( false, juce::dontSendNotification );
-					}
-				}
-				else
-				{
-
-					if ( state.egFrequencyMod1 )
-					{
-						frequencyDestBtn.setToggleState( true, juce::dontSendNotification );
-					}
-				}
-				if ( filterDestBtn.getToggleState() )
-				{
-					if ( !state.egFilterMod1 )
-					{
-						filterDestBtn.setToggleState( false, juce::dontSendNotification );
-					}
-				}
-				else
-				{
-					if ( state.egFilterMod1 )
-					{
-						filterDestBtn.setToggleState( true, juce::dontSendNotification );
-					}
-				}
-				op1ModAmountSldr.setValue( state.op1ModAmount1, juce::dontSendNotification );
-				op2ModAmountSldr.setValue( state.op2ModAmount1, juce::dontSendNotification );
-				op3ModAmountSldr.setValue( state.op3ModAmount1, juce::dontSendNotification );
-				op4ModAmountSldr.setValue( state.op4ModAmount1, juce::dontSendNotification );
-				amplitudeSldr.setValue( state.amplitude1, juce::dontSendNotification );
-				filterFreqSldr.setValue( state.filterFreq1, juce::dontSendNotification );
-				filterResSldr.setValue( state.filterRes1, juce::dontSendNotification );
-				ampVelSldr.setValue( state.ampVelSens1, juce::dontSendNotification );
-				filtVelSldr.setValue( state.filtVelSens1, juce::dontSendNotification );
-				detuneSldr.setValue( state.detune1, juce::dontSendNotification );
-
-				break;
-			case 1:
-				op2Btn.setToggleState( true, juce::dontSendNotification );
-
-				freqSldr.setValue( state.frequency2, juce::dontSendNotification );
-				if ( ratioBtn.getToggleState() )
-				{
-					if ( !state.useRatio2 )
-					{
-						ratioBtn.setToggleState( false, juce::dontSendNotification );
-					}
-				}
-				else
-				{
-					if ( state.useRatio2 )
-					{
-						ratioBtn.setToggleState( true, juce::dontSendNotification );
-					}
-				}
-				switch ( state.wave2 )
-				{
-					case OscillatorMode::SINE:
-						sineBtn.setToggleState( true, juce::dontSendNotification );
-						break;
-					case OscillatorMode::TRIANGLE:
-						triangleBtn.setToggleState( true, juce::dontSendNotification );
-						break;
-					case OscillatorMode::SQUARE:
-						squareBtn.setToggleState( true, juce::dontSendNotification );
-						break;
-					case OscillatorMode::SAWTOOTH:
-						sawBtn.setToggleState( true, juce::dontSendNotification );
-						break;
-					default:
-						std::cout << "Wave not recognized in setFromARMor8VoiceState..." << std::endl;
-				}
-				attackSldr.setValue( state.attack2, juce::dontSendNotification );
-				attackExpoSldr.setValue( state.attackExpo2, juce::dontSendNotification );
-				decaySldr.setValue( state.decay2, juce::dontSendNotification );
-				decayExpoSldr.setValue( state.decayExpo2, juce::dontSendNotification );
-				sustainSldr.setValue( state.sustain2, juce::dontSendNotification );
-				releaseSldr.setValue( state.release2, juce::dontSendNotification );
-				releaseExpoSldr.setValue( state.releaseExpo2, juce::dontSendNotification );
-				if ( amplitudeDestBtn.getToggleState() )
-				{
-					if ( !state.egAmplitudeMod2 )
-					{
-						amplitudeDestBtn.setToggleState( false, juce::dontSendNotification );
-					}
-				}
-				else
-				{
-					if ( state.egAmplitudeMod2 )
-					{
-						amplitudeDestBtn.setToggleState( true, juce::dontSendNotification );
-					}
-				}
-				if ( frequencyDestBtn.getToggleState() )
-				{
-					if ( !state.egFrequencyMod2 )
-					{
-						frequencyDestBtn.setToggleState( false, juce::dontSendNotification );
-					}
-				}
-				else
-				{
-
-					if ( state.egFrequencyMod2 )
-					{
-						frequencyDestBtn.setToggleState( true, juce::dontSendNotification );
-					}
-				}
-				if ( filterDestBtn.getToggleState() )
-				{
-					if ( !state.egFilterMod2 )
-					{
-						filterDestBtn.setToggleState( false, juce::dontSendNotification );
-					}
-				}
-				else
-				{
-					if ( state.egFilterMod2 )
-					{
-						filterDestBtn.setToggleState( true, juce::dontSendNotification );
-					}
-				}
-				op1ModAmountSldr.setValue( state.op1ModAmount2, juce::dontSendNotification );
-				op2ModAmountSldr.setValue( state.op2ModAmount2, juce::dontSendNotification );
-				op3ModAmountSldr.setValue( state.op3ModAmount2, juce::dontSendNotification );
-				op4ModAmountSldr.setValue( state.op4ModAmount2, juce::dontSendNotification );
-				amplitudeSldr.setValue( state.amplitude2, juce::dontSendNotification );
-				filterFreqSldr.setValue( state.filterFreq2, juce::dontSendNotification);
-				filterResSldr.setValue( state.filterRes2, juce::dontSendNotification);
-				ampVelSldr.setValue( state.ampVelSens2, juce::dontSendNotification );
-				filtVelSldr.setValue( state.filtVelSens2, juce::dontSendNotification );
-				detuneSldr.setValue( state.detune2, juce::dontSendNotification );
-
-				break;
-			case 2:
-				op3Btn.setToggleState( true, juce::dontSendNotification );
-
-				freqSldr.setValue( state.frequency3, juce::dontSendNotification );
-				if ( ratioBtn.getToggleState() )
-				{
-					if ( !state.useRatio3 )
-					{
-						ratioBtn.setToggleState( false, juce::dontSendNotification );
-					}
-				}
-				else
-				{
-					if ( state.useRatio3 )
-					{
-						ratioBtn.setToggleState( true, juce::dontSendNotification );
-					}
-				}
-				switch ( state.wave3 )
-				{
-					case OscillatorMode::SINE:
-						sineBtn.setToggleState( true, juce::dontSendNotification );
-						break;
-					case OscillatorMode::TRIANGLE:
-						triangleBtn.setToggleState( true, juce::dontSendNotification );
-						break;
-					case OscillatorMode::SQUARE:
-						squareBtn.setToggleState( true, juce::dontSendNotification );
-						break;
-					case OscillatorMode::SAWTOOTH:
-						sawBtn.setToggleState( true, juce::dontSendNotification );
-						break;
-					default:
-						std::cout << "Wave not recognized in setFromARMor8VoiceState..." << std::endl;
-				}
-				attackSldr.setValue( state.attack3, juce::dontSendNotification );
-				attackExpoSldr.setValue( state.attackExpo3, juce::dontSendNotification );
-				decaySldr.setValue( state.decay3, juce::dontSendNotification );
-				decayExpoSldr.setValue( state.decayExpo3, juce::dontSendNotification );
-				sustainSldr.setValue( state.sustain3, juce::dontSendNotification );
-				releaseSldr.setValue( state.release3, juce::dontSendNotification );
-				releaseExpoSldr.setValue( state.releaseExpo3, juce::dontSendNotification );
-				if ( amplitudeDestBtn.getToggleState() )
-				{
-					if ( !state.egAmplitudeMod3 )
-					{
-						amplitudeDestBtn.setToggleState( false, juce::dontSendNotification );
-					}
-				}
-				else
-				{
-					if ( state.egAmplitudeMod3 )
-					{
-						amplitudeDestBtn.setToggleState( true, juce::dontSendNotification );
-					}
-				}
-				if ( frequencyDestBtn.getToggleState() )
-				{
-					if ( !state.egFrequencyMod3 )
-					{
-						frequencyDestBtn.setToggleState( false, juce::dontSendNotification );
-					}
-				}
-				else
-				{
-
-					if ( state.egFrequencyMod3 )
-					{
-						frequencyDestBtn.setToggleState( true, juce::dontSendNotification );
-					}
-				}
-				if ( filterDestBtn.getToggleState() )
-				{
-					if ( !state.egFilterMod3 )
-					{
-						filterDestBtn.setToggleState( false, juce::dontSendNotification );
-					}
-				}
-				else
-				{
-					if ( state.egFilterMod3 )
-					{
-						filterDestBtn.setToggleState( true, juce::dontSendNotification );
-					}
-				}
-				op1ModAmountSldr.setValue( state.op1ModAmount3, juce::dontSendNotification );
-				op2ModAmountSldr.setValue( state.op2ModAmount3, juce::dontSendNotification );
-				op3ModAmountSldr.setValue( state.op3ModAmount3, juce::dontSendNotification );
-				op4ModAmountSldr.setValue( state.op4ModAmount3, juce::dontSendNotification );
-				amplitudeSldr.setValue( state.amplitude3, juce::dontSendNotification );
-				filterFreqSldr.setValue( state.filterFreq3, juce::dontSendNotification );
-				filterResSldr.setValue( state.filterRes3, juce::dontSendNotification );
-				ampVelSldr.setValue( state.ampVelSens3, juce::dontSendNotification );
-				filtVelSldr.setValue( state.filtVelSens3, juce::dontSendNotification );
-				detuneSldr.setValue( state.detune3, juce::dontSendNotification );
-
-				break;
-			case 3:
-				op4Btn.setToggleState( true, juce::dontSendNotification );
-
-				freqSldr.setValue( state.frequency4, juce::dontSendNotification );
-				if ( ratioBtn.getToggleState() )
-				{
-					if ( !state.useRatio4 )
-					{
-						ratioBtn.setToggleState( false, juce::dontSendNotification );
-					}
-				}
-				else
-				{
-					if ( state.useRatio4 )
-					{
-						ratioBtn.setToggleState( true, juce::dontSendNotification );
-					}
-				}
-				switch ( state.wave4 )
-				{
-					case OscillatorMode::SINE:
-						sineBtn.setToggleState( true, juce::dontSendNotification );
-						break;
-					case OscillatorMode::TRIANGLE:
-						triangleBtn.setToggleState( true, juce::dontSendNotification );
-						break;
-					case OscillatorMode::SQUARE:
-						squareBtn.setToggleState( true, juce::dontSendNotification );
-						break;
-					case OscillatorMode::SAWTOOTH:
-						sawBtn.setToggleState( true, juce::dontSendNotification );
-						break;
-					default:
-						std::cout << "Wave not recognized in setFromARMor8VoiceState..." << std::endl;
-				}
-				attackSldr.setValue( state.attack4, juce::dontSendNotification );
-				attackExpoSldr.setValue( state.attackExpo4, juce::dontSendNotification );
-				decaySldr.setValue( state.decay4, juce::dontSendNotification );
-				decayExpoSldr.setValue( state.decayExpo4, juce::dontSendNotification );
-				sustainSldr.setValue( state.sustain4, juce::dontSendNotification );
-				releaseSldr.setValue( state.release4, juce::dontSendNotification );
-				releaseExpoSldr.setValue( state.releaseExpo4, juce::dontSendNotification );
-				if ( amplitudeDestBtn.getToggleState() )
-				{
-					if ( !state.egAmplitudeMod4 )
-					{
-						amplitudeDestBtn.setToggleState( false, juce::dontSendNotification );
-					}
-				}
-				else
-				{
-					if ( state.egAmplitudeMod4 )
-					{
-						amplitudeDestBtn.setToggleState( true, juce::dontSendNotification );
-					}
-				}
-				if ( frequencyDestBtn.getToggleState() )
-				{
-					if ( !state.egFrequencyMod4 )
-					{
-						frequencyDestBtn.setToggleState( false, juce::dontSendNotification );
-					}
-				}
-				else
-				{
-
-					if ( state.egFrequencyMod4 )
-					{
-						frequencyDestBtn.setToggleState( true, juce::dontSendNotification );
-					}
-				}
-				if ( filterDestBtn.getToggleState() )
-				{
-					if ( !state.egFilterMod4 )
-					{
-						filterDestBtn.setToggleState( false, juce::dontSendNotification );
-					}
-				}
-				else
-				{
-					if ( state.egFilterMod4 )
-					{
-						filterDestBtn.setToggleState( true, juce::dontSendNotification );
-					}
-				}
-				op1ModAmountSldr.setValue( state.op1ModAmount4, juce::dontSendNotification );
-				op2ModAmountSldr.setValue( state.op2ModAmount4, juce::dontSendNotification );
-				op3ModAmountSldr.setValue( state.op3ModAmount4, juce::dontSendNotification );
-				op4ModAmountSldr.setValue( state.op4ModAmount4, juce::dontSendNotification );
-				amplitudeSldr.setValue( state.amplitude4, juce::dontSendNotification );
-				filterFreqSldr.setValue( state.filterFreq4, juce::dontSendNotification );
-				filterResSldr.setValue( state.filterRes4, juce::dontSendNotification );
-				ampVelSldr.setValue( state.ampVelSens4, juce::dontSendNotification );
-				filtVelSldr.setValue( state.filtVelSens4, juce::dontSendNotification );
-				detuneSldr.setValue( state.detune4, juce::dontSendNotification );
-
-				break;
-			default:
-				std::cout << "Something is terribly, terribly wrong in setFromARMor8VoiceState..." << std::endl;
+			attackSldr.setValue( op.attack, juce::dontSendNotification );
+		}
+		if ( changed(ARMor8PresetField::ATTACK_EXPO) )
+		{
+			attackExpoSldr.setValue( op.attackExpo, juce::dontSendNotification );
+		}
+		if ( changed(ARMor8PresetField::DECAY) )
+		{
+			decaySldr.setValue( op.decay, juce::dontSendNotification );
+		}
+		if ( changed(ARMor8PresetField::DECAY_EXPO) )
+		{
+			decayExpoSldr.setValue( op.decayExpo, juce::dontSendNotification );
+		}
+		if ( changed(ARMor8PresetField::SUSTAIN) )
+		{
+			sustainSldr.setValue( op.sustain, juce::dontSendNotification );
+		}
+		if ( changed(ARMor8PresetField::RELEASE) )
+		{
+			releaseSldr.setValue( op.release, juce::dontSendNotification );
+		}
+		if ( changed(ARMor8PresetField::RELEASE_EXPO) )
+		{
+			releaseExpoSldr.setValue( op.releaseExpo, juce::dontSendNotification );
+		}
+		if ( changed(ARMor8PresetField::EG_DESTINATIONS) )
+		{
+			amplitudeDestBtn.setToggleState( op.egAmplitudeMod, juce::dontSendNotification );
+			frequencyDestBtn.setToggleState( op.egFrequencyMod, juce::dontSendNotification );
+			filterDestBtn.setToggleState( op.egFilterMod, juce::dontSendNotification );
+		}
+		if ( changed(ARMor8PresetField::OP1_MOD_AMOUNT) )
+		{
+			op1ModAmountSldr.setValue( op.op1ModAmount, juce::dontSendNotification );
+		}
+		if ( changed(ARMor8PresetField::OP2_MOD_AMOUNT) )
+		{
+			op2ModAmountSldr.setValue( op.op2ModAmount, juce::dontSendNotification );
+		}
+		if ( changed(ARMor8PresetField::OP3_MOD_AMOUNT) )
+		{
+			op3ModAmountSldr.setValue( op.op3ModAmount, juce::dontSendNotification );
+		}
+		if ( changed(ARMor8PresetField::OP4_MOD_AMOUNT) )
+		{
+			op4ModAmountSldr.setValue( op.op4ModAmount, juce::dontSendNotification );
+		}
+		if ( changed(ARMor8PresetField::AMPLITUDE) )
+		{
+			amplitudeSldr.setValue( op.amplitude, juce::dontSendNotification );
+		}
+		if ( changed(ARMor8PresetField::FILTER_FREQ) )
+		{
+			filterFreqSldr.setValue( op.filterFreq, juce::dontSendNotification );
+		}
+		if ( changed(ARMor8PresetField::FILTER_RES) )
+		{
+			filterResSldr.setValue( op.filterRes, juce::dontSendNotification );
+		}
+		if ( changed(ARMor8PresetField::AMP_VEL_SENS) )
+		{
+			ampVelSldr.setValue( op.ampVelSens, juce::dontSendNotification );
+		}
+		if ( changed(ARMor8PresetField::FILT_VEL_SENS) )
+		{
+			filtVelSldr.setValue( op.filtVelSens, juce::dontSendNotification );
+		}
+		if ( changed(ARMor8PresetField::DETUNE) )
+		{
+			detuneSldr.setValue( op.detune, juce::dontSendNotification );
 		}
 	}
 	catch (std::exception& e)
@@ -9,13 +9,19 @@
 #pragma once
 
 #include "../JuceLibraryCode/JuceHeader.h"
-#include "AudioBuffer.hpp"
 #include "ARMor8VoiceManager.hpp"
 #include "IARMor8PresetEventListener.hpp"
 #include "IARMor8LCDRefreshEventListener.hpp"
 #include "MidiHandler.hpp"
 #include "PresetManager.hpp"
+#include "ARMor8PresetCache.hpp"
+#include "ARMor8PresetManagerStore.hpp"
+#include "ARMor8PresetStorageService.hpp"
 #include "AudioSettingsComponent.h"
+#include "DiskRecorder.h"
+#include "PresetStorageThread.h"
+#include "MappedPresetBank.h"
+#include "ARMor8BootSequencer.hpp"
 #include "ARMor8UiManager.hpp"
 
 #include <iostream>
@@ -62,13 +68,20 @@ class MainComponent   : public juce::AudioAppComponent, public juce::Slider::Lis
 		//==============================================================================
 		// Your private member variables go here...
 		PresetManager presetManager;
+		ARMor8PresetManagerStore presetStore;
+		MappedPresetBank presetBank; // what the synth actually browses, the preset file above is only imported from (or used if the bank can't be opened)
+		ARMor8RamPresetCacheMemory presetCacheMemory;
+		ARMor8PresetCache presetCache;
+		ARMor8RamMemory<65536> delayMemory; // the delay and chorus effect's delay line
+		ARMor8PresetStorageService presetStorageService;
+		PresetStorageThread presetStorageThread;
 		MidiHandler midiHandler;
 		int lastInputIndex;
-		::AudioBuffer sAudioBuffer;
 		ARMor8VoiceManager armor8VoiceManager;
 		bool keyButtonRelease;
+		ARMor8BootSequencer bootSequencer; // everything past getting the audio running is done from the timer
 
-		juce::AudioFormatWriter* writer;
+		DiskRecorder diskRecorder;
 		juce::Slider freqSldr;
 		juce::Label freqLbl;
 		juce::Slider detuneSldr;
@@ -140,6 +153,9 @@ class MainComponent   : public juce::AudioAppComponent, public juce::Slider::Lis
 		juce::ToggleButton egRetriggerBtn;
 
 		juce::TextButton audioSettingsBtn;
+		juce::ToggleButton recordBtn;
+		juce::ComboBox effectList;
+		juce::ComboBox unisonList;
 
 		juce::ComboBox midiInputList;
 		juce::Label midiInputListLbl;
@@ -157,10 +173,17 @@ class MainComponent   : public juce::AudioAppComponent, public juce::Slider::Lis
 
 		juce::Image screenRep;
 
-		std::ofstream testFile;
-
-		void setFromARMor8VoiceState (const ARMor8VoiceState& state, unsigned int opToEdit, unsigned int presetNum);
+		void setFromARMor8VoiceState (const ARMor8VoiceState& state, unsigned int opToEdit, unsigned int presetNum,
+						unsigned int changedFields);
 		void copyFrameBufferToImage (unsigned int xStart, unsigned int yStart, unsigned int xEnd, unsigned int yEnd);
 
+		// boot tasks, the context is the MainComponent
+		static bool bootUpgradePresets (void* context);
+		static bool bootOpenPresetBank (void* context);
+		static bool bootLoadPresetCache (void* context);
+		static bool bootStartPresetStorage (void* context);
+		static bool bootLoadFirstPreset (void* context);
+		void printBootReport();
+
 		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MainComponent)
 };
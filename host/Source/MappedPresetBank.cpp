@@ -0,0 +1,182 @@
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#elif defined(_WIN32) || defined(WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "MappedPresetBank.h"
+
+#include "ARMor8FactoryPresetStore.hpp"
+
+#include <string.h>
+
+static const char     BANK_MAGIC[4] = { 'A', '8', 'P', 'B' };
+static const uint32_t BANK_VERSION  = 1;
+
+MappedPresetBank::MappedPresetBank() :
+	m_MappedFile(),
+	m_Header( nullptr ),
+	m_Presets( nullptr ),
+	m_NumPresets( 0 ),
+	m_NumStoredPresets( 0 )
+{
+}
+
+MappedPresetBank::~MappedPresetBank()
+{
+	this->close();
+}
+
+bool MappedPresetBank::open (const juce::File& file, unsigned int numPresets)
+{
+	this->close();
+
+	const juce::int64 sizeInBytes = sizeof(BankHeader) + ( static_cast<juce::int64>(numPresets) * sizeof(ARMor8PackedPreset) );
+
+	// the mapping can't grow the file, so pad it out to the full size first
+	if ( file.getSize() < sizeInBytes )
+	{
+		juce::FileOutputStream stream( file );
+		if ( stream.failedToOpen() )
+		{
+			return false;
+		}
+
+		stream.writeRepeatedByte( 0, static_cast<size_t>(sizeInBytes - stream.getPosition()) );
+		stream.flush();
+	}
+
+	m_MappedFile.reset( new juce::MemoryMappedFile(file, juce::MemoryMappedFile::readWrite) );
+	if ( m_MappedFile->getData() == nullptr || m_MappedFile->getSize() < static_cast<size_t>(sizeInBytes) )
+	{
+		m_MappedFile.reset();
+		return false;
+	}
+
+	m_Header = static_cast<BankHeader*>( m_MappedFile->getData() );
+	m_Presets = reinterpret_cast<ARMor8PackedPreset*>( static_cast<uint8_t*>(m_MappedFile->getData()) + sizeof(BankHeader) );
+	m_NumPresets = numPresets;
+
+	if ( memcmp(m_Header->magic, BANK_MAGIC, sizeof(BANK_MAGIC)) == 0 && m_Header->version == BANK_VERSION )
+	{
+		m_NumStoredPresets = ( m_Header->numPresets < numPresets ) ? m_Header->numPresets : numPresets;
+	}
+	else
+	{
+		memcpy( m_Header->magic, BANK_MAGIC, sizeof(BANK_MAGIC) );
+		m_Header->version = BANK_VERSION;
+		m_Header->numPresets = 0;
+		m_NumStoredPresets = 0;
+
+		if ( ! this->syncToDisk(m_Header, sizeof(BankHeader)) )
+		{
+			this->close();
+			return false;
+		}
+	}
+
+	// the header's preset count only goes up once importPresets() has the new presets on disk
+
+	return true;
+}
+
+void MappedPresetBank::close()
+{
+	m_MappedFile.reset();
+	m_Header = nullptr;
+	m_Presets = nullptr;
+	m_NumPresets = 0;
+	m_NumStoredPresets = 0;
+}
+
+void MappedPresetBank::importPresets (IARMor8PresetStore& source)
+{
+	if ( m_NumStoredPresets >= m_NumPresets )
+	{
+		return;
+	}
+
+	const unsigned int numSourcePresets = source.getMaxNumPresets();
+	for ( unsigned int presetNum = m_NumStoredPresets; presetNum < m_NumPresets; presetNum++ )
+	{
+		const ARMor8PackedPreset preset = ( presetNum < numSourcePresets ) ? source.retrievePreset( presetNum )
+								: ARMor8PresetCodec::pack( ARMor8FactoryPresetStore::getFactoryPreset(0) );
+		m_Presets[presetNum] = ARMor8FactoryPresetStore::fillIfEmpty( preset, presetNum );
+	}
+
+	// one sync for the lot instead of one per preset, and only then count them as stored. if we die before this the
+	// header still has the old count, so the next open imports them again instead of trusting half written presets
+	if ( ! this->syncToDisk(&m_Presets[m_NumStoredPresets], (m_NumPresets - m_NumStoredPresets) * sizeof(ARMor8PackedPreset)) )
+	{
+		return;
+	}
+
+	m_NumStoredPresets = m_NumPresets;
+	if ( m_Header->numPresets < m_NumPresets )
+	{
+		m_Header->numPresets = m_NumPresets;
+		this->syncToDisk( m_Header, sizeof(BankHeader) );
+	}
+}
+
+const ARMor8PackedPreset* MappedPresetBank::getPresetData (unsigned int presetNum) const
+{
+	if ( presetNum >= m_NumPresets )
+	{
+		return nullptr;
+	}
+
+	return &m_Presets[presetNum];
+}
+
+ARMor8PackedPreset MappedPresetBank::retrievePreset (unsigned int presetNum)
+{
+	ARMor8PackedPreset preset;
+
+	if ( presetNum >= m_NumPresets )
+	{
+		memset( preset.data, 0, sizeof(preset.data) );
+		return preset;
+	}
+
+	return m_Presets[presetNum];
+}
+
+bool MappedPresetBank::writePreset (const ARMor8PackedPreset& preset, unsigned int presetNum)
+{
+	if ( presetNum >= m_NumPresets )
+	{
+		return false;
+	}
+
+	m_Presets[presetNum] = preset;
+
+	return this->syncToDisk( &m_Presets[presetNum], sizeof(ARMor8PackedPreset) );
+}
+
+unsigned int MappedPresetBank::getMaxNumPresets()
+{
+	return m_NumPresets;
+}
+
+bool MappedPresetBank::syncToDisk (const void* address, size_t sizeInBytes)
+{
+#if defined(__unix__) || defined(__APPLE__)
+	// msync needs a page aligned address
+	const uintptr_t pageSize = static_cast<uintptr_t>( sysconf(_SC_PAGESIZE) );
+	const uintptr_t start = reinterpret_cast<uintptr_t>( address ) & ~( pageSize - 1 );
+	const uintptr_t end = reinterpret_cast<uintptr_t>( address ) + sizeInBytes;
+
+	return msync( reinterpret_cast<void*>(start), end - start, MS_SYNC ) == 0;
+#elif defined(_WIN32) || defined(WIN32)
+	// FlushViewOfFile rounds the address down to a page itself. it hands the dirty pages to the file system but doesn't wait
+	// for the drive's own cache like MS_SYNC does, that would need FlushFileBuffers on a file handle juce doesn't expose
+	return FlushViewOfFile( address, sizeInBytes ) != 0;
+#else
+	#error "MappedPresetBank needs a way to sync the mapping to disk on this platform"
+#endif
+}
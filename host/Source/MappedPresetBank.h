@@ -0,0 +1,56 @@
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+#include "IARMor8PresetStore.hpp"
+
+#include <memory>
+
+// The MappedPresetBank keeps a bank of packed presets in a memory mapped file, so reading a preset is just a copy out of
+// the mapping (or no copy at all with getPresetData()) and the bank can hold far more presets than the EEPROM on the
+// target. Each write is synced to disk before writePreset() returns, so call it from the preset storage thread.
+class MappedPresetBank : public IARMor8PresetStore
+{
+	public:
+		MappedPresetBank();
+		~MappedPresetBank() override;
+
+		// maps the bank file, creating it or growing it to numPresets first. returns false if it couldn't be mapped
+		bool open (const juce::File& file, unsigned int numPresets);
+		void close();
+
+		// how many presets were already in the file when it was opened, the rest are zeroed and need filling in
+		unsigned int getNumStoredPresets() const { return m_NumStoredPresets; }
+
+		// fills in the presets that weren't stored yet from source, any of them that are still the init preset (and
+		// any past the end of source) get the factory preset instead
+		void importPresets (IARMor8PresetStore& source);
+
+		// points straight into the mapping, nullptr if presetNum is out of range
+		const ARMor8PackedPreset* getPresetData (unsigned int presetNum) const;
+
+		ARMor8PackedPreset retrievePreset (unsigned int presetNum) override;
+		bool writePreset (const ARMor8PackedPreset& preset, unsigned int presetNum) override;
+
+		unsigned int getMaxNumPresets() override;
+
+	private:
+		struct BankHeader
+		{
+			char     magic[4];
+			uint32_t version;
+			uint32_t numPresets;
+			uint32_t reserved;
+		};
+
+		std::unique_ptr<juce::MemoryMappedFile> m_MappedFile;
+		BankHeader*                             m_Header;
+		ARMor8PackedPreset*                     m_Presets;
+		unsigned int                            m_NumPresets;
+		unsigned int                            m_NumStoredPresets;
+
+		// returns false if the pages couldn't be written back
+		bool syncToDisk (const void* address, size_t sizeInBytes);
+
+		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MappedPresetBank)
+};
@@ -0,0 +1,26 @@
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "PresetStorageThread.h"
+
+#include "ARMor8PresetStorageService.hpp"
+
+PresetStorageThread::PresetStorageThread (ARMor8PresetStorageService& storageService) :
+	juce::Thread( "ARMor8 Preset Storage" ),
+	m_StorageService( storageService )
+{
+}
+
+PresetStorageThread::~PresetStorageThread()
+{
+	this->stopThread( 1000 );
+}
+
+void PresetStorageThread::run()
+{
+	while ( ! this->threadShouldExit() )
+	{
+		if ( ! m_StorageService.processNextRequest() )
+		{
+			this->wait( 100 );
+		}
+	}
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+class ARMor8PresetStorageService;
+
+// The PresetStorageThread performs the ARMor8PresetStorageService's queued reads and writes, so the preset file is never
+// touched from the message thread. Call notify() after queueing a request to have it handled right away.
+class PresetStorageThread 	: public juce::Thread
+{
+	public:
+		PresetStorageThread (ARMor8PresetStorageService& storageService);
+		~PresetStorageThread() override;
+
+		// thread virtual functions
+		void run() override;
+
+	private:
+		ARMor8PresetStorageService& m_StorageService;
+
+		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetStorageThread)
+};
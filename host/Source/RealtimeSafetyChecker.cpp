@@ -0,0 +1,288 @@
+#include "RealtimeSafetyChecker.h"
+
+#ifdef ARMOR8_RT_SAFETY_CHECK
+
+#include <atomic>
+#include <dlfcn.h>
+#include <errno.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+// glibc's own allocator entry points, so our malloc and friends can forward to them without dlsym
+extern "C" void* __libc_malloc (size_t size);
+extern "C" void* __libc_calloc (size_t num, size_t size);
+extern "C" void* __libc_realloc (void* ptr, size_t size);
+extern "C" void  __libc_free (void* ptr);
+extern "C" void* __libc_memalign (size_t alignment, size_t size);
+
+static const unsigned int MAX_VIOLATIONS = 32; // only the first ones get a backtrace, the rest are just counted
+static const int MAX_STACK_DEPTH = 32;
+
+struct RealtimeSafetyViolation
+{
+	const char*       what;
+	void*             stack[MAX_STACK_DEPTH];
+	int               stackDepth;
+	std::atomic<bool> ready;
+};
+
+static RealtimeSafetyViolation violations[MAX_VIOLATIONS];
+static std::atomic<unsigned int> numViolations( 0 );
+static unsigned int numViolationsReported = 0;
+
+static thread_local unsigned int scopeDepth = 0;
+static thread_local bool isRecording = false; // backtrace() may allocate the first time, so don't record ourselves
+
+static void recordViolation (const char* what)
+{
+	if ( scopeDepth == 0 || isRecording )
+	{
+		return;
+	}
+
+	isRecording = true;
+
+	unsigned int index = numViolations.fetch_add( 1 );
+	if ( index < MAX_VIOLATIONS )
+	{
+		violations[index].what = what;
+		violations[index].stackDepth = backtrace( violations[index].stack, MAX_STACK_DEPTH );
+		violations[index].ready = true;
+	}
+
+	isRecording = false;
+}
+
+// the real functions are looked up at startup, so normally nothing is resolved on the audio thread. but other
+// libraries' constructors can call into us before ours has run, so each wrapper also resolves its function on first use
+typedef int (*MutexLockFunc) (pthread_mutex_t*);
+typedef int (*MutexTrylockFunc) (pthread_mutex_t*);
+typedef int (*SemWaitFunc) (sem_t*);
+typedef int (*CondWaitFunc) (pthread_cond_t*, pthread_mutex_t*);
+typedef ssize_t (*ReadFunc) (int, void*, size_t);
+typedef ssize_t (*WriteFunc) (int, const void*, size_t);
+typedef int (*NanosleepFunc) (const struct timespec*, struct timespec*);
+typedef int (*UsleepFunc) (useconds_t);
+
+static std::atomic<MutexLockFunc>    realMutexLock( nullptr );
+static std::atomic<MutexTrylockFunc> realMutexTrylock( nullptr );
+static std::atomic<CondWaitFunc>     realCondWait( nullptr );
+static std::atomic<SemWaitFunc>      realSemWait( nullptr );
+static std::atomic<ReadFunc>         realRead( nullptr );
+static std::atomic<WriteFunc>        realWrite( nullptr );
+static std::atomic<NanosleepFunc>    realNanosleep( nullptr );
+static std::atomic<UsleepFunc>       realUsleep( nullptr );
+
+template <typename Func>
+static Func getRealFunction (std::atomic<Func>& realFunc, const char* name)
+{
+	Func func = realFunc.load( std::memory_order_relaxed );
+	if ( func == nullptr )
+	{
+		// racing threads just look up the same pointer twice
+		func = reinterpret_cast<Func>( dlsym(RTLD_NEXT, name) );
+		if ( func == nullptr )
+		{
+			abort(); // no printing here, since that could come straight back into write()
+		}
+
+		realFunc.store( func, std::memory_order_relaxed );
+	}
+
+	return func;
+}
+
+__attribute__((constructor)) static void initRealtimeSafetyChecker()
+{
+	getRealFunction( realMutexLock, "pthread_mutex_lock" );
+	getRealFunction( realMutexTrylock, "pthread_mutex_trylock" );
+	getRealFunction( realCondWait, "pthread_cond_wait" );
+	getRealFunction( realSemWait, "sem_wait" );
+	getRealFunction( realRead, "read" );
+	getRealFunction( realWrite, "write" );
+	getRealFunction( realNanosleep, "nanosleep" );
+	getRealFunction( realUsleep, "usleep" );
+
+	// get libgcc's unwinder loaded now instead of during the first violation
+	void* stack[1];
+	backtrace( stack, 1 );
+}
+
+extern "C"
+{
+	void* malloc (size_t size)
+	{
+		recordViolation( "malloc" );
+		return __libc_malloc( size );
+	}
+
+	void* calloc (size_t num, size_t size)
+	{
+		recordViolation( "calloc" );
+		return __libc_calloc( num, size );
+	}
+
+	void* realloc (void* ptr, size_t size)
+	{
+		recordViolation( "realloc" );
+		return __libc_realloc( ptr, size );
+	}
+
+	void free (void* ptr)
+	{
+		if ( ptr != nullptr )
+		{
+			recordViolation( "free" );
+		}
+
+		__libc_free( ptr );
+	}
+
+	// the aligned allocators all end up in glibc's memalign, and memory from any of them is freed with free()
+	void* memalign (size_t alignment, size_t size)
+	{
+		recordViolation( "memalign" );
+		return __libc_memalign( alignment, size );
+	}
+
+	void* aligned_alloc (size_t alignment, size_t size)
+	{
+		recordViolation( "aligned_alloc" );
+		return __libc_memalign( alignment, size );
+	}
+
+	int posix_memalign (void** memptr, size_t alignment, size_t size)
+	{
+		recordViolation( "posix_memalign" );
+
+		// the checks memalign doesn't do itself
+		if ( alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0 )
+		{
+			return EINVAL;
+		}
+
+		void* ptr = __libc_memalign( alignment, size );
+		if ( ptr == nullptr )
+		{
+			return ENOMEM;
+		}
+
+		*memptr = ptr;
+
+		return 0;
+	}
+
+	int pthread_mutex_lock (pthread_mutex_t* mutex)
+	{
+		recordViolation( "pthread_mutex_lock" );
+		return getRealFunction( realMutexLock, "pthread_mutex_lock" )( mutex );
+	}
+
+	// doesn't block, but a mutex on the audio thread means something else is holding it some of the time
+	int pthread_mutex_trylock (pthread_mutex_t* mutex)
+	{
+		recordViolation( "pthread_mutex_trylock" );
+		return getRealFunction( realMutexTrylock, "pthread_mutex_trylock" )( mutex );
+	}
+
+	int pthread_cond_wait (pthread_cond_t* cond, pthread_mutex_t* mutex)
+	{
+		recordViolation( "pthread_cond_wait" );
+		return getRealFunction( realCondWait, "pthread_cond_wait" )( cond, mutex );
+	}
+
+	int sem_wait (sem_t* sem)
+	{
+		recordViolation( "sem_wait" );
+		return getRealFunction( realSemWait, "sem_wait" )( sem );
+	}
+
+	ssize_t read (int fd, void* buf, size_t count)
+	{
+		recordViolation( "read" );
+		return getRealFunction( realRead, "read" )( fd, buf, count );
+	}
+
+	ssize_t write (int fd, const void* buf, size_t count)
+	{
+		recordViolation( "write" );
+		return getRealFunction( realWrite, "write" )( fd, buf, count );
+	}
+
+	int nanosleep (const struct timespec* req, struct timespec* rem)
+	{
+		recordViolation( "nanosleep" );
+		return getRealFunction( realNanosleep, "nanosleep" )( req, rem );
+	}
+
+	int usleep (useconds_t usec)
+	{
+		recordViolation( "usleep" );
+		return getRealFunction( realUsleep, "usleep" )( usec );
+	}
+}
+
+void RealtimeSafetyChecker::reportViolations()
+{
+	unsigned int total = numViolations;
+
+	while ( numViolationsReported < total && numViolationsReported < MAX_VIOLATIONS )
+	{
+		RealtimeSafetyViolation& violation = violations[numViolationsReported];
+		if ( ! violation.ready )
+		{
+			break; // still being recorded, get it next time
+		}
+
+		fprintf( stderr, "Real-time safety violation in audio callback: %s\n", violation.what );
+		backtrace_symbols_fd( violation.stack, violation.stackDepth, STDERR_FILENO );
+		numViolationsReported++;
+	}
+
+	if ( total > MAX_VIOLATIONS && numViolationsReported == MAX_VIOLATIONS )
+	{
+		fprintf( stderr, "%u more real-time safety violations without backtraces\n", total - MAX_VIOLATIONS );
+		numViolationsReported++; // only say so once
+	}
+}
+
+unsigned int RealtimeSafetyChecker::getNumViolations()
+{
+	return numViolations;
+}
+
+RealtimeSafetyScope::RealtimeSafetyScope()
+{
+	scopeDepth++;
+}
+
+RealtimeSafetyScope::~RealtimeSafetyScope()
+{
+	scopeDepth--;
+}
+
+#else
+
+void RealtimeSafetyChecker::reportViolations()
+{
+}
+
+unsigned int RealtimeSafetyChecker::getNumViolations()
+{
+	return 0;
+}
+
+RealtimeSafetyScope::RealtimeSafetyScope()
+{
+}
+
+RealtimeSafetyScope::~RealtimeSafetyScope()
+{
+}
+
+#endif // ARMOR8_RT_SAFETY_CHECK
@@ -0,0 +1,23 @@
+#pragma once
+
+// The RealtimeSafetyChecker is a debugging aid for the audio callback path. When the host is built with
+// ARMOR8_RT_SAFETY_CHECK defined (for example 'make CONFIG=Debug CPPFLAGS=-DARMOR8_RT_SAFETY_CHECK'), malloc and free
+// (and the aligned allocators), mutex locks, semaphore waits and blocking syscalls are intercepted for the whole
+// process. Any of them that happen on a thread while a RealtimeSafetyScope is alive is recorded as a violation along
+// with a backtrace. Recording is lock and allocation free, the violations are printed later by reportViolations() from
+// a non real-time thread. Without the define all of this compiles to nothing.
+class RealtimeSafetyChecker
+{
+	public:
+		// prints any violations recorded since the last call to stderr, call this from the message thread
+		static void reportViolations();
+		static unsigned int getNumViolations();
+};
+
+// while one of these exists on a thread, that thread is checked
+class RealtimeSafetyScope
+{
+	public:
+		RealtimeSafetyScope();
+		~RealtimeSafetyScope();
+};
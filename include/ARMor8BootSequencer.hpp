@@ -0,0 +1,82 @@
+#ifndef ARMOR8BOOTSEQUENCER_HPP
+#define ARMOR8BOOTSEQUENCER_HPP
+
+/*************************************************************************
+ * The ARMor8BootSequencer runs the slow parts of starting up (checking
+ * the storage media, upgrading and loading presets, UI setup) after the
+ * audio is already running with a preset from flash. Tasks are run in
+ * the order they were added, a step at a time, from whatever loop has
+ * time to spare (the main loop on the target, a timer on the host), and
+ * a task keeps getting steps until it says it's finished. Each task is
+ * timed along with how long it took to get the audio running, so the
+ * boot can be reported once it's done. The clock is a raw tick counter
+ * that's widened to 64 bits every time it's read, and ticks are only
+ * converted to microseconds after they're subtracted, so the counter
+ * wrapping partway through the boot doesn't throw the times off.
+*************************************************************************/
+
+#include <stdint.h>
+
+const unsigned int BOOT_SEQUENCER_MAX_TASKS = 8;
+
+// returns true once the task is finished, each call should only take a short while
+typedef bool (*ARMor8BootStep) (void* context);
+
+// a free running tick counter, it's fine for it to wrap as long as it's read at least once a wrap (every step reads it)
+typedef uint32_t (*ARMor8BootClock) ();
+
+struct ARMor8BootTask
+{
+	const char*    name;
+	ARMor8BootStep step;
+	void*          context;
+	uint32_t       elapsedMicroseconds; // only counts the time spent in its own steps
+	uint64_t       elapsedTicks;
+	unsigned int   numSteps;
+	bool           finished;
+};
+
+class ARMor8BootSequencer
+{
+	public:
+		ARMor8BootSequencer (ARMor8BootClock clock, uint32_t ticksPerMicrosecond);
+		~ARMor8BootSequencer();
+
+		// returns false if there's no room for another task
+		bool addTask (const char* name, ARMor8BootStep step, void* context);
+
+		// call as soon as the audio is running
+		void markAudioRunning();
+
+		// runs a step of the first unfinished task, returns false once every task is finished
+		bool runNextStep();
+
+		// keeps running steps until at least budgetMicroseconds have gone by or every task is finished
+		bool runSteps (uint32_t budgetMicroseconds);
+
+		bool isFinished();
+
+		uint32_t getTimeToAudio();  // microseconds from construction until markAudioRunning()
+		uint32_t getTimeToFinish(); // microseconds from construction until the last task finished
+
+		unsigned int getNumTasks();
+		const ARMor8BootTask& getTask (unsigned int taskNum);
+
+	private:
+		ARMor8BootClock m_Clock;
+		uint32_t        m_TicksPerMicrosecond;
+		uint32_t        m_LastClockTicks;
+		uint64_t        m_Ticks; // the clock widened to 64 bits
+		uint64_t        m_StartTime;
+		uint64_t        m_TimeToAudio;
+		uint64_t        m_TimeToFinish;
+
+		ARMor8BootTask m_Tasks[BOOT_SEQUENCER_MAX_TASKS];
+		unsigned int   m_NumTasks;
+		unsigned int   m_CurrentTask;
+
+		uint64_t now();
+		uint32_t toMicroseconds (uint64_t ticks);
+};
+
+#endif // ARMOR8BOOTSEQUENCER_HPP
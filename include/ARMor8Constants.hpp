@@ -30,6 +30,28 @@ const int   ARMOR8_PITCH_BEND_MAX = 12;
 const float ARMOR8_GLIDE_TIME_MIN = 0.0f;
 const float ARMOR8_GLIDE_TIME_MAX = 1.0f;
 
+// summed modulation depth (in Hz) at which a voice switches to 2x or 4x oversampling
+const unsigned int ARMOR8_MAX_OVERSAMPLING         = 4;
+const float        ARMOR8_OVERSAMPLING_2X_MOD_DEPTH = 4000.0f;
+const float        ARMOR8_OVERSAMPLING_4X_MOD_DEPTH = 10000.0f;
+
+// voices stolen while still audible are faded out over this time before the new note starts
+const float ARMOR8_VOICE_STEAL_FADE_TIME  = 0.002f;
+const float ARMOR8_VOICE_STEAL_FADE_LEVEL = 0.01f;
+const float ARMOR8_VOICE_LEVEL_DECAY_TIME = 0.05f; // decay of each voice's output level follower
+
+// decaying state smaller than this is snapped to zero, so it never reaches denormals (around 1e-38)
+const float ARMOR8_DENORMAL_THRESHOLD = 1e-15f;
+
+// post voice sum delay and chorus, the delay line lives in external memory
+const float ARMOR8_DELAY_TIME_MIN     = 0.01f;
+const float ARMOR8_DELAY_TIME_MAX     = 0.6f;
+const float ARMOR8_DELAY_FEEDBACK_MAX = 0.95f;
+const float ARMOR8_CHORUS_DELAY_TIME  = 0.012f; // the chorus sweeps around this delay
+const float ARMOR8_CHORUS_DEPTH_MAX   = 0.0025f;
+const float ARMOR8_CHORUS_RATE_MIN    = 0.05f;
+const float ARMOR8_CHORUS_RATE_MAX    = 5.0f;
+
 enum class POT_CHANNEL : unsigned int
 {
 	ALL          = 0,
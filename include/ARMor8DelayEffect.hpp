@@ -0,0 +1,90 @@
+#ifndef ARMOR8DELAYEFFECT_HPP
+#define ARMOR8DELAYEFFECT_HPP
+
+/*************************************************************************
+ * The ARMor8DelayEffect is a delay or chorus applied to the summed
+ * voices. Its delay line lives in an IARMor8ExternalMemory (a block
+ * of RAM on the host) as 16 bit samples, and the only internal RAM it
+ * needs is for one block of samples in each direction. Audio is
+ * processed in blocks of DELAY_EFFECT_BLOCK_SIZE: once a block is
+ * written back, the delayed samples the next block will need are
+ * requested right away, so a memory that transfers in the background
+ * can stream them in while the voices render the next buffer.
+*************************************************************************/
+
+#include "IARMor8ExternalMemory.hpp"
+
+#include <stdint.h>
+#include <atomic>
+
+const unsigned int DELAY_EFFECT_BLOCK_SIZE = 32;
+const unsigned int DELAY_EFFECT_MAX_DEPTH_SAMPLES = 128; // limits the chorus depth at high sample rates
+const unsigned int DELAY_EFFECT_READ_SIZE = DELAY_EFFECT_BLOCK_SIZE + ( 2 * (DELAY_EFFECT_MAX_DEPTH_SAMPLES + 1) ) + 2;
+const float DELAY_EFFECT_HEADROOM = 4.0f; // the summed voices can go past 1.0, so they're scaled down before storing
+
+enum class DELAY_EFFECT_MODE : unsigned int
+{
+	OFF,
+	DELAY,
+	CHORUS
+};
+
+class ARMor8DelayEffect
+{
+	public:
+		ARMor8DelayEffect();
+		~ARMor8DelayEffect();
+
+		// the delay line uses sizeInBytes of memory starting at offsetInBytes
+		void setMemory (IARMor8ExternalMemory* memory, unsigned int offsetInBytes, unsigned int sizeInBytes);
+
+		void setMode (const DELAY_EFFECT_MODE& mode);
+		DELAY_EFFECT_MODE getMode();
+
+		void setSampleRate (float sampleRate);
+
+		void setDelayTime (float seconds);
+		void setFeedback (float feedback);
+		void setMix (float mix); // 0.0f is all dry and 1.0f is all wet
+		void setChorusRate (float hz);
+		void setChorusDepth (float seconds);
+
+		void process (float* buffer, unsigned int numSamples);
+
+	private:
+		IARMor8ExternalMemory* m_Memory;
+		unsigned int           m_MemoryOffset;
+		unsigned int           m_LineLength; // in samples
+
+		std::atomic<DELAY_EFFECT_MODE> m_Mode; // requested from any thread
+		DELAY_EFFECT_MODE              m_ActiveMode; // what process() is actually doing
+
+		float m_SampleRate;
+		float m_DelayTime;
+		float m_Feedback;
+		float m_Mix;
+		float m_ChorusRate;
+		float m_ChorusDepth;
+
+		unsigned int m_WritePos;
+		unsigned int m_History; // how many samples have been written since the effect was turned on
+		float        m_LfoPhase;
+
+		int16_t      m_ReadBuffer[DELAY_EFFECT_READ_SIZE];
+		int16_t      m_WriteBuffer[DELAY_EFFECT_BLOCK_SIZE];
+		unsigned int m_PrefetchStart;
+		unsigned int m_PrefetchLength;
+		bool         m_PrefetchValid;
+		bool         m_TransfersPending;
+
+		void processBlock (float* buffer, unsigned int numSamples);
+
+		// delayed samples in the span of the line a block starting at m_WritePos will read
+		void getReadSpan (unsigned int numSamples, unsigned int& start, unsigned int& length, float& chorusCenter, float& chorusDepth,
+					unsigned int& delaySamples);
+
+		void readLine (unsigned int start, unsigned int length, bool inBackground);
+		void writeLine (unsigned int start, unsigned int length);
+};
+
+#endif // ARMOR8DELAYEFFECT_HPP
@@ -0,0 +1,49 @@
+#ifndef ARMOR8FACTORYPRESETSTORE_HPP
+#define ARMOR8FACTORYPRESETSTORE_HPP
+
+/*************************************************************************
+ * The factory presets are a constexpr table of ARMor8VoiceStates, so
+ * they're placed in flash and read straight over the memory bus with no
+ * I/O at all. The ARMor8FactoryPresetStore lays the user's presets in
+ * an ARMor8PresetJournal over the top of them: any preset the user has
+ * written comes from the journal, and every other preset number is a
+ * factory preset (numbers past the end of the factory table get the
+ * init preset). So a blank EEPROM doesn't need filling in at first boot
+ * and the factory presets don't take any EEPROM space.
+*************************************************************************/
+
+#include "IARMor8PresetStore.hpp"
+#include "ARMor8Voice.hpp"
+
+const unsigned int ARMOR8_NUM_FACTORY_PRESETS = 8;
+
+// the first factory preset is the init preset
+extern const ARMor8VoiceState ARMor8FactoryPresets[ARMOR8_NUM_FACTORY_PRESETS];
+
+class ARMor8PresetJournal;
+
+class ARMor8FactoryPresetStore : public IARMor8PresetStore
+{
+	public:
+		ARMor8FactoryPresetStore (ARMor8PresetJournal* userPresets);
+		~ARMor8FactoryPresetStore() override;
+
+		ARMor8PackedPreset retrievePreset (unsigned int presetNum) override;
+		bool writePreset (const ARMor8PackedPreset& preset, unsigned int presetNum) override; // always goes to the journal
+
+		unsigned int getMaxNumPresets() override;
+
+		// false once the user has written over the factory preset
+		bool isFactoryPreset (unsigned int presetNum);
+
+		static const ARMor8VoiceState& getFactoryPreset (unsigned int presetNum);
+
+		// for stores that can't tell written presets from unwritten ones, like the SAL PresetManager which fills its
+		// empty slots with the init preset. returns the factory preset if preset is still the init preset
+		static ARMor8PackedPreset fillIfEmpty (const ARMor8PackedPreset& preset, unsigned int presetNum);
+
+	private:
+		ARMor8PresetJournal* m_UserPresets;
+};
+
+#endif // ARMOR8FACTORYPRESETSTORE_HPP
@@ -28,6 +28,10 @@ class ARMor8Filter : public IFilter
 		OnePoleFilter filter4;
 		float m_Resonance;
 		float m_PrevSample;
+		float m_Frequency;
+		bool  m_Bypassed;
+
+		void resetStages();
 };
 
 #endif // ARMOR8FILTER_HPP
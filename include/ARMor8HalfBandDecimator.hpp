@@ -0,0 +1,36 @@
+#ifndef ARMOR8HALFBANDDECIMATOR_HPP
+#define ARMOR8HALFBANDDECIMATOR_HPP
+
+/*************************************************************************
+ * An ARMor8HalfBandDecimator is a 35 tap half-band FIR low-pass filter
+ * that also decimates by two. Since every other coefficient of a
+ * half-band filter is zero (except for the center tap) it is split into
+ * two polyphase branches: a symmetric FIR running on the odd samples
+ * and a pure delay on the even samples. This way each output sample
+ * only costs 10 multiplies. ARMor8Voices cascade these when they are
+ * oversampled.
+*************************************************************************/
+
+const unsigned int HALF_BAND_ODD_TAPS = 18; // nonzero taps in the odd branch
+const unsigned int HALF_BAND_EVEN_DELAY = 8; // delay of the center tap in the even branch
+
+class ARMor8HalfBandDecimator
+{
+	public:
+		ARMor8HalfBandDecimator();
+		~ARMor8HalfBandDecimator();
+
+		// takes two consecutive samples at the higher rate and returns one sample at half that rate
+		float processSamples (float sample1, float sample2);
+
+		void reset();
+
+	private:
+		// the odd delay line is written twice so the convolution can always read a contiguous window
+		float m_OddDelayLine[HALF_BAND_ODD_TAPS * 2];
+		float m_EvenDelayLine[HALF_BAND_EVEN_DELAY];
+		unsigned int m_OddWriteIndex;
+		unsigned int m_EvenWriteIndex;
+};
+
+#endif // ARMOR8HALFBANDDECIMATOR_HPP
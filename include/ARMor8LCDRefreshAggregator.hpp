@@ -0,0 +1,55 @@
+#ifndef ARMOR8LCDREFRESHAGGREGATOR_HPP
+#define ARMOR8LCDREFRESHAGGREGATOR_HPP
+
+/*************************************************************************
+ * The ARMor8LCDRefreshAggregator collects the parts of the frame buffer
+ * that were drawn to during a frame, and publishes them as a handful of
+ * ARMor8LCDRefreshEvents when it's flushed, instead of one event per
+ * change. Each transfer is given a cost of its number of pixels plus a
+ * fixed overhead (setting the lcd window on the target, a repaint on
+ * the host), and two rects are merged whenever sending their union is
+ * no more expensive than sending both. If it runs out of rects, the
+ * pair that's cheapest to merge is merged.
+*************************************************************************/
+
+const unsigned int LCD_REFRESH_MAX_RECTS = 4;
+const unsigned int LCD_REFRESH_DEFAULT_TRANSFER_COST = 64; // in pixels
+
+// in pixels, the end coordinates are inclusive
+struct ARMor8LCDRefreshRect
+{
+	unsigned int xStart;
+	unsigned int yStart;
+	unsigned int xEnd;
+	unsigned int yEnd;
+};
+
+class ARMor8LCDRefreshAggregator
+{
+	public:
+		ARMor8LCDRefreshAggregator (unsigned int width, unsigned int height,
+						unsigned int transferCost = LCD_REFRESH_DEFAULT_TRANSFER_COST);
+		~ARMor8LCDRefreshAggregator();
+
+		void addRect (unsigned int xStart, unsigned int yStart, unsigned int xEnd, unsigned int yEnd);
+		void addFullScreen();
+
+		bool hasRefreshes() const { return m_NumRects > 0; }
+
+		// publishes the merged rects and starts a new frame, returns the number of events published
+		unsigned int flush();
+
+	private:
+		unsigned int         m_Width;
+		unsigned int         m_Height;
+		unsigned int         m_TransferCost;
+
+		ARMor8LCDRefreshRect m_Rects[LCD_REFRESH_MAX_RECTS];
+		unsigned int         m_NumRects;
+
+		unsigned int transferCost (const ARMor8LCDRefreshRect& rect) const;
+
+		void removeRect (unsigned int rectNum);
+};
+
+#endif // ARMOR8LCDREFRESHAGGREGATOR_HPP
@@ -0,0 +1,66 @@
+#ifndef ARMOR8NOTESTACK_HPP
+#define ARMOR8NOTESTACK_HPP
+
+/*************************************************************************
+ * The ARMor8NoteStack keeps track of the keys held down while the
+ * ARMor8VoiceManager is monophonic, so the right note can be played
+ * when keys are pressed and released. Held notes live in a fixed set of
+ * slots linked in the order they were pressed, with a note to slot table
+ * and a bitmap of held notes on the side. Pushing and removing notes and
+ * finding the last, highest or lowest note are all constant time. If
+ * more than NOTE_STACK_SIZE notes are held, the oldest one is dropped.
+*************************************************************************/
+
+#include "ARMor8VoiceAllocator.hpp"
+
+#include <stdint.h>
+
+const unsigned int NOTE_STACK_SIZE = 16;
+
+enum class MONO_NOTE_PRIORITY : unsigned int
+{
+	LAST,
+	HIGHEST,
+	LOWEST
+};
+
+class ARMor8NoteStack
+{
+	public:
+		ARMor8NoteStack();
+		~ARMor8NoteStack();
+
+		void setPriority (const MONO_NOTE_PRIORITY& priority);
+		MONO_NOTE_PRIORITY getPriority();
+
+		// pressing a note that is already held just updates its velocity and makes it the last note
+		void pushNote (unsigned int note, unsigned int velocity);
+		void removeNote (unsigned int note);
+
+		// returns the note that should be sounding with the current priority, or NO_NOTE if no notes are held
+		int getActiveNote();
+		unsigned int getVelocity (unsigned int note);
+		unsigned int getNumHeldNotes();
+
+		void reset();
+
+	private:
+		MONO_NOTE_PRIORITY m_Priority;
+
+		uint8_t  m_NoteToSlot[MIDI_NUM_NOTES];
+		uint32_t m_HeldNotes[MIDI_NUM_NOTES / 32]; // bitmap, so highest and lowest notes can be found with clz and ctz
+
+		uint8_t m_SlotNote[NOTE_STACK_SIZE];
+		uint8_t m_SlotVelocity[NOTE_STACK_SIZE];
+		uint8_t m_SlotNext[NOTE_STACK_SIZE];
+		uint8_t m_SlotPrev[NOTE_STACK_SIZE];
+
+		uint8_t m_FreeSlot; // head of the singly linked free slots
+		uint8_t m_OldestSlot;
+		uint8_t m_LastSlot;
+		unsigned int m_NumHeldNotes;
+
+		void unlinkSlot (uint8_t slot);
+};
+
+#endif // ARMOR8NOTESTACK_HPP
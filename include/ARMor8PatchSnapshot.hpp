@@ -0,0 +1,127 @@
+#ifndef ARMOR8PATCHSNAPSHOT_HPP
+#define ARMOR8PATCHSNAPSHOT_HPP
+
+/*************************************************************************
+ * The ARMor8PatchSnapshot is the voice manager's cached copy of the
+ * ARMor8VoiceState. Setting any parameter just marks it as stale, and
+ * it's only rebuilt from the voices the next time it's asked for, so
+ * switching operators or browsing presets doesn't walk every operator
+ * and envelope each time. Every rebuild bumps its version.
+ *
+ * It also remembers what was last shown to the preset event listeners
+ * (the operator being edited, the preset number and the globals), so
+ * takeChangedFields() can give a bitmask of just the ARMor8PresetFields
+ * that listeners need to redraw. Listeners also show edits that were
+ * never published (through parameter events, or a host slider), so the
+ * setters pass the field they edited when invalidating, and those are
+ * always included too.
+*************************************************************************/
+
+#include "ARMor8Voice.hpp"
+
+enum class ARMor8PresetField : unsigned int
+{
+	// the operator being edited
+	FREQUENCY       = 1 << 0,
+	RATIO           = 1 << 1,
+	WAVE            = 1 << 2,
+	ATTACK          = 1 << 3,
+	ATTACK_EXPO     = 1 << 4,
+	DECAY           = 1 << 5,
+	DECAY_EXPO      = 1 << 6,
+	SUSTAIN         = 1 << 7,
+	RELEASE         = 1 << 8,
+	RELEASE_EXPO    = 1 << 9,
+	EG_DESTINATIONS = 1 << 10,
+	OP1_MOD_AMOUNT  = 1 << 11,
+	OP2_MOD_AMOUNT  = 1 << 12,
+	OP3_MOD_AMOUNT  = 1 << 13,
+	OP4_MOD_AMOUNT  = 1 << 14,
+	AMPLITUDE       = 1 << 15,
+	FILTER_FREQ     = 1 << 16,
+	FILTER_RES      = 1 << 17,
+	AMP_VEL_SENS    = 1 << 18,
+	FILT_VEL_SENS   = 1 << 19,
+	DETUNE          = 1 << 20,
+
+	OP_TO_EDIT      = 1 << 21,
+	PRESET_NUM      = 1 << 22,
+
+	// global
+	MONOPHONIC      = 1 << 23,
+	PITCH_BEND      = 1 << 24,
+	GLIDE_TIME      = 1 << 25,
+	GLIDE_RETRIGGER = 1 << 26
+};
+
+const unsigned int ARMOR8_PRESET_FIELDS_ALL = ( 1 << 27 ) - 1;
+
+// one operator's worth of an ARMor8VoiceState
+struct ARMor8OperatorState
+{
+	float          frequency;
+	bool           useRatio;
+	OscillatorMode wave;
+	float          attack;
+	float          attackExpo;
+	float          decay;
+	float          decayExpo;
+	float          sustain;
+	float          release;
+	float          releaseExpo;
+	bool           egAmplitudeMod;
+	bool           egFrequencyMod;
+	bool           egFilterMod;
+	float          op1ModAmount;
+	float          op2ModAmount;
+	float          op3ModAmount;
+	float          op4ModAmount;
+	float          amplitude;
+	float          filterFreq;
+	float          filterRes;
+	float          ampVelSens;
+	float          filtVelSens;
+	int            detune;
+};
+
+class ARMor8PatchSnapshot
+{
+	public:
+		ARMor8PatchSnapshot();
+		~ARMor8PatchSnapshot();
+
+		// field is what was edited, so it's redrawn even if the next state happens to match what was last published
+		void invalidate (const ARMor8PresetField& field) { this->invalidate( static_cast<unsigned int>(field) ); }
+		void invalidate (unsigned int fields) { m_IsStale = true; m_EditedFields |= fields; }
+		bool isStale() const { return m_IsStale; }
+
+		void update (const ARMor8VoiceState& state);
+
+		const ARMor8VoiceState& getState() const { return m_State; }
+		unsigned int getVersion() const { return m_Version; }
+
+		// the fields that differ from the last call (all of them the first time), call just before publishing
+		unsigned int takeChangedFields (unsigned int opToEdit, unsigned int presetNum);
+
+		// opNum is 0 indexed, anything past operator 4 gives operator 1
+		static ARMor8OperatorState getOperatorState (const ARMor8VoiceState& state, unsigned int opNum);
+
+	private:
+		ARMor8VoiceState    m_State;
+		bool                m_IsStale;
+		unsigned int        m_Version;
+		unsigned int        m_EditedFields; // since the last takeChangedFields()
+
+		// what the listeners were last given
+		bool                m_HasPublished;
+		unsigned int        m_PublishedVersion;
+		unsigned int        m_PublishedOpToEdit;
+		unsigned int        m_PublishedPresetNum;
+		ARMor8OperatorState m_PublishedOperator;
+		bool                m_PublishedMonophonic;
+		unsigned int        m_PublishedPitchBendSemitones;
+		float               m_PublishedGlideTime;
+		bool                m_PublishedGlideRetrigger;
+};
+
+#endif // ARMOR8PATCHSNAPSHOT_HPP
@@ -0,0 +1,76 @@
+#ifndef ARMOR8PRESETCACHE_HPP
+#define ARMOR8PRESETCACHE_HPP
+
+/*************************************************************************
+ * The ARMor8PresetCache sits in front of an IARMor8PresetStore so
+ * browsing presets doesn't have to go through the slow storage media
+ * (100kHz I2C to the CAT24C64 EEPROM on the target). At boot the whole
+ * preset bank is mirrored into an IARMor8ExternalMemory, which is the
+ * 23K256 SPI SRAM on the target and plain RAM on the host. Reads are
+ * served from the cache, writes only go to the cache and mark the
+ * preset as dirty, and dirty presets are written back to the store one
+ * at a time by calling flushDirtyPreset() whenever there's time to
+ * spare, or handed to an ARMor8PresetStorageService to be written in
+ * the background.
+*************************************************************************/
+
+#include "ARMor8PresetCodec.hpp"
+#include "IARMor8ExternalMemory.hpp"
+
+#include <stdint.h>
+
+// the most presets the cache can hold, the target only ever has the EEPROM's worth but the host can browse bigger banks
+#ifndef ARMOR8_PRESET_CACHE_MAX_PRESETS
+#define ARMOR8_PRESET_CACHE_MAX_PRESETS ARMOR8_NUM_PRESETS
+#endif
+
+class IARMor8PresetStore;
+class ARMor8PresetStorageService;
+
+// for when there's enough internal RAM to hold the whole bank, like on the host
+typedef ARMor8RamMemory<ARMOR8_PRESET_CACHE_MAX_PRESETS * ARMOR8_PACKED_PRESET_SIZE> ARMor8RamPresetCacheMemory;
+
+class ARMor8PresetCache
+{
+	public:
+		ARMor8PresetCache (IARMor8PresetStore* presetStore, IARMor8ExternalMemory* cacheMemory);
+		~ARMor8PresetCache();
+
+		// for switching to a fallback store, call it before load() or beginLoad()
+		void setPresetStore (IARMor8PresetStore* presetStore);
+
+		// copies every preset from the store into the cache, call after the presets are upgraded
+		void load();
+
+		// the same as load() but a preset at a time, loadNextPreset() returns true once every preset is in the cache
+		void beginLoad();
+		bool loadNextPreset();
+
+		ARMor8PackedPreset retrievePreset (unsigned int presetNum);
+		ARMor8PackedPreset prevPreset(); // stays on the first preset once it gets there
+		ARMor8PackedPreset nextPreset(); // stays on the last preset once it gets there
+		void writePreset (const ARMor8PackedPreset& preset, unsigned int presetNum);
+
+		unsigned int getCurrentPresetNum();
+
+		// if set, dirty presets are handed to the storage service to write back instead of being written right away
+		void setStorageService (ARMor8PresetStorageService* storageService);
+
+		// writes the lowest numbered dirty preset back to the store (or queues it with the storage service),
+		// returns false if nothing was dirty, the storage service's queue is full or the store couldn't write the preset
+		bool flushDirtyPreset();
+		void flushAllPresets();
+		bool hasDirtyPresets();
+
+	private:
+		IARMor8PresetStore*         m_PresetStore;
+		IARMor8ExternalMemory*      m_CacheMemory;
+		ARMor8PresetStorageService* m_StorageService;
+		unsigned int                m_NumPresets;
+		unsigned int                m_CurrentPresetNum;
+		unsigned int                m_NumLoadedPresets;
+
+		uint32_t m_DirtyPresets[(ARMOR8_PRESET_CACHE_MAX_PRESETS + 31) / 32];
+};
+
+#endif // ARMOR8PRESETCACHE_HPP
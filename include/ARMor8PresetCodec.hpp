@@ -0,0 +1,36 @@
+#ifndef ARMOR8PRESETCODEC_HPP
+#define ARMOR8PRESETCODEC_HPP
+
+/*************************************************************************
+ * The ARMor8PresetCodec converts between the ARMor8VoiceState used by
+ * the synth and the ARMor8PackedPreset that is actually written to the
+ * storage media. Each parameter is quantized to a fixed point field
+ * sized for its range in ARMor8Constants.hpp (8, 12 or 16 bits, with
+ * frequencies and exponents on a log scale), flags are single bits and
+ * everything is packed into a bitstream with no padding. A packed preset
+ * is 128 bytes, about a third of the ARMor8VoiceState struct, so the
+ * CAT24C64 EEPROM fits 63 presets instead of 20, and each one is four
+ * full 32 byte EEPROM pages.
+*************************************************************************/
+
+#include "ARMor8Voice.hpp"
+
+#include <stdint.h>
+
+const unsigned int ARMOR8_PACKED_PRESET_SIZE = 128;
+const unsigned int ARMOR8_NUM_PRESETS = 63; // (8KB EEPROM - header) / ARMOR8_PACKED_PRESET_SIZE
+const unsigned int ARMOR8_LEGACY_NUM_PRESETS = 20; // presets before version 1.2.0 were stored as unpacked structs
+
+struct ARMor8PackedPreset
+{
+	uint8_t data[ARMOR8_PACKED_PRESET_SIZE];
+};
+
+class ARMor8PresetCodec
+{
+	public:
+		static ARMor8PackedPreset pack (const ARMor8VoiceState& state);
+		static ARMor8VoiceState unpack (const ARMor8PackedPreset& packedPreset);
+};
+
+#endif // ARMOR8PRESETCODEC_HPP
@@ -0,0 +1,86 @@
+#ifndef ARMOR8PRESETJOURNAL_HPP
+#define ARMOR8PRESETJOURNAL_HPP
+
+/*************************************************************************
+ * The ARMor8PresetJournal is a log structured IARMor8PresetStore. The
+ * storage media is split into fixed size records, each holding one
+ * packed preset along with its preset number, a sequence number and a
+ * CRC. Each record starts on a page of its own, so a torn page write
+ * can only ever damage the record being written. Presets are never
+ * overwritten in place: a write goes to the next record (round robin)
+ * that isn't holding the latest copy of some preset. A fixed pool of
+ * spare records is kept on top of the presets, so saving the same
+ * preset over and over spreads the wear over all of the spares instead
+ * of hammering the same EEPROM cells. Older copies are reclaimed just by
+ * being superseded.
+ *
+ * At boot mount() scans every record and builds an index in RAM of the
+ * newest record with a good CRC for each preset, so lookups afterwards
+ * are a single read. If the power goes out in the middle of a write,
+ * the torn record fails its CRC and the previous copy of that preset is
+ * used instead.
+*************************************************************************/
+
+#include "IARMor8PresetStore.hpp"
+#include "IARMor8ExternalMemory.hpp"
+
+#include <stdint.h>
+
+const unsigned int PRESET_JOURNAL_HEADER_SIZE = 8; // magic, preset number, sequence number and crc
+const unsigned int PRESET_JOURNAL_RECORD_SIZE = PRESET_JOURNAL_HEADER_SIZE + ARMOR8_PACKED_PRESET_SIZE;
+const unsigned int PRESET_JOURNAL_PAGE_SIZE = 32; // the CAT24C64's write page
+const unsigned int PRESET_JOURNAL_RECORD_STRIDE = ( (PRESET_JOURNAL_RECORD_SIZE + PRESET_JOURNAL_PAGE_SIZE - 1)
+							/ PRESET_JOURNAL_PAGE_SIZE ) * PRESET_JOURNAL_PAGE_SIZE;
+const unsigned int PRESET_JOURNAL_MAX_RECORDS = 255;
+
+// records that never hold a preset of their own, so saves rotate over at least this many. on the 8KB EEPROM that's 51
+// records, so 35 presets
+const unsigned int PRESET_JOURNAL_SPARE_RECORDS = 16;
+
+class ARMor8PresetJournal : public IARMor8PresetStore
+{
+	public:
+		ARMor8PresetJournal (IARMor8ExternalMemory* media, unsigned int mediaSizeInBytes);
+		~ARMor8PresetJournal() override;
+
+		// builds the index, returns false if no presets were found (a blank media)
+		bool mount();
+
+		// the same as mount() but a record at a time, mountNextRecord() returns true once every record has been scanned
+		void beginMount();
+		bool mountNextRecord();
+
+		// presets that were never written read back as all zeroes
+		ARMor8PackedPreset retrievePreset (unsigned int presetNum) override;
+		bool writePreset (const ARMor8PackedPreset& preset, unsigned int presetNum) override;
+
+		// PRESET_JOURNAL_SPARE_RECORDS are always kept free, so this is that many less than the media has records
+		unsigned int getMaxNumPresets() override;
+
+		bool hasPreset (unsigned int presetNum);
+
+	private:
+		IARMor8ExternalMemory* m_Media;
+		unsigned int           m_NumRecords;
+		unsigned int           m_NumPresets;
+		uint32_t               m_NextSequenceNum;
+		unsigned int           m_NextRecord; // where to start looking for a free record
+
+		// only used while mounting
+		unsigned int m_MountRecord;
+		unsigned int m_NewestRecord;
+		bool         m_FoundRecord;
+		uint32_t     m_IndexSequenceNums[ARMOR8_NUM_PRESETS];
+
+		uint8_t m_Index[ARMOR8_NUM_PRESETS];                 // the record holding the latest copy of each preset
+		uint8_t m_RecordPresets[PRESET_JOURNAL_MAX_RECORDS]; // the preset number each record holds a copy of
+
+		bool isLive (unsigned int recordNum);
+
+		// returns false if the record is blank, its crc doesn't match or it couldn't be read
+		bool readRecord (unsigned int recordNum, unsigned int& presetNum, uint32_t& sequenceNum, ARMor8PackedPreset& preset);
+
+		static uint16_t crc16 (const uint8_t* data, unsigned int sizeInBytes, uint16_t crc);
+};
+
+#endif // ARMOR8PRESETJOURNAL_HPP
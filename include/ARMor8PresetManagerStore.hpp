@@ -0,0 +1,29 @@
+#ifndef ARMOR8PRESETMANAGERSTORE_HPP
+#define ARMOR8PRESETMANAGERSTORE_HPP
+
+/*******************************************************************
+ * The ARMor8PresetManagerStore keeps packed presets in the SAL
+ * PresetManager, which stores each preset in place at a fixed
+ * offset after the preset header.
+*******************************************************************/
+
+#include "IARMor8PresetStore.hpp"
+
+class PresetManager;
+
+class ARMor8PresetManagerStore : public IARMor8PresetStore
+{
+	public:
+		ARMor8PresetManagerStore (PresetManager* presetManager);
+		~ARMor8PresetManagerStore() override;
+
+		ARMor8PackedPreset retrievePreset (unsigned int presetNum) override;
+		bool writePreset (const ARMor8PackedPreset& preset, unsigned int presetNum) override;
+
+		unsigned int getMaxNumPresets() override;
+
+	private:
+		PresetManager* m_PresetManager;
+};
+
+#endif // ARMOR8PRESETMANAGERSTORE_HPP
@@ -0,0 +1,133 @@
+#ifndef ARMOR8PRESETSCHEMA_HPP
+#define ARMOR8PRESETSCHEMA_HPP
+
+/*************************************************************************
+ * An ARMor8PresetSchema describes the memory layout of one version of
+ * the preset struct as a list of field descriptors (which parameter,
+ * its type, its offset and the value it takes when an older version
+ * didn't have it). The operator fields are described once, relative to
+ * the start of an operator, since all four operators are laid out the
+ * same way. ARMor8PresetMigrator::migrate converts a preset between any
+ * two schemas by matching fields by id, so an upgrade from any version
+ * to the current one is a single conversion instead of a chain of them.
+*************************************************************************/
+
+#include "ARMor8Voice.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+const unsigned int ARMOR8_PRESET_SCHEMA_NUM_OPS = 4;
+
+// once a field has been stored in a preset its id must never be reused for anything else
+enum class PRESET_FIELD : unsigned int
+{
+	// operator fields
+	FREQUENCY,
+	USE_RATIO,
+	WAVE,
+	ATTACK,
+	ATTACK_EXPO,
+	DECAY,
+	DECAY_EXPO,
+	SUSTAIN,
+	RELEASE,
+	RELEASE_EXPO,
+	EG_AMPLITUDE_MOD,
+	EG_FREQUENCY_MOD,
+	EG_FILTER_MOD,
+	OP1_MOD_AMOUNT,
+	OP2_MOD_AMOUNT,
+	OP3_MOD_AMOUNT,
+	OP4_MOD_AMOUNT,
+	AMPLITUDE,
+	FILTER_FREQ,
+	FILTER_RES,
+	AMP_VEL_SENS,
+	FILT_VEL_SENS,
+	DETUNE,
+
+	// global fields
+	MONOPHONIC,
+	PITCH_BEND_SEMITONES,
+	GLIDE_TIME,
+	GLIDE_RETRIGGER
+};
+
+enum class PRESET_FIELD_TYPE : unsigned int
+{
+	FLOAT,
+	BOOL,
+	INT,
+	UNSIGNED_INT,
+	OSCILLATOR_MODE
+};
+
+struct ARMor8PresetField
+{
+	PRESET_FIELD      id;
+	PRESET_FIELD_TYPE type;
+	size_t            offset; // from the start of the operator for operator fields, or of the preset for global fields
+	float             defaultValue;
+};
+
+struct ARMor8PresetSchema
+{
+	const ARMor8PresetField* operatorFields;
+	unsigned int             numOperatorFields;
+	size_t                   operatorOffsets[ARMOR8_PRESET_SCHEMA_NUM_OPS];
+	const ARMor8PresetField* globalFields;
+	unsigned int             numGlobalFields;
+};
+
+class ARMor8PresetMigrator
+{
+	public:
+		// copies every field newSchema shares with oldSchema from oldPreset, the rest get newSchema's default values
+		static void migrate (const ARMor8PresetSchema& oldSchema, const void* oldPreset,
+					const ARMor8PresetSchema& newSchema, void* newPreset);
+
+	private:
+		static void migrateFields (const ARMor8PresetField* oldFields, unsigned int numOldFields, const uint8_t* oldBase,
+						const ARMor8PresetField* newFields, unsigned int numNewFields, uint8_t* newBase);
+		static float readField (const ARMor8PresetField& field, const uint8_t* base);
+		static void writeField (const ARMor8PresetField& field, uint8_t* base, float value);
+};
+
+// descriptor helpers for a preset struct, operator fields are described by the first operator's member
+#define ARMOR8_PRESET_OP_FIELD(Struct, member, id, type, defaultValue) \
+	{ PRESET_FIELD::id, PRESET_FIELD_TYPE::type, offsetof(Struct, member##1) - offsetof(Struct, frequency1), defaultValue }
+#define ARMOR8_PRESET_GLOBAL_FIELD(Struct, member, id, type, defaultValue) \
+	{ PRESET_FIELD::id, PRESET_FIELD_TYPE::type, offsetof(Struct, member), defaultValue }
+#define ARMOR8_PRESET_OP_OFFSETS(Struct) \
+	{ offsetof(Struct, frequency1), offsetof(Struct, frequency2), offsetof(Struct, frequency3), offsetof(Struct, frequency4) }
+
+// the operator fields every preset version has had
+#define ARMOR8_PRESET_ORIGINAL_OP_FIELDS(Struct) \
+	ARMOR8_PRESET_OP_FIELD(Struct, frequency,      FREQUENCY,        FLOAT,           0.0f), \
+	ARMOR8_PRESET_OP_FIELD(Struct, useRatio,       USE_RATIO,        BOOL,            0.0f), \
+	ARMOR8_PRESET_OP_FIELD(Struct, wave,           WAVE,             OSCILLATOR_MODE, 0.0f), \
+	ARMOR8_PRESET_OP_FIELD(Struct, attack,         ATTACK,           FLOAT,           0.0f), \
+	ARMOR8_PRESET_OP_FIELD(Struct, attackExpo,     ATTACK_EXPO,      FLOAT,           0.0f), \
+	ARMOR8_PRESET_OP_FIELD(Struct, decay,          DECAY,            FLOAT,           0.0f), \
+	ARMOR8_PRESET_OP_FIELD(Struct, decayExpo,      DECAY_EXPO,       FLOAT,           0.0f), \
+	ARMOR8_PRESET_OP_FIELD(Struct, sustain,        SUSTAIN,          FLOAT,           0.0f), \
+	ARMOR8_PRESET_OP_FIELD(Struct, release,        RELEASE,          FLOAT,           0.0f), \
+	ARMOR8_PRESET_OP_FIELD(Struct, releaseExpo,    RELEASE_EXPO,     FLOAT,           0.0f), \
+	ARMOR8_PRESET_OP_FIELD(Struct, egAmplitudeMod, EG_AMPLITUDE_MOD, BOOL,            0.0f), \
+	ARMOR8_PRESET_OP_FIELD(Struct, egFrequencyMod, EG_FREQUENCY_MOD, BOOL,            0.0f), \
+	ARMOR8_PRESET_OP_FIELD(Struct, egFilterMod,    EG_FILTER_MOD,    BOOL,            0.0f), \
+	ARMOR8_PRESET_OP_FIELD(Struct, op1ModAmount,   OP1_MOD_AMOUNT,   FLOAT,           0.0f), \
+	ARMOR8_PRESET_OP_FIELD(Struct, op2ModAmount,   OP2_MOD_AMOUNT,   FLOAT,           0.0f), \
+	ARMOR8_PRESET_OP_FIELD(Struct, op3ModAmount,   OP3_MOD_AMOUNT,   FLOAT,           0.0f), \
+	ARMOR8_PRESET_OP_FIELD(Struct, op4ModAmount,   OP4_MOD_AMOUNT,   FLOAT,           0.0f), \
+	ARMOR8_PRESET_OP_FIELD(Struct, amplitude,      AMPLITUDE,        FLOAT,           0.0f), \
+	ARMOR8_PRESET_OP_FIELD(Struct, filterFreq,     FILTER_FREQ,      FLOAT,           0.0f), \
+	ARMOR8_PRESET_OP_FIELD(Struct, filterRes,      FILTER_RES,       FLOAT,           0.0f), \
+	ARMOR8_PRESET_OP_FIELD(Struct, ampVelSens,     AMP_VEL_SENS,     FLOAT,           0.0f), \
+	ARMOR8_PRESET_OP_FIELD(Struct, filtVelSens,    FILT_VEL_SENS,    FLOAT,           0.0f)
+
+// the layout of ARMor8VoiceState, with the defaults for fields that older versions are missing
+extern const ARMor8PresetSchema ARMor8VoiceStateSchema;
+
+#endif // ARMOR8PRESETSCHEMA_HPP
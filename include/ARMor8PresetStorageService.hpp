@@ -0,0 +1,76 @@
+#ifndef ARMOR8PRESETSTORAGESERVICE_HPP
+#define ARMOR8PRESETSTORAGESERVICE_HPP
+
+/*************************************************************************
+ * The ARMor8PresetStorageService moves reads and writes to the preset
+ * storage media off of whatever thread asks for them. Requests are
+ * copied into a fixed size single producer single consumer queue and
+ * return immediately, and processNextRequest() performs them against
+ * the IARMor8PresetStore from the background (a worker thread on the host,
+ * the idle loop on the target). When a request is done its
+ * IPresetStorageCallback is called from that background context.
+*************************************************************************/
+
+#include "ARMor8PresetCodec.hpp"
+
+#include <atomic>
+
+const unsigned int PRESET_STORAGE_QUEUE_SIZE = 8; // must be a power of two
+
+class IARMor8PresetStore;
+
+enum class PRESET_STORAGE_OP : unsigned int
+{
+	READ,
+	WRITE
+};
+
+class IPresetStorageCallback;
+
+struct ARMor8PresetStorageRequest
+{
+	PRESET_STORAGE_OP       op;
+	unsigned int            presetNum;
+	ARMor8PackedPreset      preset; // the preset to write, or the preset that was read once the request is done
+	IPresetStorageCallback* callback;
+	bool                    succeeded; // set once the request is done, false if the store couldn't write the preset
+};
+
+class IPresetStorageCallback
+{
+	public:
+		virtual ~IPresetStorageCallback() {}
+
+		virtual void onPresetStorageComplete (const ARMor8PresetStorageRequest& request) = 0;
+};
+
+class ARMor8PresetStorageService
+{
+	public:
+		ARMor8PresetStorageService (IARMor8PresetStore* presetStore);
+		~ARMor8PresetStorageService();
+
+		// for switching to a fallback store, only while nothing is processing requests
+		void setPresetStore (IARMor8PresetStore* presetStore);
+
+		// these return false without queueing anything if the queue is full, callback can be nullptr
+		bool requestWrite (const ARMor8PackedPreset& preset, unsigned int presetNum, IPresetStorageCallback* callback);
+		bool requestRead (unsigned int presetNum, IPresetStorageCallback* callback);
+
+		// performs the oldest request, returns false if there weren't any
+		bool processNextRequest();
+		void processAllRequests();
+
+		bool hasPendingRequests();
+
+	private:
+		IARMor8PresetStore* m_PresetStore;
+
+		ARMor8PresetStorageRequest m_Queue[PRESET_STORAGE_QUEUE_SIZE];
+		std::atomic<unsigned int>  m_WriteIndex;
+		std::atomic<unsigned int>  m_ReadIndex;
+
+		bool pushRequest (const ARMor8PresetStorageRequest& request);
+};
+
+#endif // ARMOR8PRESETSTORAGESERVICE_HPP
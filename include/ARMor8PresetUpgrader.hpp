@@ -4,14 +4,21 @@
 /*************************************************************************
  * The ARMor8PresetUpgrader is an IPresetUpgrader that is meant to be
  * passed to the PresetManager's upgradePresets function. It holds a
- * record of each version of the ARMor8VoiceState preset struct in its
- * cpp file for comparisons when upgrading.
+ * record of each version of the ARMor8VoiceState preset struct and its
+ * ARMor8PresetSchema in its cpp file, so presets from any older version
+ * are converted to the current one in a single pass. Presets are
+ * upgraded one at a time in place, with the progress kept in the
+ * ARMor8PresetHeader, so an upgrade only needs memory for a single
+ * preset and picks up where it left off if the power is lost partway
+ * through.
 *************************************************************************/
 
 #include "PresetManager.hpp"
 
 #include "ARMor8Voice.hpp"
 
+struct ARMor8PresetSchema;
+
 class ARMor8PresetUpgrader : public IPresetUpgrader
 {
 	public:
@@ -24,8 +31,14 @@ class ARMor8PresetUpgrader : public IPresetUpgrader
 		ARMor8VoiceState   m_InitPreset;
 		ARMor8PresetHeader m_CurrentPresetHeader;
 
-		void upgradeFrom0_1_0To1_0_0();
-		void upgradeFrom1_0_0To1_1_0();
+		// presets before version 1.2.0 were stored as plain structs, described by oldSchema
+		template <typename OldPreset>
+		void upgradeFromUnpacked (const ARMor8PresetSchema& oldSchema);
+
+		// converts numPresets presets in place to packed presets, scratchPresetNum must be past the end of both
+		// the old and the new presets
+		template <typename OldPreset>
+		void streamPresets (const ARMor8PresetSchema& oldSchema, unsigned int numPresets, unsigned int scratchPresetNum);
 };
 
 #endif // ARMOR8PRESETUPGRADER_HPP
@@ -8,9 +8,17 @@
  * sends screen refresh events indicating the part of the screen that
  * needs to be refreshed. This way the actual lcd HAL can send only the
  * relevant data, instead of an entire frame buffer.
+ *
+ * Each value on screen is a widget with a box and a dirty flag. Changing
+ * a value only marks its widget as dirty, and draw() then redraws just
+ * the dirty widgets of the current menu. The whole menu is only redrawn
+ * when switching between menus. The parts of the screen that were drawn
+ * to are collected by an ARMor8LCDRefreshAggregator, and only published
+ * once per frame when publishLCDRefreshes() is called.
 *************************************************************************/
 
 #include "Surface.hpp"
+#include "ARMor8LCDRefreshAggregator.hpp"
 
 #include <stdint.h>
 
@@ -25,6 +33,62 @@ enum class ARMOR8_MENUS : unsigned int
 	ADDITIONAL
 };
 
+enum class ARMOR8_WIDGETS : unsigned int
+{
+	// status menu
+	PRST_AND_OP,
+	ATTACK,
+	DECAY,
+	SUSTAIN,
+	RELEASE,
+	OP1_MOD,
+	OP2_MOD,
+	OP3_MOD,
+	OP4_MOD,
+	AMPLITUDE,
+	FREQUENCY,
+	FILT_FREQ,
+	EG_DEST,
+	MONO_POLY,
+	WAVE,
+	RATIO_FIXED,
+
+	// additional menu
+	DETUNE,
+	ATTACK_EXPO,
+	DECAY_EXPO,
+	RELEASE_EXPO,
+	AMP_VEL,
+	FILT_VEL,
+	GLIDE_TIME,
+	PITCH_BEND,
+	FILT_RES,
+	GLIDE_RETRIG,
+
+	NUM_WIDGETS
+};
+
+const unsigned int ARMOR8_NUM_WIDGETS = static_cast<unsigned int>( ARMOR8_WIDGETS::NUM_WIDGETS );
+
+// in screen percentages, like everything else drawn with Graphics
+struct ARMor8UiRect
+{
+	float xStart;
+	float yStart;
+	float xEnd;
+	float yEnd;
+};
+
+struct ARMor8UiWidget
+{
+	ARMOR8_MENUS menu;
+	const char*  text; // nullptr for the widgets that are drawn as circles
+	float        textX;
+	float        textY;
+	ARMor8UiRect box;  // cleared before the widget is redrawn, and refreshed afterwards
+	bool         dirty;
+};
+
 class Font;
 class Sprite;
 
@@ -40,6 +104,9 @@ class ARMor8UiManager : public Surface, public IARMor8PresetEventListener, publi
 		void draw() override;
 		void drawLoadingLogo();
 
+		// call once per frame, at whatever the frame rate should be
+		void publishLCDRefreshes();
+
 		void tickForChangingBackToStatus();
 
 		void onARMor8PresetChangedEvent (const ARMor8PresetEvent& presetEvent) override;
@@ -75,6 +142,7 @@ class ARMor8UiManager : public Surface, public IARMor8PresetEventListener, publi
 		Sprite* 	m_Logo;
 
 		ARMOR8_MENUS 	m_CurrentMenu;
+		ARMOR8_MENUS 	m_DrawnMenu; // what's in the frame buffer, if it isn't the current menu it needs a full redraw
 
 		unsigned int    m_TicksForChangingBackToStatus;
 		const unsigned int m_MaxTicksForChangingBackToStatus = 300;
@@ -112,6 +180,10 @@ class ARMor8UiManager : public Surface, public IARMor8PresetEventListener, publi
 		char 		m_PitchBendStr[18];
 		char 		m_FiltResStr[5];
 
+		ARMor8UiWidget 	m_Widgets[ARMOR8_NUM_WIDGETS];
+
+		ARMor8LCDRefreshAggregator m_LCDRefreshAggregator;
+
 		// pot cached values for parameter thresholds (so preset parameters don't change unless moved by a certain amount)
 		const float     m_PotChangeThreshold = 0.4f; // the pot value needs to break out of this threshold to be applied
 		float 		m_FreqPotCached;
@@ -171,7 +243,14 @@ class ARMor8UiManager : public Surface, public IARMor8PresetEventListener, publi
 
 		void updateButtonState (BUTTON_STATE& buttonState, bool pressed); // note: buttonState is an output variable
 		void updateEGDestState();
-		void publishPartialLCDRefreshEvent (float xStart, float yStart, float xEnd, float yEnd);
+		void queueLCDRefresh (float xStart, float yStart, float xEnd, float yEnd); // published with the rest of the frame
+
+		void setWidget (const ARMOR8_WIDGETS& widget, const ARMOR8_MENUS& menu, const char* text, float textX, float textY,
+				float xStart, float yStart, float xEnd, float yEnd);
+		void markWidgetDirty (const ARMOR8_WIDGETS& widget);
+		void drawWidget (unsigned int widgetNum);
+		void drawMenu(); // the full menu, including the lines and labels that never change
+		void showMenu (const ARMOR8_MENUS& menu);
 
 		void lockAllPots();
 
@@ -15,6 +15,10 @@
 #include "ExponentialResponse.hpp"
 #include "PolyBLEPOsc.hpp"
 #include "ARMor8Filter.hpp"
+#include "ARMor8HalfBandDecimator.hpp"
+
+#include <atomic>
+#include <stdint.h>
 
 // the ARMor8VoiceState struct makes saving voice states for presets easier, since it's easily serializable
 struct ARMor8VoiceState
@@ -126,6 +130,10 @@ struct ARMor8VoiceState
 	bool         glideRetrigger;
 };
 
+// values for ARMor8PresetHeader::upgradeState, anything else means no upgrade is in progress
+const uint8_t PRESET_UPGRADE_CONVERTING      = 0xA5;
+const uint8_t PRESET_UPGRADE_SCRATCH_WRITTEN = 0x5A; // the preset being converted has a complete copy in the scratch slot
+
 // the ARMor8PresetHeader is intended to be used as a header for the PresetMangager, it tracks the preset version
 struct ARMor8PresetHeader
 {
@@ -135,6 +143,10 @@ struct ARMor8PresetHeader
 
 	bool presetsFileInitialized;
 
+	// progress of an upgrade to the next version, these sit in what used to be padding so the header size doesn't change
+	uint8_t  upgradeState;
+	uint16_t upgradeNumConverted;
+
 	bool operator!= (const ARMor8PresetHeader& other)
 	{
 		if (versionMajor == other.versionMajor && versionMinor == other.versionMinor && versionPatch == other.versionPatch)
@@ -146,6 +158,8 @@ struct ARMor8PresetHeader
 	}
 };
 
+static_assert( sizeof(ARMor8PresetHeader) == 16, "the preset header size can't change, presets are stored right after it" );
+
 class ARMor8Voice
 {
 	public:
@@ -199,8 +213,29 @@ class ARMor8Voice
 		void onKeyEvent (const KeyEvent& keyEvent);
 		const KeyEvent& getActiveKeyEvent();
 
+		// fades the voice out quickly before playing the key event if it's still audible, to avoid clicks when stealing
+		void stealForKeyEvent (const KeyEvent& keyEvent);
+		float getOutputLevel();
+
 		void onPitchEvent (const PitchEvent& pitchEvent);
 
+		// oversampling is chosen per note from the summed modulation depth, this caps it. it's off (1) unless this is
+		// called, since it multiplies the cost of rendering a sample by up to ARMOR8_MAX_OVERSAMPLING
+		void setMaxOversamplingFactor (unsigned int maxOversamplingFactor);
+		unsigned int getOversamplingFactor();
+
+		// the factor is only picked when a note starts on a silent voice, this switches to it. call it from the audio
+		// thread between blocks, so the rate never changes underneath a sample being rendered
+		void updateOversampling();
+
+		// the rate this voice is rendered at, which doesn't need to match the SAMPLE_RATE the SAL dsp classes assume
+		void setSampleRate (float sampleRate);
+		float getSampleRate();
+
+		// an extra detune on top of the operator detunes, for stacking voices in unison
+		void setUnisonDetune (int cents);
+		int getUnisonDetune();
+
 	private:
 		PolyBLEPOsc       	m_Osc1;
 		PolyBLEPOsc             m_Osc2;
@@ -234,6 +269,39 @@ class ARMor8Voice
 		Operator* 		m_Operators[4];
 
 		KeyEvent                m_ActiveKeyEvent;
+		KeyEvent                m_StolenKeyEvent; // played once the steal fade finishes
+		unsigned int            m_StealFadeSamplesLeft;
+		float                   m_OutputLevel;
+		float                   m_LevelDecay;
+		unsigned int            m_StealFadeLength;
+
+		ARMor8HalfBandDecimator   m_Decimator4xTo2x;
+		ARMor8HalfBandDecimator   m_Decimator2xTo1x;
+		std::atomic<unsigned int> m_MaxOversamplingFactor;
+		std::atomic<unsigned int> m_NextOversamplingFactor; // picked at note on, switched to by updateOversampling()
+		unsigned int              m_OversamplingFactor;
+
+		// the SAL dsp classes assume SAMPLE_RATE, so rate dependent values are scaled before being passed to them
+		float                   m_SampleRate;
+		float                   m_RateScale; // the oversampled rate divided by SAMPLE_RATE
+		float                   m_PitchFactor; // the last pitch bend, the operators get it divided by the rate scale
+		int                     m_UnisonDetune; // in cents
+
+		float renderDecimatedSample();
+		float renderSample();
+
+		unsigned int calculateOversamplingFactor();
+		void setOversamplingFactor (unsigned int oversamplingFactor);
+		void setRate (unsigned int oversamplingFactor, float sampleRate);
+		void calculateOutputRateValues();
+		void sendPitchFactor();
+
+		float scaleTime (float seconds);
+		float unscaleTime (float seconds);
+		float scaleFrequency (float frequency);
+		float unscaleFrequency (float frequency);
+		int scaleDetune (int cents);
+		int unscaleDetune (int cents);
 };
 
 #endif // ARMOR8VOICE_HPP
@@ -0,0 +1,89 @@
+#ifndef ARMOR8VOICEALLOCATOR_HPP
+#define ARMOR8VOICEALLOCATOR_HPP
+
+/*************************************************************************
+ * The ARMor8VoiceAllocator decides which voice plays which note when
+ * the ARMor8VoiceManager is polyphonic. It keeps a note to voice table
+ * for every midi note, a queue of free voices ordered by when they were
+ * released (so release tails get as long as possible before reuse) and
+ * a queue of sounding voices ordered by when they were triggered. All
+ * of these are intrusive linked lists over fixed arrays, so note on and
+ * note off are constant time and never allocate. When a new note needs
+ * a voice, the VOICE_STEALING_STRATEGY decides which one it gets, out
+ * of the free voices if there are any and the held voices otherwise.
+*************************************************************************/
+
+const unsigned int MAX_VOICES = 6;
+const unsigned int MIDI_NUM_NOTES = 128;
+const int NO_VOICE = -1;
+const int NO_NOTE = -1;
+
+enum class VOICE_STEALING_STRATEGY : unsigned int
+{
+	RELEASING_FIRST, // least recently released voice, then the oldest held voice
+	OLDEST,          // the free voice that was triggered the longest time ago, then the oldest held voice
+	QUIETEST         // the free voice with the lowest output level, then the quietest held voice
+};
+
+class ARMor8Voice;
+
+class ARMor8VoiceAllocator
+{
+	public:
+		ARMor8VoiceAllocator (ARMor8Voice** voices);
+		~ARMor8VoiceAllocator();
+
+		void setStealingStrategy (const VOICE_STEALING_STRATEGY& strategy);
+		VOICE_STEALING_STRATEGY getStealingStrategy();
+
+		// if on, a released voice that last played the same note is reused before the strategy is consulted
+		void setSameNoteReuse (bool on);
+		bool getSameNoteReuse();
+
+		// returns the voice already playing this note, otherwise the voice picked by the same note reuse and
+		// the stealing strategy. note: needsFade is an output variable, true if the voice is still audible
+		unsigned int allocateVoice (unsigned int note, bool& needsFade);
+
+		// returns the voice that was playing this note, or NO_VOICE if the note isn't playing
+		int releaseNote (unsigned int note);
+
+		int getVoiceForNote (unsigned int note);
+		int getNoteForVoice (unsigned int voice);
+
+		void reset();
+
+	private:
+		ARMor8Voice** m_Voices;
+
+		VOICE_STEALING_STRATEGY m_StealingStrategy;
+		bool m_SameNoteReuse;
+
+		int m_NoteToVoice[MIDI_NUM_NOTES];
+		int m_VoiceToNote[MAX_VOICES];
+
+		// for same note reuse, the voice each note was last released on and the note each voice last played
+		int m_ReleasedNoteToVoice[MIDI_NUM_NOTES];
+		int m_LastNoteOfVoice[MAX_VOICES];
+
+		// trigger 'timestamps' so the oldest voice can be found even after it's released
+		unsigned int m_TriggerCount;
+		unsigned int m_VoiceTriggerTime[MAX_VOICES];
+
+		// links for whichever queue the voice is currently in
+		int m_NextVoice[MAX_VOICES];
+		int m_PrevVoice[MAX_VOICES];
+
+		int m_FreeHead;
+		int m_FreeTail;
+		int m_ActiveHead;
+		int m_ActiveTail;
+
+		// both only look at the queue starting at queueHead
+		int findOldestVoice (int queueHead);
+		int findQuietestVoice (int queueHead);
+
+		void pushBack (unsigned int voice, int& head, int& tail);
+		void unlink (unsigned int voice, int& head, int& tail);
+};
+
+#endif // ARMOR8VOICEALLOCATOR_HPP
@@ -8,6 +8,10 @@
 ****************************************************************************/
 
 #include "ARMor8Voice.hpp"
+#include "ARMor8VoiceAllocator.hpp"
+#include "ARMor8NoteStack.hpp"
+#include "ARMor8DelayEffect.hpp"
+#include "ARMor8PatchSnapshot.hpp"
 #include "ARMor8Constants.hpp"
 #include "IBufferCallback.hpp"
 #include "IMidiEventListener.hpp"
@@ -16,15 +20,13 @@
 #include "IButtonEventListener.hpp"
 
 class MidiHandler;
-class PresetManager;
-
-const unsigned int MAX_VOICES = 6;
+class ARMor8PresetCache;
 
 class ARMor8VoiceManager : public IBufferCallback, public IKeyEventListener, public IPitchEventListener,
 				public IPotEventListener, public IButtonEventListener
 {
 	public:
-		ARMor8VoiceManager (MidiHandler* midiHandler, PresetManager* presetManager);
+		ARMor8VoiceManager (MidiHandler* midiHandler, ARMor8PresetCache* presetCache);
 		~ARMor8VoiceManager() override;
 
 		void setOperatorToEdit (unsigned int opToEdit);
@@ -34,6 +36,26 @@ class ARMor8VoiceManager : public IBufferCallback, public IKeyEventListener, pub
 
 		void setMonophonic (bool on);
 
+		// off by default, see ARMor8Voice::setMaxOversamplingFactor()
+		void setOversampling (bool on);
+
+		// the rate call() and renderBlock() render at, defaults to SAMPLE_RATE
+		void setSampleRate (float sampleRate);
+
+		void setVoiceStealingStrategy (const VOICE_STEALING_STRATEGY& strategy);
+		void setSameNoteReuse (bool on);
+
+		void setMonoNotePriority (const MONO_NOTE_PRIORITY& priority);
+
+		// in monophonic mode the idle voices can be stacked in unison, detuned between -cents and +cents. each copy is a
+		// whole ARMor8Voice rendered after the other, so n voices of unison cost n voices
+		void setUnison (unsigned int numVoices);
+		void setUnisonDetune (int cents);
+
+		// how far apart the stereo renderBlock() pans the unison voices, 0.0f keeps them all in the center and 1.0f puts the
+		// outermost ones hard left and right
+		void setUnisonSpread (float spread);
+
 		void setOperatorFreq (unsigned int opNum, float freq);
 		void setOperatorDetune (unsigned int opNum, int cents);
 		void setOperatorWave (unsigned int opNum, const OscillatorMode& wave);
@@ -58,13 +80,29 @@ class ARMor8VoiceManager : public IBufferCallback, public IKeyEventListener, pub
 		void setPitchBendSemitones (const unsigned int pitchBendSemitones);
 		unsigned int getPitchBendSemitones() { return m_PitchBendSemitones; }
 
-		ARMor8VoiceState getState();
+		// the delay and chorus are applied to the summed voices, their delay line is sizeInBytes of memory at offsetInBytes
+		void setDelayEffectMemory (IARMor8ExternalMemory* memory, unsigned int offsetInBytes, unsigned int sizeInBytes);
+		void setDelayEffectMode (const DELAY_EFFECT_MODE& mode);
+		void setDelayTime (float seconds);
+		void setDelayFeedback (float feedback);
+		void setDelayMix (float mix);
+		void setChorusRate (float hz);
+		void setChorusDepth (float seconds);
+
+		// the cached snapshot, it's only rebuilt from the voices if a parameter has changed since the last call
+		const ARMor8VoiceState& getState();
 		void setState(const ARMor8VoiceState& state);
 
 		ARMor8PresetHeader getPresetHeader();
 
 		void call (float* writeBuffer) override;
 
+		// renders any number of samples straight into writeBuffer, so hosts don't need an intermediate AudioBuffer
+		void renderBlock (float* writeBuffer, unsigned int numSamples);
+
+		// the same in stereo, the unison voices are panned across the two channels and everything else is in the center
+		void renderBlock (float* writeBufferL, float* writeBufferR, unsigned int numSamples);
+
 		void onKeyEvent (const KeyEvent& keyEvent) override;
 
 		void onPitchEvent (const PitchEvent& pitchEvent) override;
@@ -74,24 +112,41 @@ class ARMor8VoiceManager : public IBufferCallback, public IKeyEventListener, pub
 		void onButtonEvent (const ButtonEvent& buttonEvent) override;
 
 	private:
-		MidiHandler*   m_MidiHandler;
-		PresetManager* m_PresetManager;
-		unsigned int   m_OpToEdit;
-		bool           m_Monophonic;
-		ARMor8Voice    m_Voice1;
-		ARMor8Voice    m_Voice2;
-		ARMor8Voice    m_Voice3;
-		ARMor8Voice    m_Voice4;
-		ARMor8Voice    m_Voice5;
-		ARMor8Voice    m_Voice6;
-		ARMor8Voice*   m_Voices[MAX_VOICES];
+		MidiHandler*       m_MidiHandler;
+		ARMor8PresetCache* m_PresetCache;
+		unsigned int       m_OpToEdit;
+		bool               m_Monophonic;
+		ARMor8Voice        m_Voice1;
+		ARMor8Voice        m_Voice2;
+		ARMor8Voice        m_Voice3;
+		ARMor8Voice        m_Voice4;
+		ARMor8Voice        m_Voice5;
+		ARMor8Voice        m_Voice6;
+		ARMor8Voice*       m_Voices[MAX_VOICES];
 
 		KeyEvent m_ActiveKeyEvents[MAX_VOICES];
-		unsigned int m_ActiveKeyEventIndex;
+		ARMor8VoiceAllocator m_VoiceAllocator;
+		ARMor8NoteStack m_NoteStack; // held keys in monophonic mode, only voice 0 and its unison voices are used
+
+		unsigned int m_UnisonVoices;
+		int          m_UnisonDetuneCents;
+		float        m_UnisonGain;
+		float        m_UnisonSpread;
+		float        m_UnisonGainsL[MAX_VOICES]; // m_UnisonGain with each voice's pan applied
+		float        m_UnisonGainsR[MAX_VOICES];
 
 		unsigned int m_PitchBendSemitones;
 
 		ARMor8PresetHeader m_PresetHeader;
+
+		ARMor8DelayEffect m_DelayEffect;
+
+		ARMor8PatchSnapshot m_PatchSnapshot;
+
+		void updateUnisonVoices();
+		void publishPresetEvent();
+		void sendMonoKeyEvent (const KeyEvent& keyEvent);
+		void releaseAllVoices(); // for switching between mono and poly, since neither mode knows the other's held keys
 };
 
 #endif // ARMOR8VOICEMANAGER_HPP
@@ -0,0 +1,63 @@
+#ifndef IARMOR8EXTERNALMEMORY_HPP
+#define IARMOR8EXTERNALMEMORY_HPP
+
+/*******************************************************************
+ * An IARMor8ExternalMemory is a block of memory outside of the
+ * processor's own RAM, like the 23K256 SPI SRAM on the target. The
+ * start functions are allowed to return before the transfer is
+ * done (with DMA for example), in which case waitForTransfers()
+ * must be called before the data is touched again. Memories that
+ * can't transfer in the background just do it right away. The
+ * blocking functions return false if the memory stopped responding,
+ * in which case the transfer may only have partly happened.
+*******************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+
+class IARMor8ExternalMemory
+{
+	public:
+		virtual ~IARMor8ExternalMemory() {}
+
+		virtual bool writeBytes (const uint8_t* data, unsigned int sizeInBytes, unsigned int offsetInBytes) = 0;
+		virtual bool readBytes (uint8_t* data, unsigned int sizeInBytes, unsigned int offsetInBytes) = 0;
+
+		virtual void startWriteBytes (const uint8_t* data, unsigned int sizeInBytes, unsigned int offsetInBytes)
+		{
+			this->writeBytes( data, sizeInBytes, offsetInBytes );
+		}
+		virtual void startReadBytes (uint8_t* data, unsigned int sizeInBytes, unsigned int offsetInBytes)
+		{
+			this->readBytes( data, sizeInBytes, offsetInBytes );
+		}
+		virtual void waitForTransfers() {}
+};
+
+// for when the processor's own RAM is big enough, like on the host
+template <unsigned int SIZE>
+class ARMor8RamMemory : public IARMor8ExternalMemory
+{
+	public:
+		ARMor8RamMemory() : m_Memory{ 0 } {}
+		~ARMor8RamMemory() override {}
+
+		bool writeBytes (const uint8_t* data, unsigned int sizeInBytes, unsigned int offsetInBytes) override
+		{
+			memcpy( &m_Memory[offsetInBytes], data, sizeInBytes );
+
+			return true;
+		}
+
+		bool readBytes (uint8_t* data, unsigned int sizeInBytes, unsigned int offsetInBytes) override
+		{
+			memcpy( data, &m_Memory[offsetInBytes], sizeInBytes );
+
+			return true;
+		}
+
+	private:
+		uint8_t m_Memory[SIZE];
+};
+
+#endif // IARMOR8EXTERNALMEMORY_HPP
@@ -5,24 +5,37 @@
  * An IARMor8PresetEventListener specifies a simple interface which
  * a subclass can use to be notified of ARMor8 preset events.
  * Specifically this means changing between operators and presets.
+ * The event only refers to the voice manager's patch snapshot (so
+ * it's only valid during the callback), and carries a bitmask of
+ * the ARMor8PresetFields that changed since the last event so
+ * listeners only need to update those.
 *******************************************************************/
 
 #include "ARMor8Voice.hpp"
+#include "ARMor8PatchSnapshot.hpp"
 #include "IEventListener.hpp"
 
 class ARMor8PresetEvent : public IEvent
 {
 	public:
-		ARMor8PresetEvent (const ARMor8VoiceState& preset, unsigned int opToEdit, unsigned int presetNum,
-					unsigned int channel);
+		ARMor8PresetEvent (const ARMor8VoiceState& preset, unsigned int changedFields, unsigned int version,
+					unsigned int opToEdit, unsigned int presetNum, unsigned int channel);
 		~ARMor8PresetEvent() override;
 
-		ARMor8VoiceState getPreset() const { return m_Preset; }
+		const ARMor8VoiceState& getPreset() const { return m_Preset; }
+		unsigned int getChangedFields() const { return m_ChangedFields; }
+		bool fieldChanged (const ARMor8PresetField& field) const
+		{
+			return ( m_ChangedFields & static_cast<unsigned int>(field) ) != 0;
+		}
+		unsigned int getVersion() const { return m_Version; }
 		unsigned int getOpToEdit() const { return m_OpToEdit; }
 		unsigned int getPresetNum() const { return m_PresetNum; }
 
 	private:
-		ARMor8VoiceState m_Preset;
+		const ARMor8VoiceState& m_Preset;
+		unsigned int m_ChangedFields;
+		unsigned int m_Version;
 		unsigned int m_OpToEdit;
 		unsigned int m_PresetNum;
 };
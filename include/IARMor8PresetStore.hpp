@@ -0,0 +1,26 @@
+#ifndef IARMOR8PRESETSTORE_HPP
+#define IARMOR8PRESETSTORE_HPP
+
+/*******************************************************************
+ * An IARMor8PresetStore is wherever packed presets are kept between
+ * power cycles. The ARMor8PresetCache and the
+ * ARMor8PresetStorageService only go through this, so the presets
+ * can live in the SAL PresetManager (ARMor8PresetManagerStore) or in
+ * the wear levelled ARMor8PresetJournal.
+*******************************************************************/
+
+#include "ARMor8PresetCodec.hpp"
+
+class IARMor8PresetStore
+{
+	public:
+		virtual ~IARMor8PresetStore() {}
+
+		virtual ARMor8PackedPreset retrievePreset (unsigned int presetNum) = 0;
+		// returns false if the preset couldn't be written, whatever was stored for presetNum before is still there then
+		virtual bool writePreset (const ARMor8PackedPreset& preset, unsigned int presetNum) = 0;
+
+		virtual unsigned int getMaxNumPresets() = 0;
+};
+
+#endif // IARMOR8PRESETSTORE_HPP
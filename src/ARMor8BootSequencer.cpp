@@ -0,0 +1,125 @@
+#include "ARMor8BootSequencer.hpp"
+
+ARMor8BootSequencer::ARMor8BootSequencer (ARMor8BootClock clock, uint32_t ticksPerMicrosecond) :
+	m_Clock( clock ),
+	m_TicksPerMicrosecond( (ticksPerMicrosecond > 0) ? ticksPerMicrosecond : 1 ),
+	m_LastClockTicks( clock() ),
+	m_Ticks( 0 ),
+	m_StartTime( 0 ),
+	m_TimeToAudio( 0 ),
+	m_TimeToFinish( 0 ),
+	m_Tasks(),
+	m_NumTasks( 0 ),
+	m_CurrentTask( 0 )
+{
+}
+
+ARMor8BootSequencer::~ARMor8BootSequencer()
+{
+}
+
+bool ARMor8BootSequencer::addTask (const char* name, ARMor8BootStep step, void* context)
+{
+	if ( m_NumTasks >= BOOT_SEQUENCER_MAX_TASKS )
+	{
+		return false;
+	}
+
+	ARMor8BootTask task = { name, step, context, 0, 0, 0, false };
+	m_Tasks[m_NumTasks] = task;
+	m_NumTasks++;
+
+	return true;
+}
+
+void ARMor8BootSequencer::markAudioRunning()
+{
+	m_TimeToAudio = this->now() - m_StartTime;
+}
+
+bool ARMor8BootSequencer::runNextStep()
+{
+	if ( m_CurrentTask >= m_NumTasks )
+	{
+		return false;
+	}
+
+	ARMor8BootTask& task = m_Tasks[m_CurrentTask];
+
+	uint64_t stepStart = this->now();
+	task.finished = task.step( task.context );
+	uint64_t stepEnd = this->now();
+
+	task.elapsedTicks += stepEnd - stepStart;
+	task.elapsedMicroseconds = this->toMicroseconds( task.elapsedTicks );
+	task.numSteps++;
+
+	if ( task.finished )
+	{
+		m_CurrentTask++;
+
+		if ( m_CurrentTask == m_NumTasks )
+		{
+			m_TimeToFinish = stepEnd - m_StartTime;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool ARMor8BootSequencer::runSteps (uint32_t budgetMicroseconds)
+{
+	uint64_t budgetStart = this->now();
+	uint64_t budgetTicks = static_cast<uint64_t>( budgetMicroseconds ) * m_TicksPerMicrosecond;
+
+	while ( this->runNextStep() )
+	{
+		if ( this->now() - budgetStart >= budgetTicks )
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool ARMor8BootSequencer::isFinished()
+{
+	return m_CurrentTask >= m_NumTasks;
+}
+
+uint32_t ARMor8BootSequencer::getTimeToAudio()
+{
+	return this->toMicroseconds( m_TimeToAudio );
+}
+
+uint32_t ARMor8BootSequencer::getTimeToFinish()
+{
+	return this->toMicroseconds( m_TimeToFinish );
+}
+
+unsigned int ARMor8BootSequencer::getNumTasks()
+{
+	return m_NumTasks;
+}
+
+const ARMor8BootTask& ARMor8BootSequencer::getTask (unsigned int taskNum)
+{
+	return m_Tasks[( taskNum < m_NumTasks ) ? taskNum : 0];
+}
+
+uint64_t ARMor8BootSequencer::now()
+{
+	// the difference is taken in 32 bits first, so it's right across a wrap
+	uint32_t clockTicks = m_Clock();
+	m_Ticks += static_cast<uint32_t>( clockTicks - m_LastClockTicks );
+	m_LastClockTicks = clockTicks;
+
+	return m_Ticks;
+}
+
+uint32_t ARMor8BootSequencer::toMicroseconds (uint64_t ticks)
+{
+	return static_cast<uint32_t>( ticks / m_TicksPerMicrosecond );
+}
@@ -0,0 +1,293 @@
+#include "ARMor8DelayEffect.hpp"
+
+#include "ARMor8Constants.hpp"
+#include "AudioConstants.hpp"
+
+#include <cmath>
+
+static inline int16_t toStoredSample (float sample)
+{
+	sample = sample * ( 32767.0f / DELAY_EFFECT_HEADROOM );
+
+	if ( sample > 32767.0f )
+	{
+		sample = 32767.0f;
+	}
+	else if ( sample < -32767.0f )
+	{
+		sample = -32767.0f;
+	}
+
+	return static_cast<int16_t>( sample );
+}
+
+static inline float fromStoredSample (int16_t sample)
+{
+	return static_cast<float>( sample ) * ( DELAY_EFFECT_HEADROOM / 32767.0f );
+}
+
+ARMor8DelayEffect::ARMor8DelayEffect() :
+	m_Memory( nullptr ),
+	m_MemoryOffset( 0 ),
+	m_LineLength( 0 ),
+	m_Mode( DELAY_EFFECT_MODE::OFF ),
+	m_ActiveMode( DELAY_EFFECT_MODE::OFF ),
+	m_SampleRate( static_cast<float>(SAMPLE_RATE) ),
+	m_DelayTime( 0.3f ),
+	m_Feedback( 0.4f ),
+	m_Mix( 0.3f ),
+	m_ChorusRate( 0.5f ),
+	m_ChorusDepth( 0.002f ),
+	m_WritePos( 0 ),
+	m_History( 0 ),
+	m_LfoPhase( 0.0f ),
+	m_ReadBuffer{ 0 },
+	m_WriteBuffer{ 0 },
+	m_PrefetchStart( 0 ),
+	m_PrefetchLength( 0 ),
+	m_PrefetchValid( false ),
+	m_TransfersPending( false )
+{
+}
+
+ARMor8DelayEffect::~ARMor8DelayEffect()
+{
+}
+
+void ARMor8DelayEffect::setMemory (IARMor8ExternalMemory* memory, unsigned int offsetInBytes, unsigned int sizeInBytes)
+{
+	m_Memory = memory;
+	m_MemoryOffset = offsetInBytes;
+	m_LineLength = sizeInBytes / sizeof(int16_t);
+	m_WritePos = 0;
+	m_History = 0;
+	m_PrefetchValid = false;
+	m_TransfersPending = false;
+}
+
+void ARMor8DelayEffect::setMode (const DELAY_EFFECT_MODE& mode)
+{
+	m_Mode.store( mode );
+}
+
+DELAY_EFFECT_MODE ARMor8DelayEffect::getMode()
+{
+	return m_Mode.load();
+}
+
+void ARMor8DelayEffect::setSampleRate (float sampleRate)
+{
+	m_SampleRate = sampleRate;
+}
+
+void ARMor8DelayEffect::setDelayTime (float seconds)
+{
+	m_DelayTime = seconds;
+}
+
+void ARMor8DelayEffect::setFeedback (float feedback)
+{
+	m_Feedback = feedback;
+}
+
+void ARMor8DelayEffect::setMix (float mix)
+{
+	m_Mix = mix;
+}
+
+void ARMor8DelayEffect::setChorusRate (float hz)
+{
+	m_ChorusRate = hz;
+}
+
+void ARMor8DelayEffect::setChorusDepth (float seconds)
+{
+	m_ChorusDepth = seconds;
+}
+
+void ARMor8DelayEffect::process (float* buffer, unsigned int numSamples)
+{
+	// mode changes are picked up here, so the delay line is only ever touched from the audio thread
+	const DELAY_EFFECT_MODE mode = m_Mode.load();
+	if ( mode != m_ActiveMode )
+	{
+		if ( m_TransfersPending )
+		{
+			m_Memory->waitForTransfers();
+			m_TransfersPending = false;
+		}
+
+		m_ActiveMode = mode;
+		m_History = 0; // whatever is in the delay line from before is stale
+		m_LfoPhase = 0.0f;
+		m_PrefetchValid = false;
+	}
+
+	if ( m_ActiveMode == DELAY_EFFECT_MODE::OFF || m_Memory == nullptr || m_LineLength < DELAY_EFFECT_READ_SIZE * 4 )
+	{
+		return;
+	}
+
+	while ( numSamples > 0 )
+	{
+		unsigned int blockSize = ( numSamples < DELAY_EFFECT_BLOCK_SIZE ) ? numSamples : DELAY_EFFECT_BLOCK_SIZE;
+		this->processBlock( buffer, blockSize );
+
+		buffer += blockSize;
+		numSamples -= blockSize;
+	}
+}
+
+void ARMor8DelayEffect::processBlock (float* buffer, unsigned int numSamples)
+{
+	unsigned int readStart = 0;
+	unsigned int readLength = 0;
+	float chorusCenter = 0.0f;
+	float chorusDepth = 0.0f;
+	unsigned int delaySamples = 0;
+	this->getReadSpan( numSamples, readStart, readLength, chorusCenter, chorusDepth, delaySamples );
+
+	if ( m_TransfersPending )
+	{
+		m_Memory->waitForTransfers();
+		m_TransfersPending = false;
+	}
+
+	// the prefetch assumed a full block with the same settings, if that's not what we got just read it now
+	if ( ! m_PrefetchValid || readStart != m_PrefetchStart || readLength != m_PrefetchLength )
+	{
+		this->readLine( readStart, readLength, false );
+	}
+	m_PrefetchValid = false;
+
+	const float wet = m_Mix;
+	const float dry = 1.0f - m_Mix;
+
+	if ( m_ActiveMode == DELAY_EFFECT_MODE::DELAY )
+	{
+		for ( unsigned int sample = 0; sample < numSamples; sample++ )
+		{
+			// samples from before the effect was turned on are silence
+			float delayed = ( delaySamples - sample <= m_History ) ? fromStoredSample( m_ReadBuffer[sample] ) : 0.0f;
+			float in = buffer[sample];
+
+			buffer[sample] = ( in * dry ) + ( delayed * wet );
+			m_WriteBuffer[sample] = toStoredSample( in + (delayed * m_Feedback) );
+		}
+	}
+	else
+	{
+		const unsigned int centerInt = static_cast<unsigned int>( chorusCenter );
+		const unsigned int depthCeil = static_cast<unsigned int>( chorusDepth ) + 1;
+		const float readOffset = static_cast<float>( centerInt + depthCeil + 1 ) - chorusCenter; // index of no delay change
+		const float lfoIncr = m_ChorusRate / m_SampleRate;
+
+		for ( unsigned int sample = 0; sample < numSamples; sample++ )
+		{
+			float lfo = ( 4.0f * std::fabs(m_LfoPhase - 0.5f) ) - 1.0f; // triangle
+			float delayTime = chorusCenter + ( chorusDepth * lfo );
+
+			float delayed = 0.0f;
+			if ( delayTime - static_cast<float>(sample) <= static_cast<float>(m_History) )
+			{
+				float readIndex = static_cast<float>( sample ) + readOffset - ( chorusDepth * lfo );
+				unsigned int readIndexInt = static_cast<unsigned int>( readIndex );
+				float frac = readIndex - static_cast<float>( readIndexInt );
+				delayed = ( fromStoredSample(m_ReadBuffer[readIndexInt]) * (1.0f - frac) )
+						+ ( fromStoredSample(m_ReadBuffer[readIndexInt + 1]) * frac );
+			}
+			float in = buffer[sample];
+
+			buffer[sample] = ( in * dry ) + ( delayed * wet );
+			m_WriteBuffer[sample] = toStoredSample( in );
+
+			m_LfoPhase += lfoIncr;
+			if ( m_LfoPhase >= 1.0f )
+			{
+				m_LfoPhase -= 1.0f;
+			}
+		}
+	}
+
+	this->writeLine( m_WritePos, numSamples );
+	m_WritePos = ( m_WritePos + numSamples ) % m_LineLength;
+	m_History = ( m_History + numSamples < m_LineLength ) ? m_History + numSamples : m_LineLength;
+
+	// request what the next block needs now, the memory performs transfers in order so this comes after the write
+	this->getReadSpan( DELAY_EFFECT_BLOCK_SIZE, m_PrefetchStart, m_PrefetchLength, chorusCenter, chorusDepth, delaySamples );
+	this->readLine( m_PrefetchStart, m_PrefetchLength, true );
+	m_PrefetchValid = true;
+	m_TransfersPending = true;
+}
+
+void ARMor8DelayEffect::getReadSpan (unsigned int numSamples, unsigned int& start, unsigned int& length, float& chorusCenter,
+					float& chorusDepth, unsigned int& delaySamples)
+{
+	// every delay has to be longer than a block, so a block never reads samples it hasn't written yet
+	const unsigned int minDelay = DELAY_EFFECT_BLOCK_SIZE + 1;
+	const unsigned int maxDelay = m_LineLength - DELAY_EFFECT_READ_SIZE;
+
+	if ( m_ActiveMode == DELAY_EFFECT_MODE::DELAY )
+	{
+		delaySamples = static_cast<unsigned int>( m_DelayTime * m_SampleRate );
+		delaySamples = ( delaySamples < minDelay ) ? minDelay : delaySamples;
+		delaySamples = ( delaySamples > maxDelay ) ? maxDelay : delaySamples;
+
+		start = ( m_WritePos + m_LineLength - delaySamples ) % m_LineLength;
+		length = numSamples;
+	}
+	else
+	{
+		chorusDepth = m_ChorusDepth * m_SampleRate;
+		chorusDepth = ( chorusDepth < 0.0f ) ? 0.0f : chorusDepth;
+		chorusDepth = ( chorusDepth > DELAY_EFFECT_MAX_DEPTH_SAMPLES ) ? DELAY_EFFECT_MAX_DEPTH_SAMPLES : chorusDepth;
+
+		chorusCenter = ARMOR8_CHORUS_DELAY_TIME * m_SampleRate;
+		chorusCenter = ( chorusCenter < chorusDepth + minDelay + 1.0f ) ? chorusDepth + minDelay + 1.0f : chorusCenter;
+		chorusCenter = ( chorusCenter > maxDelay - chorusDepth ) ? maxDelay - chorusDepth : chorusCenter;
+
+		const unsigned int centerInt = static_cast<unsigned int>( chorusCenter );
+		const unsigned int depthCeil = static_cast<unsigned int>( chorusDepth ) + 1;
+
+		start = ( m_WritePos + m_LineLength - centerInt - depthCeil - 1 ) % m_LineLength;
+		length = numSamples + ( 2 * depthCeil ) + 2;
+	}
+}
+
+void ARMor8DelayEffect::readLine (unsigned int start, unsigned int length, bool inBackground)
+{
+	// the span can wrap around the end of the delay line
+	unsigned int firstLength = ( start + length > m_LineLength ) ? m_LineLength - start : length;
+	uint8_t* firstDest = reinterpret_cast<uint8_t*>( &m_ReadBuffer[0] );
+	uint8_t* secondDest = reinterpret_cast<uint8_t*>( &m_ReadBuffer[firstLength] );
+
+	if ( inBackground )
+	{
+		m_Memory->startReadBytes( firstDest, firstLength * sizeof(int16_t), m_MemoryOffset + (start * sizeof(int16_t)) );
+		if ( firstLength < length )
+		{
+			m_Memory->startReadBytes( secondDest, (length - firstLength) * sizeof(int16_t), m_MemoryOffset );
+		}
+	}
+	else
+	{
+		m_Memory->readBytes( firstDest, firstLength * sizeof(int16_t), m_MemoryOffset + (start * sizeof(int16_t)) );
+		if ( firstLength < length )
+		{
+			m_Memory->readBytes( secondDest, (length - firstLength) * sizeof(int16_t), m_MemoryOffset );
+		}
+	}
+}
+
+void ARMor8DelayEffect::writeLine (unsigned int start, unsigned int length)
+{
+	unsigned int firstLength = ( start + length > m_LineLength ) ? m_LineLength - start : length;
+	const uint8_t* firstSrc = reinterpret_cast<const uint8_t*>( &m_WriteBuffer[0] );
+	const uint8_t* secondSrc = reinterpret_cast<const uint8_t*>( &m_WriteBuffer[firstLength] );
+
+	m_Memory->startWriteBytes( firstSrc, firstLength * sizeof(int16_t), m_MemoryOffset + (start * sizeof(int16_t)) );
+	if ( firstLength < length )
+	{
+		m_Memory->startWriteBytes( secondSrc, (length - firstLength) * sizeof(int16_t), m_MemoryOffset );
+	}
+}
@@ -0,0 +1,228 @@
+#include "ARMor8FactoryPresetStore.hpp"
+
+#include "ARMor8PresetJournal.hpp"
+#include "ARMor8PresetCodec.hpp"
+
+#include <string.h>
+
+// one operator's worth of ARMor8VoiceState, so the factory presets can be put together an operator at a time
+struct FactoryOperator
+{
+	float          frequency;
+	bool           useRatio;
+	OscillatorMode wave;
+	float          attack;
+	float          attackExpo;
+	float          decay;
+	float          decayExpo;
+	float          sustain;
+	float          release;
+	float          releaseExpo;
+	bool           egAmplitudeMod;
+	bool           egFrequencyMod;
+	bool           egFilterMod;
+	float          op1ModAmount;
+	float          op2ModAmount;
+	float          op3ModAmount;
+	float          op4ModAmount;
+	float          amplitude;
+	float          filterFreq;
+	float          filterRes;
+	float          ampVelSens;
+	float          filtVelSens;
+	int            detune;
+};
+
+// these are all constexpr (and c++11 constexpr functions are a single return statement), so the whole table below is
+// built by the compiler and nothing runs at boot
+
+// a plain operator with its own wave and amplitude, the rest is filled in by the helpers below. every value has to be in
+// the ranges in ARMor8Constants.hpp, or the preset played from flash won't match its packed (clamped) copy
+static constexpr FactoryOperator op (OscillatorMode wave, float amplitude)
+{
+	return FactoryOperator{ 500.0f, false, wave, 0.02f, 2.0f, 0.02f, 2.0f, 1.0f, 0.02f, 2.0f, false, false, false,
+				0.0f, 0.0f, 0.0f, 0.0f, amplitude, 20000.0f, 0.0f, 0.0f, 0.0f, 0 };
+}
+
+// the init preset is silent and the same as it always has been, so a slot filled with it doesn't make a sound until it's
+// edited, and slots filled with it by older versions are still recognised by fillIfEmpty()
+static constexpr FactoryOperator initOp = FactoryOperator{ 1000.0f, false, OscillatorMode::SINE, 0.0f, 2.0f, 0.0f, 2.0f,
+								1.0f, 0.0f, 2.0f, false, false, false, 0.0f, 0.0f, 0.0f,
+								0.0f, 0.0f, 20000.0f, 0.0f, 0.0f, 0.0f, 0 };
+
+// the envelope is routed to the amplitude, since that's what setting one is nearly always for
+static constexpr FactoryOperator withEnvelope (FactoryOperator o, float attack, float decay, float sustain, float release)
+{
+	return FactoryOperator{ o.frequency, o.useRatio, o.wave, attack, o.attackExpo, decay, o.decayExpo, sustain, release,
+				o.releaseExpo, true, o.egFrequencyMod, o.egFilterMod, o.op1ModAmount, o.op2ModAmount,
+				o.op3ModAmount, o.op4ModAmount, o.amplitude, o.filterFreq, o.filterRes, o.ampVelSens, o.filtVelSens,
+				o.detune };
+}
+
+static constexpr FactoryOperator withEGDestinations (FactoryOperator o, bool amplitude, bool frequency, bool filter)
+{
+	return FactoryOperator{ o.frequency, o.useRatio, o.wave, o.attack, o.attackExpo, o.decay, o.decayExpo, o.sustain,
+				o.release, o.releaseExpo, amplitude, frequency, filter, o.op1ModAmount, o.op2ModAmount,
+				o.op3ModAmount, o.op4ModAmount, o.amplitude, o.filterFreq, o.filterRes, o.ampVelSens, o.filtVelSens,
+				o.detune };
+}
+
+// how much each operator modulates this one
+static constexpr FactoryOperator withModulation (FactoryOperator o, float op1, float op2, float op3, float op4)
+{
+	return FactoryOperator{ o.frequency, o.useRatio, o.wave, o.attack, o.attackExpo, o.decay, o.decayExpo, o.sustain,
+				o.release, o.releaseExpo, o.egAmplitudeMod, o.egFrequencyMod, o.egFilterMod, op1, op2, op3, op4,
+				o.amplitude, o.filterFreq, o.filterRes, o.ampVelSens, o.filtVelSens, o.detune };
+}
+
+static constexpr FactoryOperator withFilter (FactoryOperator o, float frequency, float resonance)
+{
+	return FactoryOperator{ o.frequency, o.useRatio, o.wave, o.attack, o.attackExpo, o.decay, o.decayExpo, o.sustain,
+				o.release, o.releaseExpo, o.egAmplitudeMod, o.egFrequencyMod, o.egFilterMod, o.op1ModAmount,
+				o.op2ModAmount, o.op3ModAmount, o.op4ModAmount, o.amplitude, frequency, resonance, o.ampVelSens,
+				o.filtVelSens, o.detune };
+}
+
+static constexpr FactoryOperator withVelocity (FactoryOperator o, float ampVelSens, float filtVelSens)
+{
+	return FactoryOperator{ o.frequency, o.useRatio, o.wave, o.attack, o.attackExpo, o.decay, o.decayExpo, o.sustain,
+				o.release, o.releaseExpo, o.egAmplitudeMod, o.egFrequencyMod, o.egFilterMod, o.op1ModAmount,
+				o.op2ModAmount, o.op3ModAmount, o.op4ModAmount, o.amplitude, o.filterFreq, o.filterRes, ampVelSens,
+				filtVelSens, o.detune };
+}
+
+static constexpr FactoryOperator withDetune (FactoryOperator o, int cents)
+{
+	return FactoryOperator{ o.frequency, o.useRatio, o.wave, o.attack, o.attackExpo, o.decay, o.decayExpo, o.sustain,
+				o.release, o.releaseExpo, o.egAmplitudeMod, o.egFrequencyMod, o.egFilterMod, o.op1ModAmount,
+				o.op2ModAmount, o.op3ModAmount, o.op4ModAmount, o.amplitude, o.filterFreq, o.filterRes, o.ampVelSens,
+				o.filtVelSens, cents };
+}
+
+static constexpr ARMor8VoiceState preset (FactoryOperator o1, FactoryOperator o2, FactoryOperator o3, FactoryOperator o4,
+						bool monophonic, unsigned int pitchBendSemitones, float glideTime, bool glideRetrigger)
+{
+	return ARMor8VoiceState{
+		o1.frequency, o1.useRatio, o1.wave, o1.attack, o1.attackExpo, o1.decay, o1.decayExpo, o1.sustain, o1.release,
+		o1.releaseExpo, o1.egAmplitudeMod, o1.egFrequencyMod, o1.egFilterMod, o1.op1ModAmount, o1.op2ModAmount,
+		o1.op3ModAmount, o1.op4ModAmount, o1.amplitude, o1.filterFreq, o1.filterRes, o1.ampVelSens, o1.filtVelSens,
+		o1.detune,
+
+		o2.frequency, o2.useRatio, o2.wave, o2.attack, o2.attackExpo, o2.decay, o2.decayExpo, o2.sustain, o2.release,
+		o2.releaseExpo, o2.egAmplitudeMod, o2.egFrequencyMod, o2.egFilterMod, o2.op1ModAmount, o2.op2ModAmount,
+		o2.op3ModAmount, o2.op4ModAmount, o2.amplitude, o2.filterFreq, o2.filterRes, o2.ampVelSens, o2.filtVelSens,
+		o2.detune,
+
+		o3.frequency, o3.useRatio, o3.wave, o3.attack, o3.attackExpo, o3.decay, o3.decayExpo, o3.sustain, o3.release,
+		o3.releaseExpo, o3.egAmplitudeMod, o3.egFrequencyMod, o3.egFilterMod, o3.op1ModAmount, o3.op2ModAmount,
+		o3.op3ModAmount, o3.op4ModAmount, o3.amplitude, o3.filterFreq, o3.filterRes, o3.ampVelSens, o3.filtVelSens,
+		o3.detune,
+
+		o4.frequency, o4.useRatio, o4.wave, o4.attack, o4.attackExpo, o4.decay, o4.decayExpo, o4.sustain, o4.release,
+		o4.releaseExpo, o4.egAmplitudeMod, o4.egFrequencyMod, o4.egFilterMod, o4.op1ModAmount, o4.op2ModAmount,
+		o4.op3ModAmount, o4.op4ModAmount, o4.amplitude, o4.filterFreq, o4.filterRes, o4.ampVelSens, o4.filtVelSens,
+		o4.detune,
+
+		monophonic, pitchBendSemitones, glideTime, glideRetrigger
+	};
+}
+
+// an operator that only modulates
+static constexpr FactoryOperator silentSine = op( OscillatorMode::SINE, 0.0f );
+
+extern constexpr ARMor8VoiceState ARMor8FactoryPresets[ARMOR8_NUM_FACTORY_PRESETS] =
+{
+	// init
+	preset( initOp, initOp, initOp, initOp, false, 1, 0.0f, false ),
+
+	// bell
+	preset( withVelocity(withModulation(withEnvelope(op(OscillatorMode::SINE, 1.0f), 0.002f, 1.5f, 0.0f, 1.5f),
+					0.0f, 900.0f, 0.0f, 0.0f), 0.5f, 0.0f),
+		withEnvelope(silentSine, 0.002f, 0.8f, 0.0f, 0.8f),
+		silentSine, silentSine, false, 2, 0.0f, false ),
+
+	// electric piano
+	preset( withVelocity(withModulation(withEnvelope(op(OscillatorMode::SINE, 1.0f), 0.002f, 1.2f, 0.3f, 0.4f),
+					0.0f, 300.0f, 0.0f, 0.0f), 0.8f, 0.0f),
+		withEnvelope(silentSine, 0.002f, 0.3f, 0.1f, 0.3f),
+		silentSine, silentSine, false, 2, 0.0f, false ),
+
+	// bass
+	preset( withFilter(withEnvelope(op(OscillatorMode::SQUARE, 1.0f), 0.002f, 0.25f, 0.6f, 0.05f), 800.0f, 1.5f),
+		silentSine, silentSine, silentSine, true, 2, 0.03f, false ),
+
+	// pad
+	preset( withFilter(withEnvelope(op(OscillatorMode::SAWTOOTH, 0.6f), 0.8f, 0.5f, 0.8f, 1.5f), 3000.0f, 0.3f),
+		withDetune(withFilter(withEnvelope(op(OscillatorMode::SAWTOOTH, 0.6f), 0.8f, 0.5f, 0.8f, 1.5f), 3000.0f, 0.3f),
+				7),
+		silentSine, silentSine, false, 2, 0.0f, false ),
+
+	// brass
+	preset( withEGDestinations(withFilter(withEnvelope(op(OscillatorMode::SAWTOOTH, 1.0f), 0.08f, 0.3f, 0.7f, 0.2f),
+					4000.0f, 0.8f), true, false, true),
+		silentSine, silentSine, silentSine, false, 2, 0.0f, false ),
+
+	// pluck
+	preset( withVelocity(withEnvelope(op(OscillatorMode::TRIANGLE, 1.0f), 0.002f, 0.4f, 0.0f, 0.3f), 0.6f, 0.0f),
+		silentSine, silentSine, silentSine, false, 2, 0.0f, false ),
+
+	// lead
+	preset( withFilter(withEnvelope(op(OscillatorMode::SQUARE, 0.8f), 0.01f, 0.2f, 0.8f, 0.2f), 6000.0f, 0.5f),
+		withDetune(op(OscillatorMode::SAWTOOTH, 0.4f), -5),
+		silentSine, silentSine, true, 2, 0.12f, true ),
+};
+
+ARMor8FactoryPresetStore::ARMor8FactoryPresetStore (ARMor8PresetJournal* userPresets) :
+	m_UserPresets( userPresets )
+{
+}
+
+ARMor8FactoryPresetStore::~ARMor8FactoryPresetStore()
+{
+}
+
+ARMor8PackedPreset ARMor8FactoryPresetStore::retrievePreset (unsigned int presetNum)
+{
+	if ( m_UserPresets->hasPreset(presetNum) )
+	{
+		return m_UserPresets->retrievePreset( presetNum );
+	}
+
+	return ARMor8PresetCodec::pack( getFactoryPreset(presetNum) );
+}
+
+bool ARMor8FactoryPresetStore::writePreset (const ARMor8PackedPreset& preset, unsigned int presetNum)
+{
+	return m_UserPresets->writePreset( preset, presetNum );
+}
+
+unsigned int ARMor8FactoryPresetStore::getMaxNumPresets()
+{
+	return m_UserPresets->getMaxNumPresets();
+}
+
+bool ARMor8FactoryPresetStore::isFactoryPreset (unsigned int presetNum)
+{
+	return ! m_UserPresets->hasPreset( presetNum );
+}
+
+const ARMor8VoiceState& ARMor8FactoryPresetStore::getFactoryPreset (unsigned int presetNum)
+{
+	return ( presetNum < ARMOR8_NUM_FACTORY_PRESETS ) ? ARMor8FactoryPresets[presetNum] : ARMor8FactoryPresets[0];
+}
+
+ARMor8PackedPreset ARMor8FactoryPresetStore::fillIfEmpty (const ARMor8PackedPreset& preset, unsigned int presetNum)
+{
+	if ( presetNum == 0 || presetNum >= ARMOR8_NUM_FACTORY_PRESETS )
+	{
+		return preset;
+	}
+
+	const ARMor8PackedPreset initPreset = ARMor8PresetCodec::pack( ARMor8FactoryPresets[0] );
+	if ( memcmp(preset.data, initPreset.data, sizeof(preset.data)) != 0 )
+	{
+		return preset;
+	}
+
+	return ARMor8PresetCodec::pack( ARMor8FactoryPresets[presetNum] );
+}
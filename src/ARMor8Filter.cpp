@@ -1,12 +1,18 @@
 #include "ARMor8Filter.hpp"
 
+#include "ARMor8Constants.hpp"
+
+#include <cmath>
+
 ARMor8Filter::ARMor8Filter() :
 	filter1(),
 	filter2(),
 	filter3(),
 	filter4(),
 	m_Resonance(0.0f),
-	m_PrevSample(0.0f)
+	m_PrevSample(0.0f),
+	m_Frequency(20000.0f),
+	m_Bypassed(false)
 {
 	this->setCoefficients(20000.0f);
 }
@@ -17,6 +23,22 @@ ARMor8Filter::~ARMor8Filter()
 
 float ARMor8Filter::processSample (float sample)
 {
+	// once the input and the feedback have died out, skip the stages so their tails never decay into denormals
+	if ( std::fabs(sample) < ARMOR8_DENORMAL_THRESHOLD && std::fabs(m_PrevSample) < ARMOR8_DENORMAL_THRESHOLD )
+	{
+		// the stages still hold their tails, which would come back as a click once the bypass ends
+		if ( ! m_Bypassed )
+		{
+			this->resetStages();
+			m_Bypassed = true;
+		}
+
+		m_PrevSample = 0.0f;
+		return 0.0f;
+	}
+
+	m_Bypassed = false;
+
 	m_PrevSample = (m_PrevSample * -m_Resonance) + sample;
 	float out1 = filter1.processSample(m_PrevSample);
 	float out2 = filter2.processSample(out1);
@@ -40,6 +62,8 @@ float ARMor8Filter::processSample (float sample)
 
 void ARMor8Filter::setCoefficients (float frequency)
 {
+	m_Frequency = frequency;
+
 	filter1.setCoefficients(frequency);
 	filter2.setCoefficients(frequency);
 	filter3.setCoefficients(frequency);
@@ -55,3 +79,13 @@ float ARMor8Filter::getResonance()
 {
 	return m_Resonance;
 }
+
+void ARMor8Filter::resetStages()
+{
+	// OnePoleFilter can't clear just its state, so start every stage over from a fresh filter at the same cutoff
+	filter1 = OnePoleFilter();
+	filter1.setCoefficients(m_Frequency);
+	filter2 = filter1;
+	filter3 = filter1;
+	filter4 = filter1;
+}
@@ -0,0 +1,61 @@
+#include "ARMor8HalfBandDecimator.hpp"
+
+#include <string.h>
+
+// kaiser windowed (beta = 5.5) half-band coefficients, only the first half of the odd branch since it's symmetric
+static const float halfBandCoefficients[HALF_BAND_ODD_TAPS / 2] =
+{
+	0.000438541f,
+	-0.001749994f,
+	0.004391293f,
+	-0.009058511f,
+	0.016765884f,
+	-0.029326467f,
+	0.051123779f,
+	-0.098143180f,
+	0.315568961f
+};
+
+static const float halfBandCenterCoefficient = 0.5f;
+
+ARMor8HalfBandDecimator::ARMor8HalfBandDecimator() :
+	m_OddDelayLine{ 0.0f },
+	m_EvenDelayLine{ 0.0f },
+	m_OddWriteIndex( 0 ),
+	m_EvenWriteIndex( 0 )
+{
+}
+
+ARMor8HalfBandDecimator::~ARMor8HalfBandDecimator()
+{
+}
+
+float ARMor8HalfBandDecimator::processSamples (float sample1, float sample2)
+{
+	// even branch, the center tap is just a delayed copy of the first sample
+	float evenOut = m_EvenDelayLine[m_EvenWriteIndex];
+	m_EvenDelayLine[m_EvenWriteIndex] = sample1;
+	m_EvenWriteIndex = (m_EvenWriteIndex + 1) % HALF_BAND_EVEN_DELAY;
+
+	// odd branch, newest sample ends up at the end of the window
+	m_OddDelayLine[m_OddWriteIndex] = sample2;
+	m_OddDelayLine[m_OddWriteIndex + HALF_BAND_ODD_TAPS] = sample2;
+	m_OddWriteIndex = (m_OddWriteIndex + 1) % HALF_BAND_ODD_TAPS;
+
+	const float* window = &m_OddDelayLine[m_OddWriteIndex];
+	float oddOut = 0.0f;
+	for ( unsigned int tap = 0; tap < HALF_BAND_ODD_TAPS / 2; tap++ )
+	{
+		oddOut += halfBandCoefficients[tap] * ( window[tap] + window[HALF_BAND_ODD_TAPS - 1 - tap] );
+	}
+
+	return oddOut + ( halfBandCenterCoefficient * evenOut );
+}
+
+void ARMor8HalfBandDecimator::reset()
+{
+	memset( m_OddDelayLine, 0, sizeof(m_OddDelayLine) );
+	memset( m_EvenDelayLine, 0, sizeof(m_EvenDelayLine) );
+	m_OddWriteIndex = 0;
+	m_EvenWriteIndex = 0;
+}
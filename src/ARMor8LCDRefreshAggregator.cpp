@@ -0,0 +1,113 @@
+#include "ARMor8LCDRefreshAggregator.hpp"
+
+#include "IARMor8LCDRefreshEventListener.hpp"
+
+static ARMor8LCDRefreshRect rectUnion (const ARMor8LCDRefreshRect& a, const ARMor8LCDRefreshRect& b)
+{
+	return ARMor8LCDRefreshRect{ ( a.xStart < b.xStart ) ? a.xStart : b.xStart, ( a.yStart < b.yStart ) ? a.yStart : b.yStart,
+					( a.xEnd > b.xEnd ) ? a.xEnd : b.xEnd, ( a.yEnd > b.yEnd ) ? a.yEnd : b.yEnd };
+}
+
+ARMor8LCDRefreshAggregator::ARMor8LCDRefreshAggregator (unsigned int width, unsigned int height, unsigned int transferCost) :
+	m_Width( width ),
+	m_Height( height ),
+	m_TransferCost( transferCost ),
+	m_Rects(),
+	m_NumRects( 0 )
+{
+}
+
+ARMor8LCDRefreshAggregator::~ARMor8LCDRefreshAggregator()
+{
+}
+
+void ARMor8LCDRefreshAggregator::addRect (unsigned int xStart, unsigned int yStart, unsigned int xEnd, unsigned int yEnd)
+{
+	if ( m_Width == 0 || m_Height == 0 || xStart > xEnd || yStart > yEnd || xStart >= m_Width || yStart >= m_Height )
+	{
+		return;
+	}
+
+	ARMor8LCDRefreshRect merged = { xStart, yStart, ( xEnd < m_Width ) ? xEnd : m_Width - 1,
+						( yEnd < m_Height ) ? yEnd : m_Height - 1 };
+
+	// fold in every rect that's no cheaper to send on its own, checking again since the union may now cover others
+	unsigned int rectNum = 0;
+	while ( rectNum < m_NumRects )
+	{
+		ARMor8LCDRefreshRect combined = rectUnion( merged, m_Rects[rectNum] );
+
+		if ( this->transferCost(combined) <= this->transferCost(merged) + this->transferCost(m_Rects[rectNum]) )
+		{
+			merged = combined;
+			this->removeRect( rectNum );
+			rectNum = 0;
+		}
+		else
+		{
+			rectNum++;
+		}
+	}
+
+	if ( m_NumRects < LCD_REFRESH_MAX_RECTS )
+	{
+		m_Rects[m_NumRects] = merged;
+		m_NumRects++;
+
+		return;
+	}
+
+	// out of rects, so it goes in with whichever one adds the least cost
+	unsigned int bestRectNum = 0;
+	unsigned int bestCost = 0;
+	for ( rectNum = 0; rectNum < m_NumRects; rectNum++ )
+	{
+		unsigned int cost = this->transferCost( rectUnion(merged, m_Rects[rectNum]) ) - this->transferCost( m_Rects[rectNum] );
+
+		if ( rectNum == 0 || cost < bestCost )
+		{
+			bestRectNum = rectNum;
+			bestCost = cost;
+		}
+	}
+
+	merged = rectUnion( merged, m_Rects[bestRectNum] );
+	this->removeRect( bestRectNum );
+
+	this->addRect( merged.xStart, merged.yStart, merged.xEnd, merged.yEnd );
+}
+
+void ARMor8LCDRefreshAggregator::addFullScreen()
+{
+	// nothing else needs sending once the whole screen is
+	m_NumRects = 0;
+
+	this->addRect( 0, 0, m_Width - 1, m_Height - 1 );
+}
+
+unsigned int ARMor8LCDRefreshAggregator::flush()
+{
+	unsigned int numPublished = m_NumRects;
+
+	for ( unsigned int rectNum = 0; rectNum < m_NumRects; rectNum++ )
+	{
+		const ARMor8LCDRefreshRect& rect = m_Rects[rectNum];
+
+		IARMor8LCDRefreshEventListener::PublishEvent( ARMor8LCDRefreshEvent(rect.xStart, rect.yStart, rect.xEnd, rect.yEnd, 0) );
+	}
+
+	m_NumRects = 0;
+
+	return numPublished;
+}
+
+unsigned int ARMor8LCDRefreshAggregator::transferCost (const ARMor8LCDRefreshRect& rect) const
+{
+	return ( (rect.xEnd - rect.xStart + 1) * (rect.yEnd - rect.yStart + 1) ) + m_TransferCost;
+}
+
+void ARMor8LCDRefreshAggregator::removeRect (unsigned int rectNum)
+{
+	m_NumRects--;
+	m_Rects[rectNum] = m_Rects[m_NumRects];
+}
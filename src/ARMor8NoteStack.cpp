@@ -0,0 +1,189 @@
+#include "ARMor8NoteStack.hpp"
+
+static const uint8_t NO_SLOT = 0xFF;
+static const unsigned int NUM_NOTE_WORDS = MIDI_NUM_NOTES / 32;
+
+ARMor8NoteStack::ARMor8NoteStack() :
+	m_Priority( MONO_NOTE_PRIORITY::HIGHEST ),
+	m_FreeSlot( NO_SLOT ),
+	m_OldestSlot( NO_SLOT ),
+	m_LastSlot( NO_SLOT ),
+	m_NumHeldNotes( 0 )
+{
+	this->reset();
+}
+
+ARMor8NoteStack::~ARMor8NoteStack()
+{
+}
+
+void ARMor8NoteStack::setPriority (const MONO_NOTE_PRIORITY& priority)
+{
+	m_Priority = priority;
+}
+
+MONO_NOTE_PRIORITY ARMor8NoteStack::getPriority()
+{
+	return m_Priority;
+}
+
+void ARMor8NoteStack::pushNote (unsigned int note, unsigned int velocity)
+{
+	note = note % MIDI_NUM_NOTES;
+
+	uint8_t slot = m_NoteToSlot[note];
+	if ( slot != NO_SLOT ) // already held, so it just moves to the top
+	{
+		this->unlinkSlot( slot );
+	}
+	else
+	{
+		if ( m_FreeSlot == NO_SLOT ) // out of slots, so forget the oldest note
+		{
+			this->removeNote( m_SlotNote[m_OldestSlot] );
+		}
+
+		slot = m_FreeSlot;
+		m_FreeSlot = m_SlotNext[slot];
+
+		m_NoteToSlot[note] = slot;
+		m_SlotNote[slot] = static_cast<uint8_t>( note );
+		m_HeldNotes[note / 32] |= ( 1u << (note % 32) );
+		m_NumHeldNotes++;
+	}
+
+	m_SlotVelocity[slot] = static_cast<uint8_t>( velocity );
+
+	// link as the last note
+	m_SlotPrev[slot] = m_LastSlot;
+	m_SlotNext[slot] = NO_SLOT;
+	if ( m_LastSlot != NO_SLOT )
+	{
+		m_SlotNext[m_LastSlot] = slot;
+	}
+	else
+	{
+		m_OldestSlot = slot;
+	}
+	m_LastSlot = slot;
+}
+
+void ARMor8NoteStack::removeNote (unsigned int note)
+{
+	note = note % MIDI_NUM_NOTES;
+
+	uint8_t slot = m_NoteToSlot[note];
+	if ( slot == NO_SLOT )
+	{
+		return;
+	}
+
+	this->unlinkSlot( slot );
+
+	m_SlotNext[slot] = m_FreeSlot;
+	m_FreeSlot = slot;
+
+	m_NoteToSlot[note] = NO_SLOT;
+	m_HeldNotes[note / 32] &= ~( 1u << (note % 32) );
+	m_NumHeldNotes--;
+}
+
+int ARMor8NoteStack::getActiveNote()
+{
+	if ( m_NumHeldNotes == 0 )
+	{
+		return NO_NOTE;
+	}
+
+	if ( m_Priority == MONO_NOTE_PRIORITY::HIGHEST )
+	{
+		for ( int word = NUM_NOTE_WORDS - 1; word >= 0; word-- )
+		{
+			if ( m_HeldNotes[word] != 0 )
+			{
+				return ( word * 32 ) + 31 - __builtin_clz( m_HeldNotes[word] );
+			}
+		}
+	}
+	else if ( m_Priority == MONO_NOTE_PRIORITY::LOWEST )
+	{
+		for ( unsigned int word = 0; word < NUM_NOTE_WORDS; word++ )
+		{
+			if ( m_HeldNotes[word] != 0 )
+			{
+				return ( word * 32 ) + __builtin_ctz( m_HeldNotes[word] );
+			}
+		}
+	}
+
+	return m_SlotNote[m_LastSlot];
+}
+
+unsigned int ARMor8NoteStack::getVelocity (unsigned int note)
+{
+	uint8_t slot = m_NoteToSlot[note % MIDI_NUM_NOTES];
+	if ( slot != NO_SLOT )
+	{
+		return m_SlotVelocity[slot];
+	}
+
+	return 0;
+}
+
+unsigned int ARMor8NoteStack::getNumHeldNotes()
+{
+	return m_NumHeldNotes;
+}
+
+void ARMor8NoteStack::reset()
+{
+	for ( unsigned int note = 0; note < MIDI_NUM_NOTES; note++ )
+	{
+		m_NoteToSlot[note] = NO_SLOT;
+	}
+
+	for ( unsigned int word = 0; word < NUM_NOTE_WORDS; word++ )
+	{
+		m_HeldNotes[word] = 0;
+	}
+
+	for ( unsigned int slot = 0; slot < NOTE_STACK_SIZE; slot++ )
+	{
+		m_SlotNote[slot] = 0;
+		m_SlotVelocity[slot] = 0;
+		m_SlotNext[slot] = ( slot + 1 < NOTE_STACK_SIZE ) ? slot + 1 : NO_SLOT;
+		m_SlotPrev[slot] = NO_SLOT;
+	}
+
+	m_FreeSlot = 0;
+	m_OldestSlot = NO_SLOT;
+	m_LastSlot = NO_SLOT;
+	m_NumHeldNotes = 0;
+}
+
+void ARMor8NoteStack::unlinkSlot (uint8_t slot)
+{
+	uint8_t prev = m_SlotPrev[slot];
+	uint8_t next = m_SlotNext[slot];
+
+	if ( prev != NO_SLOT )
+	{
+		m_SlotNext[prev] = next;
+	}
+	else
+	{
+		m_OldestSlot = next;
+	}
+
+	if ( next != NO_SLOT )
+	{
+		m_SlotPrev[next] = prev;
+	}
+	else
+	{
+		m_LastSlot = prev;
+	}
+
+	m_SlotPrev[slot] = NO_SLOT;
+	m_SlotNext[slot] = NO_SLOT;
+}
@@ -0,0 +1,145 @@
+#include "ARMor8PatchSnapshot.hpp"
+
+static unsigned int fieldIf (bool changed, const ARMor8PresetField& field)
+{
+	return ( changed ) ? static_cast<unsigned int>( field ) : 0;
+}
+
+// the operator fields that differ between a and b
+static unsigned int diffOperators (const ARMor8OperatorState& a, const ARMor8OperatorState& b)
+{
+	unsigned int changedFields = 0;
+
+	changedFields |= fieldIf( a.frequency != b.frequency, ARMor8PresetField::FREQUENCY );
+	changedFields |= fieldIf( a.useRatio != b.useRatio, ARMor8PresetField::RATIO );
+	changedFields |= fieldIf( a.wave != b.wave, ARMor8PresetField::WAVE );
+	changedFields |= fieldIf( a.attack != b.attack, ARMor8PresetField::ATTACK );
+	changedFields |= fieldIf( a.attackExpo != b.attackExpo, ARMor8PresetField::ATTACK_EXPO );
+	changedFields |= fieldIf( a.decay != b.decay, ARMor8PresetField::DECAY );
+	changedFields |= fieldIf( a.decayExpo != b.decayExpo, ARMor8PresetField::DECAY_EXPO );
+	changedFields |= fieldIf( a.sustain != b.sustain, ARMor8PresetField::SUSTAIN );
+	changedFields |= fieldIf( a.release != b.release, ARMor8PresetField::RELEASE );
+	changedFields |= fieldIf( a.releaseExpo != b.releaseExpo, ARMor8PresetField::RELEASE_EXPO );
+	changedFields |= fieldIf( a.egAmplitudeMod != b.egAmplitudeMod || a.egFrequencyMod != b.egFrequencyMod
+					|| a.egFilterMod != b.egFilterMod, ARMor8PresetField::EG_DESTINATIONS );
+	changedFields |= fieldIf( a.op1ModAmount != b.op1ModAmount, ARMor8PresetField::OP1_MOD_AMOUNT );
+	changedFields |= fieldIf( a.op2ModAmount != b.op2ModAmount, ARMor8PresetField::OP2_MOD_AMOUNT );
+	changedFields |= fieldIf( a.op3ModAmount != b.op3ModAmount, ARMor8PresetField::OP3_MOD_AMOUNT );
+	changedFields |= fieldIf( a.op4ModAmount != b.op4ModAmount, ARMor8PresetField::OP4_MOD_AMOUNT );
+	changedFields |= fieldIf( a.amplitude != b.amplitude, ARMor8PresetField::AMPLITUDE );
+	changedFields |= fieldIf( a.filterFreq != b.filterFreq, ARMor8PresetField::FILTER_FREQ );
+	changedFields |= fieldIf( a.filterRes != b.filterRes, ARMor8PresetField::FILTER_RES );
+	changedFields |= fieldIf( a.ampVelSens != b.ampVelSens, ARMor8PresetField::AMP_VEL_SENS );
+	changedFields |= fieldIf( a.filtVelSens != b.filtVelSens, ARMor8PresetField::FILT_VEL_SENS );
+	changedFields |= fieldIf( a.detune != b.detune, ARMor8PresetField::DETUNE );
+
+	return changedFields;
+}
+
+ARMor8PatchSnapshot::ARMor8PatchSnapshot() :
+	m_State(),
+	m_IsStale( true ),
+	m_Version( 0 ),
+	m_EditedFields( 0 ),
+	m_HasPublished( false ),
+	m_PublishedVersion( 0 ),
+	m_PublishedOpToEdit( 0 ),
+	m_PublishedPresetNum( 0 ),
+	m_PublishedOperator(),
+	m_PublishedMonophonic( false ),
+	m_PublishedPitchBendSemitones( 0 ),
+	m_PublishedGlideTime( 0.0f ),
+	m_PublishedGlideRetrigger( false )
+{
+}
+
+ARMor8PatchSnapshot::~ARMor8PatchSnapshot()
+{
+}
+
+void ARMor8PatchSnapshot::update (const ARMor8VoiceState& state)
+{
+	m_State = state;
+	m_IsStale = false;
+	m_Version++;
+}
+
+unsigned int ARMor8PatchSnapshot::takeChangedFields (unsigned int opToEdit, unsigned int presetNum)
+{
+	ARMor8OperatorState op = getOperatorState( m_State, opToEdit );
+	unsigned int changedFields = 0;
+
+	if ( ! m_HasPublished )
+	{
+		changedFields = ARMOR8_PRESET_FIELDS_ALL;
+	}
+	else if ( m_Version != m_PublishedVersion || opToEdit != m_PublishedOpToEdit )
+	{
+		changedFields |= diffOperators( op, m_PublishedOperator );
+
+		changedFields |= fieldIf( opToEdit != m_PublishedOpToEdit, ARMor8PresetField::OP_TO_EDIT );
+
+		changedFields |= fieldIf( m_State.monophonic != m_PublishedMonophonic, ARMor8PresetField::MONOPHONIC );
+		changedFields |= fieldIf( m_State.pitchBendSemitones != m_PublishedPitchBendSemitones,
+						ARMor8PresetField::PITCH_BEND );
+		changedFields |= fieldIf( m_State.glideTime != m_PublishedGlideTime, ARMor8PresetField::GLIDE_TIME );
+		changedFields |= fieldIf( m_State.glideRetrigger != m_PublishedGlideRetrigger,
+						ARMor8PresetField::GLIDE_RETRIGGER );
+	}
+
+	if ( presetNum != m_PublishedPresetNum )
+	{
+		changedFields |= static_cast<unsigned int>( ARMor8PresetField::PRESET_NUM );
+	}
+
+	// whatever was edited since is showing the edited value, not the published one, so it's redrawn either way
+	changedFields |= m_EditedFields;
+	m_EditedFields = 0;
+
+	m_HasPublished = true;
+	m_PublishedVersion = m_Version;
+	m_PublishedOpToEdit = opToEdit;
+	m_PublishedPresetNum = presetNum;
+	m_PublishedOperator = op;
+	m_PublishedMonophonic = m_State.monophonic;
+	m_PublishedPitchBendSemitones = m_State.pitchBendSemitones;
+	m_PublishedGlideTime = m_State.glideTime;
+	m_PublishedGlideRetrigger = m_State.glideRetrigger;
+
+	return changedFields;
+}
+
+ARMor8OperatorState ARMor8PatchSnapshot::getOperatorState (const ARMor8VoiceState& state, unsigned int opNum)
+{
+	switch ( opNum )
+	{
+		case 1:
+			return ARMor8OperatorState{ state.frequency2, state.useRatio2, state.wave2, state.attack2, state.attackExpo2,
+							state.decay2, state.decayExpo2, state.sustain2, state.release2,
+							state.releaseExpo2, state.egAmplitudeMod2, state.egFrequencyMod2,
+							state.egFilterMod2, state.op1ModAmount2, state.op2ModAmount2,
+							state.op3ModAmount2, state.op4ModAmount2, state.amplitude2, state.filterFreq2,
+							state.filterRes2, state.ampVelSens2, state.filtVelSens2, state.detune2 };
+		case 2:
+			return ARMor8OperatorState{ state.frequency3, state.useRatio3, state.wave3, state.attack3, state.attackExpo3,
+							state.decay3, state.decayExpo3, state.sustain3, state.release3,
+							state.releaseExpo3, state.egAmplitudeMod3, state.egFrequencyMod3,
+							state.egFilterMod3, state.op1ModAmount3, state.op2ModAmount3,
+							state.op3ModAmount3, state.op4ModAmount3, state.amplitude3, state.filterFreq3,
+							state.filterRes3, state.ampVelSens3, state.filtVelSens3, state.detune3 };
+		case 3:
+			return ARMor8OperatorState{ state.frequency4, state.useRatio4, state.wave4, state.attack4, state.attackExpo4,
+							state.decay4, state.decayExpo4, state.sustain4, state.release4,
+							state.releaseExpo4, state.egAmplitudeMod4, state.egFrequencyMod4,
+							state.egFilterMod4, state.op1ModAmount4, state.op2ModAmount4,
+							state.op3ModAmount4, state.op4ModAmount4, state.amplitude4, state.filterFreq4,
+							state.filterRes4, state.ampVelSens4, state.filtVelSens4, state.detune4 };
+		default:
+			return ARMor8OperatorState{ state.frequency1, state.useRatio1, state.wave1, state.attack1, state.attackExpo1,
+							state.decay1, state.decayExpo1, state.sustain1, state.release1,
+							state.releaseExpo1, state.egAmplitudeMod1, state.egFrequencyMod1,
+							state.egFilterMod1, state.op1ModAmount1, state.op2ModAmount1,
+							state.op3ModAmount1, state.op4ModAmount1, state.amplitude1, state.filterFreq1,
+							state.filterRes1, state.ampVelSens1, state.filtVelSens1, state.detune1 };
+	}
+}
@@ -0,0 +1,168 @@
+#include "ARMor8PresetCache.hpp"
+
+#include "ARMor8PresetStorageService.hpp"
+#include "IARMor8PresetStore.hpp"
+
+#include <string.h>
+
+ARMor8PresetCache::ARMor8PresetCache (IARMor8PresetStore* presetStore, IARMor8ExternalMemory* cacheMemory) :
+	m_PresetStore( presetStore ),
+	m_CacheMemory( cacheMemory ),
+	m_StorageService( nullptr ),
+	m_NumPresets( 0 ),
+	m_CurrentPresetNum( 0 ),
+	m_NumLoadedPresets( 0 ),
+	m_DirtyPresets{ 0 }
+{
+}
+
+ARMor8PresetCache::~ARMor8PresetCache()
+{
+}
+
+void ARMor8PresetCache::setPresetStore (IARMor8PresetStore* presetStore)
+{
+	m_PresetStore = presetStore;
+}
+
+void ARMor8PresetCache::load()
+{
+	this->beginLoad();
+	while ( ! this->loadNextPreset() ) {}
+}
+
+void ARMor8PresetCache::beginLoad()
+{
+	m_NumPresets = m_PresetStore->getMaxNumPresets();
+	if ( m_NumPresets > ARMOR8_PRESET_CACHE_MAX_PRESETS )
+	{
+		m_NumPresets = ARMOR8_PRESET_CACHE_MAX_PRESETS;
+	}
+
+	memset( m_DirtyPresets, 0, sizeof(m_DirtyPresets) );
+	m_CurrentPresetNum = 0;
+	m_NumLoadedPresets = 0;
+}
+
+bool ARMor8PresetCache::loadNextPreset()
+{
+	if ( m_NumLoadedPresets >= m_NumPresets )
+	{
+		return true;
+	}
+
+	ARMor8PackedPreset preset = m_PresetStore->retrievePreset( m_NumLoadedPresets );
+	m_CacheMemory->writeBytes( preset.data, sizeof(preset.data), m_NumLoadedPresets * sizeof(preset.data) );
+	m_NumLoadedPresets++;
+
+	return m_NumLoadedPresets >= m_NumPresets;
+}
+
+ARMor8PackedPreset ARMor8PresetCache::retrievePreset (unsigned int presetNum)
+{
+	ARMor8PackedPreset preset;
+
+	if ( presetNum >= m_NumPresets )
+	{
+		memset( preset.data, 0, sizeof(preset.data) );
+		return preset;
+	}
+
+	m_CacheMemory->readBytes( preset.data, sizeof(preset.data), presetNum * sizeof(preset.data) );
+	m_CurrentPresetNum = presetNum;
+
+	return preset;
+}
+
+ARMor8PackedPreset ARMor8PresetCache::prevPreset()
+{
+	if ( m_CurrentPresetNum > 0 )
+	{
+		return this->retrievePreset( m_CurrentPresetNum - 1 );
+	}
+
+	return this->retrievePreset( m_CurrentPresetNum );
+}
+
+ARMor8PackedPreset ARMor8PresetCache::nextPreset()
+{
+	if ( m_CurrentPresetNum + 1 < m_NumPresets )
+	{
+		return this->retrievePreset( m_CurrentPresetNum + 1 );
+	}
+
+	return this->retrievePreset( m_CurrentPresetNum );
+}
+
+void ARMor8PresetCache::writePreset (const ARMor8PackedPreset& preset, unsigned int presetNum)
+{
+	if ( presetNum >= m_NumPresets )
+	{
+		return;
+	}
+
+	m_CacheMemory->writeBytes( preset.data, sizeof(preset.data), presetNum * sizeof(preset.data) );
+	m_DirtyPresets[presetNum / 32] |= ( 1u << (presetNum % 32) );
+}
+
+unsigned int ARMor8PresetCache::getCurrentPresetNum()
+{
+	return m_CurrentPresetNum;
+}
+
+void ARMor8PresetCache::setStorageService (ARMor8PresetStorageService* storageService)
+{
+	m_StorageService = storageService;
+}
+
+bool ARMor8PresetCache::flushDirtyPreset()
+{
+	for ( unsigned int word = 0; word < sizeof(m_DirtyPresets) / sizeof(m_DirtyPresets[0]); word++ )
+	{
+		if ( m_DirtyPresets[word] != 0 )
+		{
+			unsigned int presetNum = ( word * 32 ) + __builtin_ctz( m_DirtyPresets[word] );
+
+			ARMor8PackedPreset preset;
+			m_CacheMemory->readBytes( preset.data, sizeof(preset.data), presetNum * sizeof(preset.data) );
+
+			if ( m_StorageService )
+			{
+				// the preset is copied into the request, so later writes to the cache don't race the write back
+				if ( ! m_StorageService->requestWrite(preset, presetNum, nullptr) )
+				{
+					return false;
+				}
+			}
+			else if ( ! m_PresetStore->writePreset(preset, presetNum) )
+			{
+				// stays dirty, so it's tried again on the next flush
+				return false;
+			}
+
+			m_DirtyPresets[word] &= ~( 1u << (presetNum % 32) );
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void ARMor8PresetCache::flushAllPresets()
+{
+	while ( this->flushDirtyPreset() ) {}
+}
+
+bool ARMor8PresetCache::hasDirtyPresets()
+{
+	for ( unsigned int word = 0; word < sizeof(m_DirtyPresets) / sizeof(m_DirtyPresets[0]); word++ )
+	{
+		if ( m_DirtyPresets[word] != 0 )
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,225 @@
+#include "ARMor8PresetCodec.hpp"
+
+#include "ARMor8Constants.hpp"
+
+#include <cmath>
+#include <string.h>
+
+const unsigned int numOps = 4;
+
+// frequencies and mod amounts can be zero or a ratio below 1, so their log scale reserves code 0 for zero
+const float PACKED_FREQUENCY_MIN = 0.01f;
+
+enum class PACKED_SCALE : unsigned int
+{
+	LINEAR,
+	LOG,         // for ranges where the ratio matters more than the difference, min must be above zero
+	LOG_OR_ZERO  // like LOG, but code 0 is reserved for exactly 0
+};
+
+struct PackedFloatField
+{
+	float ARMor8VoiceState::* member[numOps];
+	PACKED_SCALE scale;
+	unsigned int bits;
+	float        min;
+	float        max;
+};
+
+#define ARMOR8_OP_FIELDS(name) { &ARMor8VoiceState::name##1, &ARMor8VoiceState::name##2, &ARMor8VoiceState::name##3, &ARMor8VoiceState::name##4 }
+
+// the order of these is the order of the packed bitstream, so only ever append to it
+static const PackedFloatField packedOperatorFields[] =
+{
+	{ ARMOR8_OP_FIELDS(frequency),    PACKED_SCALE::LOG_OR_ZERO, 16, PACKED_FREQUENCY_MIN,  ARMOR8_FREQUENCY_MAX },
+	{ ARMOR8_OP_FIELDS(attack),       PACKED_SCALE::LINEAR,      16, 0.0f,                  ARMOR8_ATTACK_MAX },
+	{ ARMOR8_OP_FIELDS(attackExpo),   PACKED_SCALE::LOG,         12, ARMOR8_EXPO_MIN,       ARMOR8_EXPO_MAX },
+	{ ARMOR8_OP_FIELDS(decay),        PACKED_SCALE::LINEAR,      16, ARMOR8_DECAY_MIN,      ARMOR8_DECAY_MAX },
+	{ ARMOR8_OP_FIELDS(decayExpo),    PACKED_SCALE::LOG,         12, ARMOR8_EXPO_MIN,       ARMOR8_EXPO_MAX },
+	{ ARMOR8_OP_FIELDS(sustain),      PACKED_SCALE::LINEAR,      12, ARMOR8_SUSTAIN_MIN,    ARMOR8_SUSTAIN_MAX },
+	{ ARMOR8_OP_FIELDS(release),      PACKED_SCALE::LINEAR,      16, 0.0f,                  ARMOR8_RELEASE_MAX },
+	{ ARMOR8_OP_FIELDS(releaseExpo),  PACKED_SCALE::LOG,         12, ARMOR8_EXPO_MIN,       ARMOR8_EXPO_MAX },
+	{ ARMOR8_OP_FIELDS(op1ModAmount), PACKED_SCALE::LOG_OR_ZERO, 16, PACKED_FREQUENCY_MIN,  ARMOR8_OP_MOD_MAX },
+	{ ARMOR8_OP_FIELDS(op2ModAmount), PACKED_SCALE::LOG_OR_ZERO, 16, PACKED_FREQUENCY_MIN,  ARMOR8_OP_MOD_MAX },
+	{ ARMOR8_OP_FIELDS(op3ModAmount), PACKED_SCALE::LOG_OR_ZERO, 16, PACKED_FREQUENCY_MIN,  ARMOR8_OP_MOD_MAX },
+	{ ARMOR8_OP_FIELDS(op4ModAmount), PACKED_SCALE::LOG_OR_ZERO, 16, PACKED_FREQUENCY_MIN,  ARMOR8_OP_MOD_MAX },
+	{ ARMOR8_OP_FIELDS(amplitude),    PACKED_SCALE::LINEAR,      12, ARMOR8_AMPLITUDE_MIN,  ARMOR8_AMPLITUDE_MAX },
+	{ ARMOR8_OP_FIELDS(filterFreq),   PACKED_SCALE::LOG_OR_ZERO, 16, PACKED_FREQUENCY_MIN,  ARMOR8_FILT_FREQ_MAX },
+	{ ARMOR8_OP_FIELDS(filterRes),    PACKED_SCALE::LINEAR,      12, ARMOR8_FILT_RES_MIN,   ARMOR8_FILT_RES_MAX },
+	{ ARMOR8_OP_FIELDS(ampVelSens),   PACKED_SCALE::LINEAR,       8, ARMOR8_VELOCITY_MIN,   ARMOR8_VELOCITY_MAX },
+	{ ARMOR8_OP_FIELDS(filtVelSens),  PACKED_SCALE::LINEAR,       8, ARMOR8_VELOCITY_MIN,   ARMOR8_VELOCITY_MAX }
+};
+
+static bool ARMor8VoiceState::* const useRatioFields[numOps]        = ARMOR8_OP_FIELDS(useRatio);
+static bool ARMor8VoiceState::* const egAmplitudeModFields[numOps]  = ARMOR8_OP_FIELDS(egAmplitudeMod);
+static bool ARMor8VoiceState::* const egFrequencyModFields[numOps]  = ARMOR8_OP_FIELDS(egFrequencyMod);
+static bool ARMor8VoiceState::* const egFilterModFields[numOps]     = ARMOR8_OP_FIELDS(egFilterMod);
+static OscillatorMode ARMor8VoiceState::* const waveFields[numOps]  = ARMOR8_OP_FIELDS(wave);
+static int ARMor8VoiceState::* const detuneFields[numOps]           = ARMOR8_OP_FIELDS(detune);
+
+#undef ARMOR8_OP_FIELDS
+
+static const unsigned int waveBits = 2;
+static const unsigned int detuneBits = 12;
+static const unsigned int pitchBendBits = 4;
+static const PackedFloatField glideTimeField = { {}, PACKED_SCALE::LINEAR, 12, ARMOR8_GLIDE_TIME_MIN, ARMOR8_GLIDE_TIME_MAX };
+
+// bits are written least significant first, so the layout doesn't depend on the endianness of the host or target
+class PackedBitWriter
+{
+	public:
+		PackedBitWriter (uint8_t* data) : m_Data( data ), m_BitPos( 0 ) {}
+
+		void write (uint32_t value, unsigned int numBits)
+		{
+			for ( unsigned int bit = 0; bit < numBits; bit++ )
+			{
+				if ( (value >> bit) & 1 )
+				{
+					m_Data[m_BitPos / 8] |= static_cast<uint8_t>( 1 << (m_BitPos % 8) );
+				}
+
+				m_BitPos++;
+			}
+		}
+
+	private:
+		uint8_t*     m_Data;
+		unsigned int m_BitPos;
+};
+
+class PackedBitReader
+{
+	public:
+		PackedBitReader (const uint8_t* data) : m_Data( data ), m_BitPos( 0 ) {}
+
+		uint32_t read (unsigned int numBits)
+		{
+			uint32_t value = 0;
+			for ( unsigned int bit = 0; bit < numBits; bit++ )
+			{
+				value |= static_cast<uint32_t>( (m_Data[m_BitPos / 8] >> (m_BitPos % 8)) & 1 ) << bit;
+				m_BitPos++;
+			}
+
+			return value;
+		}
+
+	private:
+		const uint8_t* m_Data;
+		unsigned int   m_BitPos;
+};
+
+static uint32_t quantize (float value, const PackedFloatField& field)
+{
+	const uint32_t maxCode = ( 1u << field.bits ) - 1;
+	float position = 0.0f; // 0 to 1 along the field's range
+	uint32_t minCode = 0;
+
+	switch ( field.scale )
+	{
+		case PACKED_SCALE::LINEAR:
+			position = ( value - field.min ) / ( field.max - field.min );
+			break;
+		case PACKED_SCALE::LOG:
+			position = std::log( std::fmax(value, field.min) / field.min ) / std::log( field.max / field.min );
+			break;
+		case PACKED_SCALE::LOG_OR_ZERO:
+			if ( value <= 0.0f )
+			{
+				return 0;
+			}
+
+			position = std::log( std::fmax(value, field.min) / field.min ) / std::log( field.max / field.min );
+			minCode = 1;
+			break;
+	}
+
+	position = std::fmin( std::fmax(position, 0.0f), 1.0f );
+
+	return minCode + static_cast<uint32_t>( std::round(position * static_cast<float>(maxCode - minCode)) );
+}
+
+static float dequantize (uint32_t code, const PackedFloatField& field)
+{
+	const uint32_t maxCode = ( 1u << field.bits ) - 1;
+
+	switch ( field.scale )
+	{
+		case PACKED_SCALE::LINEAR:
+			return field.min + ( (field.max - field.min) * static_cast<float>(code) / static_cast<float>(maxCode) );
+		case PACKED_SCALE::LOG:
+			return field.min * std::pow( field.max / field.min, static_cast<float>(code) / static_cast<float>(maxCode) );
+		case PACKED_SCALE::LOG_OR_ZERO:
+			if ( code == 0 )
+			{
+				return 0.0f;
+			}
+
+			return field.min * std::pow( field.max / field.min, static_cast<float>(code - 1) / static_cast<float>(maxCode - 1) );
+	}
+
+	return field.min;
+}
+
+ARMor8PackedPreset ARMor8PresetCodec::pack (const ARMor8VoiceState& state)
+{
+	ARMor8PackedPreset packedPreset;
+	memset( packedPreset.data, 0, sizeof(packedPreset.data) );
+
+	PackedBitWriter writer( packedPreset.data );
+
+	for ( unsigned int op = 0; op < numOps; op++ )
+	{
+		writer.write( state.*useRatioFields[op], 1 );
+		writer.write( state.*egAmplitudeModFields[op], 1 );
+		writer.write( state.*egFrequencyModFields[op], 1 );
+		writer.write( state.*egFilterModFields[op], 1 );
+		writer.write( static_cast<uint32_t>(state.*waveFields[op]), waveBits );
+
+		int detune = state.*detuneFields[op];
+		detune = ( detune < ARMOR8_DETUNE_MIN ) ? ARMOR8_DETUNE_MIN : ( detune > ARMOR8_DETUNE_MAX ) ? ARMOR8_DETUNE_MAX : detune;
+		writer.write( static_cast<uint32_t>(detune - ARMOR8_DETUNE_MIN), detuneBits );
+
+		for ( const PackedFloatField& field : packedOperatorFields )
+		{
+			writer.write( quantize(state.*field.member[op], field), field.bits );
+		}
+	}
+
+	writer.write( state.monophonic, 1 );
+	writer.write( state.pitchBendSemitones, pitchBendBits );
+	writer.write( quantize(state.glideTime, glideTimeField), glideTimeField.bits );
+	writer.write( state.glideRetrigger, 1 );
+
+	return packedPreset;
+}
+
+ARMor8VoiceState ARMor8PresetCodec::unpack (const ARMor8PackedPreset& packedPreset)
+{
+	ARMor8VoiceState state;
+
+	PackedBitReader reader( packedPreset.data );
+
+	for ( unsigned int op = 0; op < numOps; op++ )
+	{
+		state.*useRatioFields[op] = reader.read( 1 );
+		state.*egAmplitudeModFields[op] = reader.read( 1 );
+		state.*egFrequencyModFields[op] = reader.read( 1 );
+		state.*egFilterModFields[op] = reader.read( 1 );
+		state.*waveFields[op] = static_cast<OscillatorMode>( reader.read(waveBits) );
+		state.*detuneFields[op] = static_cast<int>( reader.read(detuneBits) ) + ARMOR8_DETUNE_MIN;
+
+		for ( const PackedFloatField& field : packedOperatorFields )
+		{
+			state.*field.member[op] = dequantize( reader.read(field.bits), field );
+		}
+	}
+
+	state.monophonic = reader.read( 1 );
+	state.pitchBendSemitones = reader.read( pitchBendBits );
+	state.glideTime = dequantize( reader.read(glideTimeField.bits), glideTimeField );
+	state.glideRetrigger = reader.read( 1 );
+
+	return state;
+}
@@ -0,0 +1,230 @@
+#include "ARMor8PresetJournal.hpp"
+
+#include <string.h>
+
+// record layout, multi byte fields are little endian so the layout doesn't depend on the host or target
+static const unsigned int RECORD_MAGIC_BYTE    = 0;
+static const unsigned int RECORD_PRESET_BYTE   = 1;
+static const unsigned int RECORD_SEQUENCE_BYTE = 2;
+static const unsigned int RECORD_CRC_BYTE      = 6;
+static const uint8_t      RECORD_MAGIC         = 0xA8; // erased EEPROM reads back as 0xFF
+static const uint8_t      NO_RECORD            = 0xFF;
+
+ARMor8PresetJournal::ARMor8PresetJournal (IARMor8ExternalMemory* media, unsigned int mediaSizeInBytes) :
+	m_Media( media ),
+	m_NumRecords( mediaSizeInBytes / PRESET_JOURNAL_RECORD_STRIDE ),
+	m_NumPresets( 0 ),
+	m_NextSequenceNum( 0 ),
+	m_NextRecord( 0 ),
+	m_MountRecord( 0 ),
+	m_NewestRecord( 0 ),
+	m_FoundRecord( false ),
+	m_IndexSequenceNums{ 0 },
+	m_Index{ 0 },
+	m_RecordPresets{ 0 }
+{
+	if ( m_NumRecords > PRESET_JOURNAL_MAX_RECORDS )
+	{
+		m_NumRecords = PRESET_JOURNAL_MAX_RECORDS;
+	}
+
+	if ( m_NumRecords > PRESET_JOURNAL_SPARE_RECORDS )
+	{
+		const unsigned int numPresets = m_NumRecords - PRESET_JOURNAL_SPARE_RECORDS;
+		m_NumPresets = ( numPresets < ARMOR8_NUM_PRESETS ) ? numPresets : ARMOR8_NUM_PRESETS;
+	}
+
+	memset( m_Index, NO_RECORD, sizeof(m_Index) );
+	memset( m_RecordPresets, NO_RECORD, sizeof(m_RecordPresets) );
+}
+
+ARMor8PresetJournal::~ARMor8PresetJournal()
+{
+}
+
+bool ARMor8PresetJournal::mount()
+{
+	this->beginMount();
+	while ( ! this->mountNextRecord() ) {}
+
+	return m_FoundRecord;
+}
+
+void ARMor8PresetJournal::beginMount()
+{
+	memset( m_Index, NO_RECORD, sizeof(m_Index) );
+	memset( m_RecordPresets, NO_RECORD, sizeof(m_RecordPresets) );
+	memset( m_IndexSequenceNums, 0, sizeof(m_IndexSequenceNums) );
+
+	m_MountRecord = 0;
+	m_NewestRecord = 0;
+	m_FoundRecord = false;
+	m_NextSequenceNum = 0;
+	m_NextRecord = 0;
+}
+
+bool ARMor8PresetJournal::mountNextRecord()
+{
+	if ( m_MountRecord >= m_NumRecords )
+	{
+		return true;
+	}
+
+	const unsigned int recordNum = m_MountRecord;
+	m_MountRecord++;
+
+	unsigned int presetNum = 0;
+	uint32_t sequenceNum = 0;
+	ARMor8PackedPreset preset;
+
+	if ( this->readRecord(recordNum, presetNum, sequenceNum, preset) && presetNum < m_NumPresets )
+	{
+		m_RecordPresets[recordNum] = presetNum;
+
+		if ( m_Index[presetNum] == NO_RECORD || sequenceNum > m_IndexSequenceNums[presetNum] )
+		{
+			m_Index[presetNum] = recordNum;
+			m_IndexSequenceNums[presetNum] = sequenceNum;
+		}
+
+		if ( ! m_FoundRecord || sequenceNum >= m_NextSequenceNum )
+		{
+			m_NextSequenceNum = sequenceNum + 1;
+			m_NewestRecord = recordNum;
+			m_FoundRecord = true;
+		}
+	}
+
+	if ( m_MountRecord < m_NumRecords )
+	{
+		return false;
+	}
+
+	// carry on writing right after the newest record, so the wear keeps going round the media
+	m_NextRecord = ( m_FoundRecord ) ? ( m_NewestRecord + 1 ) % m_NumRecords : 0;
+
+	return true;
+}
+
+ARMor8PackedPreset ARMor8PresetJournal::retrievePreset (unsigned int presetNum)
+{
+	ARMor8PackedPreset preset;
+	unsigned int recordPresetNum = 0;
+	uint32_t sequenceNum = 0;
+
+	if ( ! this->hasPreset(presetNum)
+			|| ! this->readRecord(m_Index[presetNum], recordPresetNum, sequenceNum, preset)
+			|| recordPresetNum != presetNum )
+	{
+		memset( preset.data, 0, sizeof(preset.data) );
+	}
+
+	return preset;
+}
+
+bool ARMor8PresetJournal::writePreset (const ARMor8PackedPreset& preset, unsigned int presetNum)
+{
+	if ( presetNum >= m_NumPresets )
+	{
+		return false;
+	}
+
+	// there are always spare records on top of the presets, so this always finds one
+	unsigned int recordNum = m_NextRecord;
+	while ( this->isLive(recordNum) )
+	{
+		recordNum = ( recordNum + 1 ) % m_NumRecords;
+	}
+
+	uint8_t record[PRESET_JOURNAL_RECORD_SIZE];
+	record[RECORD_MAGIC_BYTE] = RECORD_MAGIC;
+	record[RECORD_PRESET_BYTE] = static_cast<uint8_t>( presetNum );
+	for ( unsigned int byte = 0; byte < 4; byte++ )
+	{
+		record[RECORD_SEQUENCE_BYTE + byte] = static_cast<uint8_t>( m_NextSequenceNum >> (byte * 8) );
+	}
+	memcpy( &record[PRESET_JOURNAL_HEADER_SIZE], preset.data, sizeof(preset.data) );
+
+	uint16_t crc = crc16( record, RECORD_CRC_BYTE, 0xFFFF );
+	crc = crc16( &record[PRESET_JOURNAL_HEADER_SIZE], ARMOR8_PACKED_PRESET_SIZE, crc );
+	record[RECORD_CRC_BYTE] = static_cast<uint8_t>( crc );
+	record[RECORD_CRC_BYTE + 1] = static_cast<uint8_t>( crc >> 8 );
+
+	const bool written = m_Media->writeBytes( record, sizeof(record), recordNum * PRESET_JOURNAL_RECORD_STRIDE );
+
+	// the sequence number and record are used up either way, a failed write might still have made it to the media whole
+	m_NextSequenceNum++;
+	m_NextRecord = ( recordNum + 1 ) % m_NumRecords;
+
+	if ( ! written )
+	{
+		return false;
+	}
+
+	// the previous copy is only let go of once the new one is written
+	m_RecordPresets[recordNum] = presetNum;
+	m_Index[presetNum] = recordNum;
+
+	return true;
+}
+
+unsigned int ARMor8PresetJournal::getMaxNumPresets()
+{
+	return m_NumPresets;
+}
+
+bool ARMor8PresetJournal::hasPreset (unsigned int presetNum)
+{
+	return presetNum < m_NumPresets && m_Index[presetNum] != NO_RECORD;
+}
+
+bool ARMor8PresetJournal::isLive (unsigned int recordNum)
+{
+	uint8_t presetNum = m_RecordPresets[recordNum];
+
+	return presetNum != NO_RECORD && m_Index[presetNum] == recordNum;
+}
+
+bool ARMor8PresetJournal::readRecord (unsigned int recordNum, unsigned int& presetNum, uint32_t& sequenceNum,
+					ARMor8PackedPreset& preset)
+{
+	uint8_t record[PRESET_JOURNAL_RECORD_SIZE];
+	if ( ! m_Media->readBytes(record, sizeof(record), recordNum * PRESET_JOURNAL_RECORD_STRIDE)
+			|| record[RECORD_MAGIC_BYTE] != RECORD_MAGIC )
+	{
+		return false;
+	}
+
+	uint16_t crc = crc16( record, RECORD_CRC_BYTE, 0xFFFF );
+	crc = crc16( &record[PRESET_JOURNAL_HEADER_SIZE], ARMOR8_PACKED_PRESET_SIZE, crc );
+	if ( record[RECORD_CRC_BYTE] != static_cast<uint8_t>(crc) || record[RECORD_CRC_BYTE + 1] != static_cast<uint8_t>(crc >> 8) )
+	{
+		return false;
+	}
+
+	presetNum = record[RECORD_PRESET_BYTE];
+	sequenceNum = 0;
+	for ( unsigned int byte = 0; byte < 4; byte++ )
+	{
+		sequenceNum |= static_cast<uint32_t>( record[RECORD_SEQUENCE_BYTE + byte] ) << ( byte * 8 );
+	}
+	memcpy( preset.data, &record[PRESET_JOURNAL_HEADER_SIZE], sizeof(preset.data) );
+
+	return true;
+}
+
+// crc-16-ccitt (polynomial 0x1021)
+uint16_t ARMor8PresetJournal::crc16 (const uint8_t* data, unsigned int sizeInBytes, uint16_t crc)
+{
+	for ( unsigned int byte = 0; byte < sizeInBytes; byte++ )
+	{
+		crc ^= static_cast<uint16_t>( data[byte] ) << 8;
+
+		for ( unsigned int bit = 0; bit < 8; bit++ )
+		{
+			crc = ( crc & 0x8000 ) ? static_cast<uint16_t>( (crc << 1) ^ 0x1021 ) : static_cast<uint16_t>( crc << 1 );
+		}
+	}
+
+	return crc;
+}
@@ -0,0 +1,30 @@
+#include "ARMor8PresetManagerStore.hpp"
+
+#include "PresetManager.hpp"
+
+ARMor8PresetManagerStore::ARMor8PresetManagerStore (PresetManager* presetManager) :
+	m_PresetManager( presetManager )
+{
+}
+
+ARMor8PresetManagerStore::~ARMor8PresetManagerStore()
+{
+}
+
+ARMor8PackedPreset ARMor8PresetManagerStore::retrievePreset (unsigned int presetNum)
+{
+	return m_PresetManager->retrievePreset<ARMor8PackedPreset>( presetNum );
+}
+
+bool ARMor8PresetManagerStore::writePreset (const ARMor8PackedPreset& preset, unsigned int presetNum)
+{
+	// the PresetManager doesn't report storage errors
+	m_PresetManager->writePreset<ARMor8PackedPreset>( preset, presetNum );
+
+	return true;
+}
+
+unsigned int ARMor8PresetManagerStore::getMaxNumPresets()
+{
+	return m_PresetManager->getMaxNumPresets();
+}
@@ -0,0 +1,158 @@
+#include "ARMor8PresetSchema.hpp"
+
+#include <string.h>
+
+static_assert( sizeof(int) == sizeof(float) && sizeof(unsigned int) == sizeof(float) && sizeof(OscillatorMode) == sizeof(float),
+		"all preset field types other than bool are expected to be the same size" );
+
+static const ARMor8PresetField voiceStateOperatorFields[] =
+{
+	ARMOR8_PRESET_ORIGINAL_OP_FIELDS(ARMor8VoiceState),
+	ARMOR8_PRESET_OP_FIELD(ARMor8VoiceState, detune, DETUNE, INT, 0.0f)
+};
+
+static const ARMor8PresetField voiceStateGlobalFields[] =
+{
+	ARMOR8_PRESET_GLOBAL_FIELD(ARMor8VoiceState, monophonic,         MONOPHONIC,           BOOL,         0.0f),
+	ARMOR8_PRESET_GLOBAL_FIELD(ARMor8VoiceState, pitchBendSemitones, PITCH_BEND_SEMITONES, UNSIGNED_INT, 1.0f),
+	ARMOR8_PRESET_GLOBAL_FIELD(ARMor8VoiceState, glideTime,          GLIDE_TIME,           FLOAT,        0.0f),
+	ARMOR8_PRESET_GLOBAL_FIELD(ARMor8VoiceState, glideRetrigger,     GLIDE_RETRIGGER,      BOOL,         0.0f)
+};
+
+const ARMor8PresetSchema ARMor8VoiceStateSchema =
+{
+	voiceStateOperatorFields,
+	sizeof(voiceStateOperatorFields) / sizeof(ARMor8PresetField),
+	ARMOR8_PRESET_OP_OFFSETS(ARMor8VoiceState),
+	voiceStateGlobalFields,
+	sizeof(voiceStateGlobalFields) / sizeof(ARMor8PresetField)
+};
+
+void ARMor8PresetMigrator::migrate (const ARMor8PresetSchema& oldSchema, const void* oldPreset,
+					const ARMor8PresetSchema& newSchema, void* newPreset)
+{
+	const uint8_t* oldBytes = static_cast<const uint8_t*>( oldPreset );
+	uint8_t* newBytes = static_cast<uint8_t*>( newPreset );
+
+	for ( unsigned int op = 0; op < ARMOR8_PRESET_SCHEMA_NUM_OPS; op++ )
+	{
+		migrateFields( oldSchema.operatorFields, oldSchema.numOperatorFields, oldBytes + oldSchema.operatorOffsets[op],
+				newSchema.operatorFields, newSchema.numOperatorFields, newBytes + newSchema.operatorOffsets[op] );
+	}
+
+	migrateFields( oldSchema.globalFields, oldSchema.numGlobalFields, oldBytes,
+			newSchema.globalFields, newSchema.numGlobalFields, newBytes );
+}
+
+void ARMor8PresetMigrator::migrateFields (const ARMor8PresetField* oldFields, unsigned int numOldFields, const uint8_t* oldBase,
+						const ARMor8PresetField* newFields, unsigned int numNewFields, uint8_t* newBase)
+{
+	for ( unsigned int newField = 0; newField < numNewFields; newField++ )
+	{
+		const ARMor8PresetField& field = newFields[newField];
+
+		const ARMor8PresetField* oldField = nullptr;
+		for ( unsigned int fieldNum = 0; fieldNum < numOldFields; fieldNum++ )
+		{
+			if ( oldFields[fieldNum].id == field.id )
+			{
+				oldField = &oldFields[fieldNum];
+				break;
+			}
+		}
+
+		if ( oldField == nullptr )
+		{
+			writeField( field, newBase, field.defaultValue );
+		}
+		else if ( oldField->type == field.type )
+		{
+			// all of the types are 4 bytes except bool, and this keeps floats bit exact
+			size_t size = ( field.type == PRESET_FIELD_TYPE::BOOL ) ? sizeof(bool) : sizeof(float);
+			memcpy( newBase + field.offset, oldBase + oldField->offset, size );
+		}
+		else
+		{
+			writeField( field, newBase, readField(*oldField, oldBase) );
+		}
+	}
+}
+
+float ARMor8PresetMigrator::readField (const ARMor8PresetField& field, const uint8_t* base)
+{
+	const uint8_t* address = base + field.offset;
+
+	switch ( field.type )
+	{
+		case PRESET_FIELD_TYPE::FLOAT:
+		{
+			float value;
+			memcpy( &value, address, sizeof(value) );
+			return value;
+		}
+		case PRESET_FIELD_TYPE::BOOL:
+		{
+			bool value;
+			memcpy( &value, address, sizeof(value) );
+			return ( value ) ? 1.0f : 0.0f;
+		}
+		case PRESET_FIELD_TYPE::INT:
+		{
+			int value;
+			memcpy( &value, address, sizeof(value) );
+			return static_cast<float>( value );
+		}
+		case PRESET_FIELD_TYPE::UNSIGNED_INT:
+		{
+			unsigned int value;
+			memcpy( &value, address, sizeof(value) );
+			return static_cast<float>( value );
+		}
+		case PRESET_FIELD_TYPE::OSCILLATOR_MODE:
+		{
+			OscillatorMode value;
+			memcpy( &value, address, sizeof(value) );
+			return static_cast<float>( static_cast<unsigned int>(value) );
+		}
+	}
+
+	return 0.0f;
+}
+
+void ARMor8PresetMigrator::writeField (const ARMor8PresetField& field, uint8_t* base, float value)
+{
+	uint8_t* address = base + field.offset;
+
+	switch ( field.type )
+	{
+		case PRESET_FIELD_TYPE::FLOAT:
+		{
+			memcpy( address, &value, sizeof(value) );
+			break;
+		}
+		case PRESET_FIELD_TYPE::BOOL:
+		{
+			bool newValue = ( value != 0.0f );
+			memcpy( address, &newValue, sizeof(newValue) );
+			break;
+		}
+		case PRESET_FIELD_TYPE::INT:
+		{
+			int newValue = static_cast<int>( value );
+			memcpy( address, &newValue, sizeof(newValue) );
+			break;
+		}
+		case PRESET_FIELD_TYPE::UNSIGNED_INT:
+		{
+			unsigned int newValue = static_cast<unsigned int>( value );
+			memcpy( address, &newValue, sizeof(newValue) );
+			break;
+		}
+		case PRESET_FIELD_TYPE::OSCILLATOR_MODE:
+		{
+			OscillatorMode newValue = static_cast<OscillatorMode>( static_cast<unsigned int>(value) );
+			memcpy( address, &newValue, sizeof(newValue) );
+			break;
+		}
+	}
+}
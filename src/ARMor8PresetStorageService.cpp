@@ -0,0 +1,89 @@
+#include "ARMor8PresetStorageService.hpp"
+
+#include "IARMor8PresetStore.hpp"
+
+ARMor8PresetStorageService::ARMor8PresetStorageService (IARMor8PresetStore* presetStore) :
+	m_PresetStore( presetStore ),
+	m_Queue(),
+	m_WriteIndex( 0 ),
+	m_ReadIndex( 0 )
+{
+}
+
+ARMor8PresetStorageService::~ARMor8PresetStorageService()
+{
+}
+
+void ARMor8PresetStorageService::setPresetStore (IARMor8PresetStore* presetStore)
+{
+	m_PresetStore = presetStore;
+}
+
+bool ARMor8PresetStorageService::requestWrite (const ARMor8PackedPreset& preset, unsigned int presetNum, IPresetStorageCallback* callback)
+{
+	ARMor8PresetStorageRequest request = { PRESET_STORAGE_OP::WRITE, presetNum, preset, callback, false };
+
+	return this->pushRequest( request );
+}
+
+bool ARMor8PresetStorageService::requestRead (unsigned int presetNum, IPresetStorageCallback* callback)
+{
+	ARMor8PresetStorageRequest request = { PRESET_STORAGE_OP::READ, presetNum, ARMor8PackedPreset(), callback, false };
+
+	return this->pushRequest( request );
+}
+
+bool ARMor8PresetStorageService::processNextRequest()
+{
+	unsigned int readIndex = m_ReadIndex.load( std::memory_order_relaxed );
+	if ( readIndex == m_WriteIndex.load(std::memory_order_acquire) )
+	{
+		return false;
+	}
+
+	ARMor8PresetStorageRequest& request = m_Queue[readIndex % PRESET_STORAGE_QUEUE_SIZE];
+
+	if ( request.op == PRESET_STORAGE_OP::WRITE )
+	{
+		request.succeeded = m_PresetStore->writePreset( request.preset, request.presetNum );
+	}
+	else
+	{
+		request.preset = m_PresetStore->retrievePreset( request.presetNum );
+		request.succeeded = true;
+	}
+
+	if ( request.callback )
+	{
+		request.callback->onPresetStorageComplete( request );
+	}
+
+	// the slot is only handed back after the callback, so the request stays valid while the callback runs
+	m_ReadIndex.store( readIndex + 1, std::memory_order_release );
+
+	return true;
+}
+
+void ARMor8PresetStorageService::processAllRequests()
+{
+	while ( this->processNextRequest() ) {}
+}
+
+bool ARMor8PresetStorageService::hasPendingRequests()
+{
+	return m_ReadIndex.load( std::memory_order_acquire ) != m_WriteIndex.load( std::memory_order_acquire );
+}
+
+bool ARMor8PresetStorageService::pushRequest (const ARMor8PresetStorageRequest& request)
+{
+	unsigned int writeIndex = m_WriteIndex.load( std::memory_order_relaxed );
+	if ( writeIndex - m_ReadIndex.load(std::memory_order_acquire) >= PRESET_STORAGE_QUEUE_SIZE )
+	{
+		return false;
+	}
+
+	m_Queue[writeIndex % PRESET_STORAGE_QUEUE_SIZE] = request;
+	m_WriteIndex.store( writeIndex + 1, std::memory_order_release );
+
+	return true;
+}
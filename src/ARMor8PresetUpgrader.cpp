@@ -1,5 +1,8 @@
 #include "ARMor8PresetUpgrader.hpp"
 
+#include "ARMor8PresetCodec.hpp"
+#include "ARMor8PresetSchema.hpp"
+
 struct ARMor8VoiceState_VERSION_0_1_0
 {
 	// operator 1
@@ -313,6 +316,66 @@ struct ARMor8VoiceState_VERSION_1_1_0
 	bool         glideRetrigger;
 };
 
+// schemas for each version, so old presets can be migrated straight to the current ARMor8VoiceState
+static const ARMor8PresetField version0_1_0OperatorFields[] =
+{
+	ARMOR8_PRESET_ORIGINAL_OP_FIELDS(ARMor8VoiceState_VERSION_0_1_0)
+};
+
+static const ARMor8PresetSchema version0_1_0Schema =
+{
+	version0_1_0OperatorFields,
+	sizeof(version0_1_0OperatorFields) / sizeof(ARMor8PresetField),
+	ARMOR8_PRESET_OP_OFFSETS(ARMor8VoiceState_VERSION_0_1_0),
+	nullptr,
+	0
+};
+
+static const ARMor8PresetField version1_0_0OperatorFields[] =
+{
+	ARMOR8_PRESET_ORIGINAL_OP_FIELDS(ARMor8VoiceState_VERSION_1_0_0)
+};
+
+static const ARMor8PresetField version1_0_0GlobalFields[] =
+{
+	ARMOR8_PRESET_GLOBAL_FIELD(ARMor8VoiceState_VERSION_1_0_0, monophonic,         MONOPHONIC,           BOOL,         0.0f),
+	ARMOR8_PRESET_GLOBAL_FIELD(ARMor8VoiceState_VERSION_1_0_0, pitchBendSemitones, PITCH_BEND_SEMITONES, UNSIGNED_INT, 0.0f),
+	ARMOR8_PRESET_GLOBAL_FIELD(ARMor8VoiceState_VERSION_1_0_0, glideTime,          GLIDE_TIME,           FLOAT,        0.0f),
+	ARMOR8_PRESET_GLOBAL_FIELD(ARMor8VoiceState_VERSION_1_0_0, glideRetrigger,     GLIDE_RETRIGGER,      BOOL,         0.0f)
+};
+
+static const ARMor8PresetSchema version1_0_0Schema =
+{
+	version1_0_0OperatorFields,
+	sizeof(version1_0_0OperatorFields) / sizeof(ARMor8PresetField),
+	ARMOR8_PRESET_OP_OFFSETS(ARMor8VoiceState_VERSION_1_0_0),
+	version1_0_0GlobalFields,
+	sizeof(version1_0_0GlobalFields) / sizeof(ARMor8PresetField)
+};
+
+static const ARMor8PresetField version1_1_0OperatorFields[] =
+{
+	ARMOR8_PRESET_ORIGINAL_OP_FIELDS(ARMor8VoiceState_VERSION_1_1_0),
+	ARMOR8_PRESET_OP_FIELD(ARMor8VoiceState_VERSION_1_1_0, detune, DETUNE, INT, 0.0f)
+};
+
+static const ARMor8PresetField version1_1_0GlobalFields[] =
+{
+	ARMOR8_PRESET_GLOBAL_FIELD(ARMor8VoiceState_VERSION_1_1_0, monophonic,         MONOPHONIC,           BOOL,         0.0f),
+	ARMOR8_PRESET_GLOBAL_FIELD(ARMor8VoiceState_VERSION_1_1_0, pitchBendSemitones, PITCH_BEND_SEMITONES, UNSIGNED_INT, 0.0f),
+	ARMOR8_PRESET_GLOBAL_FIELD(ARMor8VoiceState_VERSION_1_1_0, glideTime,          GLIDE_TIME,           FLOAT,        0.0f),
+	ARMOR8_PRESET_GLOBAL_FIELD(ARMor8VoiceState_VERSION_1_1_0, glideRetrigger,     GLIDE_RETRIGGER,      BOOL,         0.0f)
+};
+
+static const ARMor8PresetSchema version1_1_0Schema =
+{
+	version1_1_0OperatorFields,
+	sizeof(version1_1_0OperatorFields) / sizeof(ARMor8PresetField),
+	ARMOR8_PRESET_OP_OFFSETS(ARMor8VoiceState_VERSION_1_1_0),
+	version1_1_0GlobalFields,
+	sizeof(version1_1_0GlobalFields) / sizeof(ARMor8PresetField)
+};
+
 ARMor8PresetUpgrader::ARMor8PresetUpgrader (const ARMor8VoiceState& initPreset, const ARMor8PresetHeader& currentPresetHeader) :
 	m_InitPreset( initPreset ),
 	m_CurrentPresetHeader( currentPresetHeader )
@@ -330,9 +393,10 @@ void ARMor8PresetUpgrader::upgradePresets()
 	{
 		m_PresetManager->writeHeader<ARMor8PresetHeader>( m_CurrentPresetHeader );
 
+		ARMor8PackedPreset packedInitPreset = ARMor8PresetCodec::pack( m_InitPreset );
 		for (unsigned int presetNum = 0; presetNum < m_PresetManager->getMaxNumPresets(); presetNum++)
 		{
-			m_PresetManager->writePreset<ARMor8VoiceState>( m_InitPreset, presetNum );
+			m_PresetManager->writePreset<ARMor8PackedPreset>( packedInitPreset, presetNum );
 		}
 	}
 	else
@@ -344,12 +408,13 @@ void ARMor8PresetUpgrader::upgradePresets()
 		{
 			m_PresetManager->writeHeader<ARMor8PresetHeader>( m_CurrentPresetHeader );
 
+			ARMor8PackedPreset packedInitPreset = ARMor8PresetCodec::pack( m_InitPreset );
 			for (unsigned int presetNum = 0; presetNum < m_PresetManager->getMaxNumPresets(); presetNum++)
 			{
-				m_PresetManager->writePreset<ARMor8VoiceState>( m_InitPreset, presetNum );
+				m_PresetManager->writePreset<ARMor8PackedPreset>( packedInitPreset, presetNum );
 			}
 		}
-		// if the versions don't match, we need to upgrade
+		// if the versions don't match, we need to upgrade, every older version goes straight to the current one
 		else if (       presetHeaderFromFile.versionMajor != m_CurrentPresetHeader.versionMajor ||
 				presetHeaderFromFile.versionMinor != m_CurrentPresetHeader.versionMinor ||
 				presetHeaderFromFile.versionPatch != m_CurrentPresetHeader.versionPatch )
@@ -358,275 +423,90 @@ void ARMor8PresetUpgrader::upgradePresets()
 					presetHeaderFromFile.versionMinor == 1 &&
 					presetHeaderFromFile.versionPatch == 0 )
 			{
-				this->upgradeFrom0_1_0To1_0_0();
-				this->upgradePresets();
+				this->upgradeFromUnpacked<ARMor8VoiceState_VERSION_0_1_0>( version0_1_0Schema );
 			}
 			else if (
 					presetHeaderFromFile.versionMajor == 1 &&
 					presetHeaderFromFile.versionMinor == 0 &&
 					presetHeaderFromFile.versionPatch == 0 )
 			{
-				this->upgradeFrom1_0_0To1_1_0();
-				this->upgradePresets();
+				this->upgradeFromUnpacked<ARMor8VoiceState_VERSION_1_0_0>( version1_0_0Schema );
+			}
+			else if (
+					presetHeaderFromFile.versionMajor == 1 &&
+					presetHeaderFromFile.versionMinor == 1 &&
+					presetHeaderFromFile.versionPatch == 0 )
+			{
+				this->upgradeFromUnpacked<ARMor8VoiceState_VERSION_1_1_0>( version1_1_0Schema );
 			}
 		}
 	}
 }
 
-void ARMor8PresetUpgrader::upgradeFrom0_1_0To1_0_0()
+template <typename OldPreset>
+void ARMor8PresetUpgrader::upgradeFromUnpacked (const ARMor8PresetSchema& oldSchema)
 {
-	// write header
-	ARMor8PresetHeader presetHeader = { 1, 0, 0, true };
-	m_PresetManager->writeHeader<ARMor8PresetHeader>( presetHeader );
+	// the scratch preset is the last packed preset, which is past the end of the old presets
+	this->streamPresets<OldPreset>( oldSchema, ARMOR8_LEGACY_NUM_PRESETS, m_PresetManager->getMaxNumPresets() - 1 );
 
-	// TODO this takes up a lottttt of memory, figure out a good way to manage this memory
-	// store all old presets in an array
-	ARMor8VoiceState_VERSION_0_1_0 oldPresets[m_PresetManager->getMaxNumPresets()];
-
-	for (unsigned int presetNum = 0; presetNum < m_PresetManager->getMaxNumPresets(); presetNum++)
+	// the rest of the presets didn't exist before, so they start as the init preset
+	ARMor8PackedPreset packedInitPreset = ARMor8PresetCodec::pack( m_InitPreset );
+	for (unsigned int presetNum = ARMOR8_LEGACY_NUM_PRESETS; presetNum < m_PresetManager->getMaxNumPresets(); presetNum++)
 	{
-		oldPresets[presetNum] = m_PresetManager->retrievePreset<ARMor8VoiceState_VERSION_0_1_0>( presetNum );
+		m_PresetManager->writePreset<ARMor8PackedPreset>( packedInitPreset, presetNum );
 	}
 
-	// write new presets with default values for monophonic, glide time, glide retrigger, and pitch bend semitones
-	for (unsigned int presetNum = 0; presetNum < m_PresetManager->getMaxNumPresets(); presetNum++)
-	{
-		ARMor8VoiceState_VERSION_1_0_0 newPreset =
-		{
-			// operator 1
-			oldPresets[presetNum].frequency1,
-			oldPresets[presetNum].useRatio1,
-			oldPresets[presetNum].wave1,
-			oldPresets[presetNum].attack1,
-			oldPresets[presetNum].attackExpo1,
-			oldPresets[presetNum].decay1,
-			oldPresets[presetNum].decayExpo1,
-			oldPresets[presetNum].sustain1,
-			oldPresets[presetNum].release1,
-			oldPresets[presetNum].releaseExpo1,
-			oldPresets[presetNum].egAmplitudeMod1,
-			oldPresets[presetNum].egFrequencyMod1,
-			oldPresets[presetNum].egFilterMod1,
-			oldPresets[presetNum].op1ModAmount1,
-			oldPresets[presetNum].op2ModAmount1,
-			oldPresets[presetNum].op3ModAmount1,
-			oldPresets[presetNum].op4ModAmount1,
-			oldPresets[presetNum].amplitude1,
-			oldPresets[presetNum].filterFreq1,
-			oldPresets[presetNum].filterRes1,
-			oldPresets[presetNum].ampVelSens1,
-			oldPresets[presetNum].filtVelSens1,
-
-			// operator 2
-			oldPresets[presetNum].frequency2,
-			oldPresets[presetNum].useRatio2,
-			oldPresets[presetNum].wave2,
-			oldPresets[presetNum].attack2,
-			oldPresets[presetNum].attackExpo2,
-			oldPresets[presetNum].decay2,
-			oldPresets[presetNum].decayExpo2,
-			oldPresets[presetNum].sustain2,
-			oldPresets[presetNum].release2,
-			oldPresets[presetNum].releaseExpo2,
-			oldPresets[presetNum].egAmplitudeMod2,
-			oldPresets[presetNum].egFrequencyMod2,
-			oldPresets[presetNum].egFilterMod2,
-			oldPresets[presetNum].op1ModAmount2,
-			oldPresets[presetNum].op2ModAmount2,
-			oldPresets[presetNum].op3ModAmount2,
-			oldPresets[presetNum].op4ModAmount2,
-			oldPresets[presetNum].amplitude2,
-			oldPresets[presetNum].filterFreq2,
-			oldPresets[presetNum].filterRes2,
-			oldPresets[presetNum].ampVelSens2,
-			oldPresets[presetNum].filtVelSens2,
-
-			// operator 3
-			oldPresets[presetNum].frequency3,
-			oldPresets[presetNum].useRatio3,
-			oldPresets[presetNum].wave3,
-			oldPresets[presetNum].attack3,
-			oldPresets[presetNum].attackExpo3,
-			oldPresets[presetNum].decay3,
-			oldPresets[presetNum].decayExpo3,
-			oldPresets[presetNum].sustain3,
-			oldPresets[presetNum].release3,
-			oldPresets[presetNum].releaseExpo3,
-			oldPresets[presetNum].egAmplitudeMod3,
-			oldPresets[presetNum].egFrequencyMod3,
-			oldPresets[presetNum].egFilterMod3,
-			oldPresets[presetNum].op1ModAmount3,
-			oldPresets[presetNum].op2ModAmount3,
-			oldPresets[presetNum].op3ModAmount3,
-			oldPresets[presetNum].op4ModAmount3,
-			oldPresets[presetNum].amplitude3,
-			oldPresets[presetNum].filterFreq3,
-			oldPresets[presetNum].filterRes3,
-			oldPresets[presetNum].ampVelSens3,
-			oldPresets[presetNum].filtVelSens3,
-
-			// operator 4
-			oldPresets[presetNum].frequency4,
-			oldPresets[presetNum].useRatio4,
-			oldPresets[presetNum].wave4,
-			oldPresets[presetNum].attack4,
-			oldPresets[presetNum].attackExpo4,
-			oldPresets[presetNum].decay4,
-			oldPresets[presetNum].decayExpo4,
-			oldPresets[presetNum].sustain4,
-			oldPresets[presetNum].release4,
-			oldPresets[presetNum].releaseExpo4,
-			oldPresets[presetNum].egAmplitudeMod4,
-			oldPresets[presetNum].egFrequencyMod4,
-			oldPresets[presetNum].egFilterMod4,
-			oldPresets[presetNum].op1ModAmount4,
-			oldPresets[presetNum].op2ModAmount4,
-			oldPresets[presetNum].op3ModAmount4,
-			oldPresets[presetNum].op4ModAmount4,
-			oldPresets[presetNum].amplitude4,
-			oldPresets[presetNum].filterFreq4,
-			oldPresets[presetNum].filterRes4,
-			oldPresets[presetNum].ampVelSens4,
-			oldPresets[presetNum].filtVelSens4,
-
-			// global
-			false,
-			1,
-			0.0f,
-			false
-		};
-
-		m_PresetManager->writePreset<ARMor8VoiceState_VERSION_1_0_0>( newPreset, presetNum );
-	}
+	// write header
+	m_PresetManager->writeHeader<ARMor8PresetHeader>( m_CurrentPresetHeader );
 }
 
-void ARMor8PresetUpgrader::upgradeFrom1_0_0To1_1_0()
+template <typename OldPreset>
+void ARMor8PresetUpgrader::streamPresets (const ARMor8PresetSchema& oldSchema, unsigned int numPresets, unsigned int scratchPresetNum)
 {
-	// write header
-	ARMor8PresetHeader presetHeader = { 1, 1, 0, true };
-	m_PresetManager->writeHeader<ARMor8PresetHeader>( presetHeader );
+	// presets are converted from the first one up, which only works if they shrink, otherwise writing a converted preset
+	// would clobber the start of an old preset that hasn't been read yet
+	static_assert( sizeof(ARMor8PackedPreset) <= sizeof(OldPreset), "converting presets in place needs them to shrink" );
 
-	// TODO this takes up a lottttt of memory, figure out a good way to manage this memory
-	// store all old presets in an array
-	ARMor8VoiceState_VERSION_1_0_0 oldPresets[m_PresetManager->getMaxNumPresets()];
-
-	for (unsigned int presetNum = 0; presetNum < m_PresetManager->getMaxNumPresets(); presetNum++)
+	ARMor8PresetHeader progressHeader = m_PresetManager->retrieveHeader<ARMor8PresetHeader>();
+	if ( (progressHeader.upgradeState == PRESET_UPGRADE_CONVERTING || progressHeader.upgradeState == PRESET_UPGRADE_SCRATCH_WRITTEN)
+			&& progressHeader.upgradeNumConverted <= numPresets )
+	{
+		// resuming an upgrade that was interrupted (by a power loss for example)
+	}
+	else
 	{
-		oldPresets[presetNum] = m_PresetManager->retrievePreset<ARMor8VoiceState_VERSION_1_0_0>( presetNum );
+		progressHeader.upgradeState = PRESET_UPGRADE_CONVERTING;
+		progressHeader.upgradeNumConverted = 0;
 	}
 
-	// write new presets with default values for detune
-	for (unsigned int presetNum = 0; presetNum < m_PresetManager->getMaxNumPresets(); presetNum++)
+	while ( progressHeader.upgradeNumConverted < numPresets )
 	{
-		ARMor8VoiceState_VERSION_1_1_0 newPreset =
+		unsigned int presetNum = progressHeader.upgradeNumConverted;
+		ARMor8PackedPreset newPreset;
+
+		if ( progressHeader.upgradeState == PRESET_UPGRADE_SCRATCH_WRITTEN )
+		{
+			// the old preset may already be partially overwritten, but the scratch copy of the converted one is whole
+			newPreset = m_PresetManager->retrievePreset<ARMor8PackedPreset>( scratchPresetNum );
+		}
+		else
 		{
-			// operator 1
-			oldPresets[presetNum].frequency1,
-			oldPresets[presetNum].useRatio1,
-			oldPresets[presetNum].wave1,
-			oldPresets[presetNum].attack1,
-			oldPresets[presetNum].attackExpo1,
-			oldPresets[presetNum].decay1,
-			oldPresets[presetNum].decayExpo1,
-			oldPresets[presetNum].sustain1,
-			oldPresets[presetNum].release1,
-			oldPresets[presetNum].releaseExpo1,
-			oldPresets[presetNum].egAmplitudeMod1,
-			oldPresets[presetNum].egFrequencyMod1,
-			oldPresets[presetNum].egFilterMod1,
-			oldPresets[presetNum].op1ModAmount1,
-			oldPresets[presetNum].op2ModAmount1,
-			oldPresets[presetNum].op3ModAmount1,
-			oldPresets[presetNum].op4ModAmount1,
-			oldPresets[presetNum].amplitude1,
-			oldPresets[presetNum].filterFreq1,
-			oldPresets[presetNum].filterRes1,
-			oldPresets[presetNum].ampVelSens1,
-			oldPresets[presetNum].filtVelSens1,
-			0,
-
-			// operator 2
-			oldPresets[presetNum].frequency2,
-			oldPresets[presetNum].useRatio2,
-			oldPresets[presetNum].wave2,
-			oldPresets[presetNum].attack2,
-			oldPresets[presetNum].attackExpo2,
-			oldPresets[presetNum].decay2,
-			oldPresets[presetNum].decayExpo2,
-			oldPresets[presetNum].sustain2,
-			oldPresets[presetNum].release2,
-			oldPresets[presetNum].releaseExpo2,
-			oldPresets[presetNum].egAmplitudeMod2,
-			oldPresets[presetNum].egFrequencyMod2,
-			oldPresets[presetNum].egFilterMod2,
-			oldPresets[presetNum].op1ModAmount2,
-			oldPresets[presetNum].op2ModAmount2,
-			oldPresets[presetNum].op3ModAmount2,
-			oldPresets[presetNum].op4ModAmount2,
-			oldPresets[presetNum].amplitude2,
-			oldPresets[presetNum].filterFreq2,
-			oldPresets[presetNum].filterRes2,
-			oldPresets[presetNum].ampVelSens2,
-			oldPresets[presetNum].filtVelSens2,
-			0,
-
-			// operator 3
-			oldPresets[presetNum].frequency3,
-			oldPresets[presetNum].useRatio3,
-			oldPresets[presetNum].wave3,
-			oldPresets[presetNum].attack3,
-			oldPresets[presetNum].attackExpo3,
-			oldPresets[presetNum].decay3,
-			oldPresets[presetNum].decayExpo3,
-			oldPresets[presetNum].sustain3,
-			oldPresets[presetNum].release3,
-			oldPresets[presetNum].releaseExpo3,
-			oldPresets[presetNum].egAmplitudeMod3,
-			oldPresets[presetNum].egFrequencyMod3,
-			oldPresets[presetNum].egFilterMod3,
-			oldPresets[presetNum].op1ModAmount3,
-			oldPresets[presetNum].op2ModAmount3,
-			oldPresets[presetNum].op3ModAmount3,
-			oldPresets[presetNum].op4ModAmount3,
-			oldPresets[presetNum].amplitude3,
-			oldPresets[presetNum].filterFreq3,
-			oldPresets[presetNum].filterRes3,
-			oldPresets[presetNum].ampVelSens3,
-			oldPresets[presetNum].filtVelSens3,
-			0,
-
-			// operator 4
-			oldPresets[presetNum].frequency4,
-			oldPresets[presetNum].useRatio4,
-			oldPresets[presetNum].wave4,
-			oldPresets[presetNum].attack4,
-			oldPresets[presetNum].attackExpo4,
-			oldPresets[presetNum].decay4,
-			oldPresets[presetNum].decayExpo4,
-			oldPresets[presetNum].sustain4,
-			oldPresets[presetNum].release4,
-			oldPresets[presetNum].releaseExpo4,
-			oldPresets[presetNum].egAmplitudeMod4,
-			oldPresets[presetNum].egFrequencyMod4,
-			oldPresets[presetNum].egFilterMod4,
-			oldPresets[presetNum].op1ModAmount4,
-			oldPresets[presetNum].op2ModAmount4,
-			oldPresets[presetNum].op3ModAmount4,
-			oldPresets[presetNum].op4ModAmount4,
-			oldPresets[presetNum].amplitude4,
-			oldPresets[presetNum].filterFreq4,
-			oldPresets[presetNum].filterRes4,
-			oldPresets[presetNum].ampVelSens4,
-			oldPresets[presetNum].filtVelSens4,
-			0,
-
-			// global
-			false,
-			1,
-			0.0f,
-			false
-		};
-
-		m_PresetManager->writePreset<ARMor8VoiceState_VERSION_1_1_0>( newPreset, presetNum );
+			OldPreset oldPreset = m_PresetManager->retrievePreset<OldPreset>( presetNum );
+			ARMor8VoiceState voiceState;
+			ARMor8PresetMigrator::migrate( oldSchema, &oldPreset, ARMor8VoiceStateSchema, &voiceState );
+			newPreset = ARMor8PresetCodec::pack( voiceState );
+
+			// keep a copy of the converted preset before overwriting the old one, in case power is lost halfway through
+			m_PresetManager->writePreset<ARMor8PackedPreset>( newPreset, scratchPresetNum );
+
+			progressHeader.upgradeState = PRESET_UPGRADE_SCRATCH_WRITTEN;
+			m_PresetManager->writeHeader<ARMor8PresetHeader>( progressHeader );
+		}
+
+		m_PresetManager->writePreset<ARMor8PackedPreset>( newPreset, presetNum );
+
+		progressHeader.upgradeState = PRESET_UPGRADE_CONVERTING;
+		progressHeader.upgradeNumConverted++;
+		m_PresetManager->writeHeader<ARMor8PresetHeader>( progressHeader );
 	}
 }
@@ -4,7 +4,6 @@
 #include "ARMor8Constants.hpp"
 #include "Graphics.hpp"
 #include "Sprite.hpp"
-#include "IARMor8LCDRefreshEventListener.hpp"
 #include "IPotEventListener.hpp"
 #include "IButtonEventListener.hpp"
 
@@ -14,6 +13,7 @@ ARMor8UiManager::ARMor8UiManager (unsigned int width, unsigned int height, const
 	Surface( width, height, format ),
 	m_Logo( nullptr ),
 	m_CurrentMenu( ARMOR8_MENUS::LOADING ),
+	m_DrawnMenu( ARMOR8_MENUS::LOADING ),
 	m_CurrentPresetNum( 1 ),
 	m_OpCurrentlyBeingEdited( 1 ),
 	m_WaveNumCurrentlyBeingEdited( 1 ),
@@ -45,6 +45,8 @@ ARMor8UiManager::ARMor8UiManager (unsigned int width, unsigned int height, const
 	m_GlideStr{ "GLIDE TIME: X.XXX" },
 	m_PitchBendStr{ "PITCH BEND:    XX" },
 	m_FiltResStr{ "X.XX" },
+	m_Widgets(),
+	m_LCDRefreshAggregator( width, height ),
 	m_FreqPotCached( 0.0f ),
 	m_DetunePotCached( 0.0f ),
 	m_AttackPotCached( 0.0f ),
@@ -97,6 +99,61 @@ ARMor8UiManager::ARMor8UiManager (unsigned int width, unsigned int height, const
 	m_NextPresetBtnState( BUTTON_STATE::FLOATING ),
 	m_WritePresetBtnState( BUTTON_STATE::FLOATING )
 {
+	// the boxes stop short of the lines and of each other, so redrawing one widget never clips another
+	this->setWidget( ARMOR8_WIDGETS::PRST_AND_OP,  ARMOR8_MENUS::STATUS, m_PrstAndOpStr, 0.0f,   0.0f,
+				0.0f,   0.0f,  1.0f,  0.11f );
+	this->setWidget( ARMOR8_WIDGETS::ATTACK,       ARMOR8_MENUS::STATUS, m_AttackStr,    -0.02f, 0.16f,
+				0.0f,   0.16f, 0.49f, 0.26f );
+	this->setWidget( ARMOR8_WIDGETS::DECAY,        ARMOR8_MENUS::STATUS, m_DecayStr,     -0.02f, 0.28f,
+				0.0f,   0.28f, 0.49f, 0.38f );
+	this->setWidget( ARMOR8_WIDGETS::SUSTAIN,      ARMOR8_MENUS::STATUS, m_SustainStr,   -0.02f, 0.39f,
+				0.0f,   0.39f, 0.49f, 0.49f );
+	this->setWidget( ARMOR8_WIDGETS::RELEASE,      ARMOR8_MENUS::STATUS, m_ReleaseStr,   -0.02f, 0.50f,
+				0.0f,   0.50f, 0.49f, 0.60f );
+	this->setWidget( ARMOR8_WIDGETS::OP1_MOD,      ARMOR8_MENUS::STATUS, m_Op1Str,       0.52f,  0.16f,
+				0.52f,  0.16f, 1.0f,  0.26f );
+	this->setWidget( ARMOR8_WIDGETS::OP2_MOD,      ARMOR8_MENUS::STATUS, m_Op2Str,       0.52f,  0.28f,
+				0.52f,  0.28f, 1.0f,  0.38f );
+	this->setWidget( ARMOR8_WIDGETS::OP3_MOD,      ARMOR8_MENUS::STATUS, m_Op3Str,       0.52f,  0.39f,
+				0.52f,  0.39f, 1.0f,  0.49f );
+	this->setWidget( ARMOR8_WIDGETS::OP4_MOD,      ARMOR8_MENUS::STATUS, m_Op4Str,       0.52f,  0.50f,
+				0.52f,  0.50f, 1.0f,  0.60f );
+	this->setWidget( ARMOR8_WIDGETS::AMPLITUDE,    ARMOR8_MENUS::STATUS, m_OpAmpStr,     -0.02f, 0.65f,
+				0.0f,   0.65f, 0.6f,  0.73f );
+	this->setWidget( ARMOR8_WIDGETS::FREQUENCY,    ARMOR8_MENUS::STATUS, m_FreqStr,      -0.02f, 0.74f,
+				0.0f,   0.74f, 0.6f,  0.82f );
+	this->setWidget( ARMOR8_WIDGETS::FILT_FREQ,    ARMOR8_MENUS::STATUS, m_FiltFreqStr,  -0.02f, 0.83f,
+				0.0f,   0.83f, 0.6f,  0.92f );
+	this->setWidget( ARMOR8_WIDGETS::EG_DEST,      ARMOR8_MENUS::STATUS, nullptr,        0.0f,   0.0f,
+				0.92f,  0.64f, 1.0f,  0.9f );
+	this->setWidget( ARMOR8_WIDGETS::MONO_POLY,    ARMOR8_MENUS::STATUS, m_MonoPolyStr,  0.0f,   0.93f,
+				0.0f,   0.93f, 0.36f, 1.0f );
+	this->setWidget( ARMOR8_WIDGETS::WAVE,         ARMOR8_MENUS::STATUS, m_WaveStr,      0.37f,  0.94f,
+				0.37f,  0.94f, 0.62f, 1.0f );
+	this->setWidget( ARMOR8_WIDGETS::RATIO_FIXED,  ARMOR8_MENUS::STATUS, m_RatioFixedStr, 0.625f, 0.93f,
+				0.625f, 0.93f, 1.0f,  1.0f );
+
+	this->setWidget( ARMOR8_WIDGETS::DETUNE,       ARMOR8_MENUS::ADDITIONAL, m_DetuneStr,       -0.02f, 0.0f,
+				0.0f,   0.0f,  1.0f,  0.08f );
+	this->setWidget( ARMOR8_WIDGETS::ATTACK_EXPO,  ARMOR8_MENUS::ADDITIONAL, m_AttackExpoStr,   -0.02f, 0.16f,
+				0.0f,   0.16f, 0.6f,  0.26f );
+	this->setWidget( ARMOR8_WIDGETS::DECAY_EXPO,   ARMOR8_MENUS::ADDITIONAL, m_DecayExpoStr,    -0.02f, 0.30f,
+				0.0f,   0.30f, 0.6f,  0.40f );
+	this->setWidget( ARMOR8_WIDGETS::RELEASE_EXPO, ARMOR8_MENUS::ADDITIONAL, m_ReleaseExpoStr,  -0.02f, 0.42f,
+				0.0f,   0.42f, 0.6f,  0.52f );
+	this->setWidget( ARMOR8_WIDGETS::AMP_VEL,      ARMOR8_MENUS::ADDITIONAL, m_AmplitudeVelStr, -0.02f, 0.60f,
+				0.0f,   0.60f, 0.6f,  0.70f );
+	this->setWidget( ARMOR8_WIDGETS::FILT_VEL,     ARMOR8_MENUS::ADDITIONAL, m_FiltVelStr,      -0.02f, 0.72f,
+				0.0f,   0.72f, 0.6f,  0.81f );
+	this->setWidget( ARMOR8_WIDGETS::GLIDE_TIME,   ARMOR8_MENUS::ADDITIONAL, m_GlideStr,        0.03f,  0.83f,
+				0.03f,  0.83f, 0.97f, 0.92f );
+	this->setWidget( ARMOR8_WIDGETS::PITCH_BEND,   ARMOR8_MENUS::ADDITIONAL, m_PitchBendStr,    0.03f,  0.93f,
+				0.03f,  0.93f, 0.97f, 1.0f );
+	this->setWidget( ARMOR8_WIDGETS::FILT_RES,     ARMOR8_MENUS::ADDITIONAL, m_FiltResStr,      0.71f,  0.3f,
+				0.71f,  0.3f,  0.93f, 0.4f );
+	this->setWidget( ARMOR8_WIDGETS::GLIDE_RETRIG, ARMOR8_MENUS::ADDITIONAL, nullptr,           0.0f,   0.0f,
+				0.76f,  0.63f, 0.86f, 0.75f );
+
 	this->bindToARMor8PresetEventSystem();
 	this->bindToARMor8ParameterEventSystem();
 }
@@ -117,50 +174,67 @@ void ARMor8UiManager::setLogo (Sprite* logo)
 
 void ARMor8UiManager::draw()
 {
-	if ( m_CurrentMenu == ARMOR8_MENUS::LOADING )
+	if ( m_CurrentMenu == ARMOR8_MENUS::LOADING || m_CurrentMenu != m_DrawnMenu )
 	{
-		m_Graphics->setColor( false );
-		m_Graphics->fill();
+		this->drawMenu();
+		m_DrawnMenu = m_CurrentMenu;
+
+		m_LCDRefreshAggregator.addFullScreen();
+
+		return;
+	}
+
+	// otherwise only the dirty widgets are redrawn, and only their boxes are sent
+	for ( unsigned int widgetNum = 0; widgetNum < ARMOR8_NUM_WIDGETS; widgetNum++ )
+	{
+		const ARMor8UiWidget& widget = m_Widgets[widgetNum];
+
+		if ( widget.menu == m_CurrentMenu && widget.dirty )
+		{
+			m_Graphics->setColor( false );
+			m_Graphics->drawBoxFilled( widget.box.xStart, widget.box.yStart, widget.box.xEnd, widget.box.yEnd );
+
+			this->drawWidget( widgetNum );
+			this->queueLCDRefresh( widget.box.xStart, widget.box.yStart, widget.box.xEnd, widget.box.yEnd );
+		}
+	}
+}
+
+void ARMor8UiManager::drawMenu()
+{
+	m_Graphics->setColor( false );
+	m_Graphics->fill();
 
-		m_Graphics->setColor( true );
+	m_Graphics->setColor( true );
+
+	if ( m_CurrentMenu == ARMOR8_MENUS::LOADING )
+	{
 		m_Graphics->drawText( 0.25f, 0.9f, "LOADING...", 1.0f );
 
 		m_Graphics->drawSprite( 0.4f, 0.05f, *m_Logo );
 
 		m_Logo->setRotationAngle( m_Logo->getRotationAngle() + 5 );
-	}
-	else if ( m_CurrentMenu == ARMOR8_MENUS::STATUS )
-	{
-		m_Graphics->setColor( false );
-		m_Graphics->fill();
 
-		m_Graphics->setColor( true );
+		return;
+	}
 
-		m_Graphics->drawText( 0.0f, 0.0f, m_PrstAndOpStr, 1.0f );
+	for ( unsigned int widgetNum = 0; widgetNum < ARMOR8_NUM_WIDGETS; widgetNum++ )
+	{
+		if ( m_Widgets[widgetNum].menu == m_CurrentMenu )
+		{
+			this->drawWidget( widgetNum );
+		}
+	}
 
+	if ( m_CurrentMenu == ARMOR8_MENUS::STATUS )
+	{
 		m_Graphics->drawLine( 0.0f, 0.12f, 1.0f, 0.12f );
 		m_Graphics->drawLine( 0.0f, 0.14f, 1.0f, 0.14f );
 
-		m_Graphics->drawText( -0.02f, 0.16f, m_AttackStr,  1.0f );
-		m_Graphics->drawText( -0.02f, 0.28f, m_DecayStr,   1.0f );
-		m_Graphics->drawText( -0.02f, 0.39f, m_SustainStr, 1.0f );
-		m_Graphics->drawText( -0.02f, 0.50f, m_ReleaseStr, 1.0f );
-
 		m_Graphics->drawLine( 0.5f, 0.14f, 0.5f, 0.6f );
 
-		m_Graphics->drawText( 0.52f, 0.16f, m_Op1Str, 1.0f );
-		m_Graphics->drawText( 0.52f, 0.28f, m_Op2Str, 1.0f );
-		m_Graphics->drawText( 0.52f, 0.39f, m_Op3Str, 1.0f );
-		m_Graphics->drawText( 0.52f, 0.50f, m_Op4Str, 1.0f );
-
 		m_Graphics->drawLine( 0.1f, 0.61f, 0.9f, 0.61f );
 
-		m_Graphics->drawText( -0.02f, 0.65f, m_OpAmpStr, 1.0f );
-
-		m_Graphics->drawText( -0.02f, 0.74f, m_FreqStr, 1.0f );
-
-		m_Graphics->drawText( -0.02f, 0.83f, m_FiltFreqStr, 1.0f );
-
 		m_Graphics->drawLine( 0.61f, 0.63f, 0.61f, 0.9f );
 
 		m_Graphics->drawText( 0.63f, 0.65f, "EGAMP", 1.0f );
@@ -168,89 +242,53 @@ void ARMor8UiManager::draw()
 		m_Graphics->drawText( 0.63f, 0.74f, "EGFRQ", 1.0f );
 
 		m_Graphics->drawText( 0.63f, 0.83f, "EGFLT", 1.0f );
-
-		// eg destination amplitude
-		if ( m_EGDestBitmask & 0b100 )
-		{
-			m_Graphics->drawCircle( 0.96f, 0.67f, 0.02f );
-			m_Graphics->drawCircleFilled( 0.96f, 0.67f, 0.02f );
-		}
-		else
-		{
-			m_Graphics->drawCircle( 0.96f, 0.67f, 0.02f );
-		}
-
-		// eg destination frequency
-		if ( m_EGDestBitmask & 0b010 )
-		{
-			m_Graphics->drawCircle( 0.96f, 0.77f, 0.02f );
-			m_Graphics->drawCircleFilled( 0.96f, 0.77f, 0.02f );
-		}
-		else
-		{
-			m_Graphics->drawCircle( 0.96f, 0.77f, 0.02f );
-		}
-
-		// eg destination filter
-		if ( m_EGDestBitmask & 0b001 )
-		{
-			m_Graphics->drawCircle( 0.96f, 0.87f, 0.02f );
-			m_Graphics->drawCircleFilled( 0.96f, 0.87f, 0.02f );
-		}
-		else
-		{
-			m_Graphics->drawCircle( 0.96f, 0.87f, 0.02f );
-		}
-
-		m_Graphics->drawText( 0.0f, 0.93f, m_MonoPolyStr, 1.0f );
-
-		m_Graphics->drawText( 0.37f, 0.94f, m_WaveStr, 1.0f );
-
-		m_Graphics->drawText( 0.625f, 0.93f, m_RatioFixedStr, 1.0f );
 	}
 	else if ( m_CurrentMenu == ARMOR8_MENUS::ADDITIONAL )
 	{
-		m_Graphics->setColor( false );
-		m_Graphics->fill();
-
-		m_Graphics->setColor( true );
-
-		m_Graphics->drawText( -0.02f, 0.0f, m_DetuneStr, 1.0f );
-
 		m_Graphics->drawLine( 0.0f, 0.11f, 1.0f, 0.11f );
 
-		m_Graphics->drawText( -0.02f, 0.16f, m_AttackExpoStr, 1.0f );
-		m_Graphics->drawText( -0.02f, 0.30f, m_DecayExpoStr, 1.0f );
-		m_Graphics->drawText( -0.02f, 0.42f, m_ReleaseExpoStr, 1.0f );
-
 		m_Graphics->drawLine( 0.0f, 0.55f, 0.62f, 0.55f );
 		m_Graphics->drawLine( 0.62f, 0.25f, 0.62f, 0.69f );
 
-		m_Graphics->drawText( -0.02f, 0.60f, m_AmplitudeVelStr, 1.0f );
-		m_Graphics->drawText( -0.02f, 0.72f, m_FiltVelStr, 1.0f );
-
 		m_Graphics->drawLine( 0.7f, 0.80f, 1.0f, 0.80f );
 
-		m_Graphics->drawText( 0.03f, 0.83f, m_GlideStr, 1.0f );
-		m_Graphics->drawText( 0.03f, 0.93f, m_PitchBendStr, 1.0f );
-
 		m_Graphics->drawText( 0.63f, 0.2f, "FLTRES:", 1.0f );
-		m_Graphics->drawText( 0.71f, 0.3f, m_FiltResStr, 1.0f );
 
 		m_Graphics->drawText( 0.63f, 0.48f, "GLDRETR", 1.0f );
-		if ( m_UsingGlideRetrigger )
-		{
-			m_Graphics->drawCircle( 0.81f, 0.67f, 0.03f );
-			m_Graphics->drawCircleFilled( 0.81f, 0.67f, 0.03f );
-		}
-		else
-		{
-			m_Graphics->drawCircle( 0.81f, 0.67f, 0.03f );
-		}
 	}
+}
+
+void ARMor8UiManager::drawWidget (unsigned int widgetNum)
+{
+	ARMor8UiWidget& widget = m_Widgets[widgetNum];
+
+	m_Graphics->setColor( true );
+
+	if ( widget.text )
+	{
+		m_Graphics->drawText( widget.textX, widget.textY, widget.text, 1.0f );
+	}
+	else if ( widgetNum == static_cast<unsigned int>(ARMOR8_WIDGETS::EG_DEST) )
+	{
+		// eg destination amplitude
+		m_Graphics->drawCircle( 0.96f, 0.67f, 0.02f );
+		if ( m_EGDestBitmask & 0b100 ) m_Graphics->drawCircleFilled( 0.96f, 0.67f, 0.02f );
 
-	IARMor8LCDRefreshEventListener::PublishEvent(
-			ARMor8LCDRefreshEvent(0, 0, this->getFrameBuffer()->getWidth(), this->getFrameBuffer()->getHeight(), 0) );
+		// eg destination frequency
+		m_Graphics->drawCircle( 0.96f, 0.77f, 0.02f );
+		if ( m_EGDestBitmask & 0b010 ) m_Graphics->drawCircleFilled( 0.96f, 0.77f, 0.02f );
+
+		// eg destination filter
+		m_Graphics->drawCircle( 0.96f, 0.87f, 0.02f );
+		if ( m_EGDestBitmask & 0b001 ) m_Graphics->drawCircleFilled( 0.96f, 0.87f, 0.02f );
+	}
+	else if ( widgetNum == static_cast<unsigned int>(ARMOR8_WIDGETS::GLIDE_RETRIG) )
+	{
+		m_Graphics->drawCircle( 0.81f, 0.67f, 0.03f );
+		if ( m_UsingGlideRetrigger ) m_Graphics->drawCircleFilled( 0.81f, 0.67f, 0.03f );
+	}
+
+	widget.dirty = false;
 }
 
 void ARMor8UiManager::drawLoadingLogo()
@@ -264,7 +302,12 @@ void ARMor8UiManager::drawLoadingLogo()
 
 	m_Logo->setRotationAngle( m_Logo->getRotationAngle() + 5 );
 
-	this->publishPartialLCDRefreshEvent( 0.3f, 0.05f, 0.7f, 0.8f );
+	this->queueLCDRefresh( 0.3f, 0.05f, 0.7f, 0.8f );
+}
+
+void ARMor8UiManager::publishLCDRefreshes()
+{
+	m_LCDRefreshAggregator.flush();
 }
 
 void ARMor8UiManager::tickForChangingBackToStatus()
@@ -286,212 +329,145 @@ void ARMor8UiManager::onARMor8PresetChangedEvent (const ARMor8PresetEvent& prese
 {
 	this->lockAllPots();
 
-	ARMor8VoiceState voiceState = presetEvent.getPreset();
+	const ARMor8VoiceState& voiceState = presetEvent.getPreset();
 	m_OpCurrentlyBeingEdited = presetEvent.getOpToEdit() + 1;
 	m_CurrentPresetNum = presetEvent.getPresetNum() + 1;
 
+	// only the strings for values that changed since the last preset event are reformatted
+	ARMor8OperatorState op = ARMor8PatchSnapshot::getOperatorState( voiceState, presetEvent.getOpToEdit() );
+
 	// buffer for holding parameter strings
 	const unsigned int bufferLen = 20;
 	char buffer[bufferLen];
 
-	this->updateOpNumberStr( buffer, bufferLen );
-	this->updatePrstNumberStr( buffer, bufferLen);
-
-	float amplitude     = 0.0f;
-	float frequency     = 0.0f;
-	int   detune        = 0;
-	float filtFrequency = 0.0f;
-	float attackAmount  = 0.0f;
-	float decayAmount   = 0.0f;
-	float sustainAmount = 0.0f;
-	float releaseAmount = 0.0f;
-	float attackExpo    = 0.0f;
-	float decayExpo     = 0.0f;
-	float releaseExpo   = 0.0f;
-	float op1ModAmount  = 0.0f;
-	float op2ModAmount  = 0.0f;
-	float op3ModAmount  = 0.0f;
-	float op4ModAmount  = 0.0f;
-	bool  egDestAmpl    = false;
-	bool  egDestFreq    = false;
-	bool  egDestFilt    = false;
-	bool  usingRatio    = false;
-	bool  usingGlide    = voiceState.glideRetrigger;
-	bool  usingMono     = voiceState.monophonic;
-	float amplitudeVel  = 0.0f;
-	float filterVel     = 0.0f;
-	float glideTime     = voiceState.glideTime;
-	OscillatorMode wave = OscillatorMode::SINE;
-	unsigned int pitchBendSemitones = voiceState.pitchBendSemitones;
-	float filterRes     = 0.0f;
-
-	switch ( m_OpCurrentlyBeingEdited )
-	{
-		case 1:
-			amplitude     = voiceState.amplitude1;
-			frequency     = voiceState.frequency1;
-			detune        = voiceState.detune1;
-			filtFrequency = voiceState.filterFreq1;
-			attackAmount  = voiceState.attack1;
-			decayAmount   = voiceState.decay1;
-			sustainAmount = voiceState.sustain1;
-			releaseAmount = voiceState.release1;
-			attackExpo    = voiceState.attackExpo1;
-			decayExpo     = voiceState.decayExpo1;
-			releaseExpo   = voiceState.releaseExpo1;
-			op1ModAmount  = voiceState.op1ModAmount1;
-			op2ModAmount  = voiceState.op2ModAmount1;
-			op3ModAmount  = voiceState.op3ModAmount1;
-			op4ModAmount  = voiceState.op4ModAmount1;
-			egDestAmpl    = voiceState.egAmplitudeMod1;
-			egDestFreq    = voiceState.egFrequencyMod1;
-			egDestFilt    = voiceState.egFilterMod1;
-			usingRatio    = voiceState.useRatio1;
-			amplitudeVel  = voiceState.ampVelSens1;
-			filterVel     = voiceState.filtVelSens1;
-			wave          = voiceState.wave1;
-			filterRes     = voiceState.filterRes1;
+	if ( presetEvent.fieldChanged(ARMor8PresetField::OP_TO_EDIT) ) this->updateOpNumberStr( buffer, bufferLen );
+	if ( presetEvent.fieldChanged(ARMor8PresetField::PRESET_NUM) ) this->updatePrstNumberStr( buffer, bufferLen);
 
-			break;
-		case 2:
-			amplitude     = voiceState.amplitude2;
-			frequency     = voiceState.frequency2;
-			detune        = voiceState.detune2;
-			filtFrequency = voiceState.filterFreq2;
-			attackAmount  = voiceState.attack2;
-			decayAmount   = voiceState.decay2;
-			sustainAmount = voiceState.sustain2;
-			releaseAmount = voiceState.release2;
-			attackExpo    = voiceState.attackExpo2;
-			decayExpo     = voiceState.decayExpo2;
-			releaseExpo   = voiceState.releaseExpo2;
-			op1ModAmount  = voiceState.op1ModAmount2;
-			op2ModAmount  = voiceState.op2ModAmount2;
-			op3ModAmount  = voiceState.op3ModAmount2;
-			op4ModAmount  = voiceState.op4ModAmount2;
-			egDestAmpl    = voiceState.egAmplitudeMod2;
-			egDestFreq    = voiceState.egFrequencyMod2;
-			egDestFilt    = voiceState.egFilterMod2;
-			usingRatio    = voiceState.useRatio2;
-			amplitudeVel  = voiceState.ampVelSens2;
-			filterVel     = voiceState.filtVelSens2;
-			wave          = voiceState.wave2;
-			filterRes     = voiceState.filterRes2;
+	if ( presetEvent.fieldChanged(ARMor8PresetField::WAVE) )
+	{
+		if ( op.wave == OscillatorMode::SINE )
+		{
+			m_WaveNumCurrentlyBeingEdited = 1;
+		}
+		else if ( op.wave == OscillatorMode::TRIANGLE )
+		{
+			m_WaveNumCurrentlyBeingEdited = 2;
+		}
+		else if ( op.wave == OscillatorMode::SQUARE )
+		{
+			m_WaveNumCurrentlyBeingEdited = 3;
+		}
+		else if ( op.wave == OscillatorMode::SAWTOOTH )
+		{
+			m_WaveNumCurrentlyBeingEdited = 4;
+		}
 
-			break;
-		case 3:
-			amplitude     = voiceState.amplitude3;
-			frequency     = voiceState.frequency3;
-			detune        = voiceState.detune3;
-			filtFrequency = voiceState.filterFreq3;
-			attackAmount  = voiceState.attack3;
-			decayAmount   = voiceState.decay3;
-			sustainAmount = voiceState.sustain3;
-			releaseAmount = voiceState.release3;
-			attackExpo    = voiceState.attackExpo3;
-			decayExpo     = voiceState.decayExpo3;
-			releaseExpo   = voiceState.releaseExpo3;
-			op1ModAmount  = voiceState.op1ModAmount3;
-			op2ModAmount  = voiceState.op2ModAmount3;
-			op3ModAmount  = voiceState.op3ModAmount3;
-			op4ModAmount  = voiceState.op4ModAmount3;
-			egDestAmpl    = voiceState.egAmplitudeMod3;
-			egDestFreq    = voiceState.egFrequencyMod3;
-			egDestFilt    = voiceState.egFilterMod3;
-			usingRatio    = voiceState.useRatio3;
-			amplitudeVel  = voiceState.ampVelSens3;
-			filterVel     = voiceState.filtVelSens3;
-			wave          = voiceState.wave3;
-			filterRes     = voiceState.filterRes3;
+		this->updateWaveStr();
+	}
 
-			break;
-		case 4:
-			amplitude     = voiceState.amplitude4;
-			frequency     = voiceState.frequency4;
-			detune        = voiceState.detune4;
-			filtFrequency = voiceState.filterFreq4;
-			attackAmount  = voiceState.attack4;
-			decayAmount   = voiceState.decay4;
-			sustainAmount = voiceState.sustain4;
-			releaseAmount = voiceState.release4;
-			attackExpo    = voiceState.attackExpo4;
-			decayExpo     = voiceState.decayExpo4;
-			releaseExpo   = voiceState.releaseExpo4;
-			op1ModAmount  = voiceState.op1ModAmount4;
-			op2ModAmount  = voiceState.op2ModAmount4;
-			op3ModAmount  = voiceState.op3ModAmount4;
-			op4ModAmount  = voiceState.op4ModAmount4;
-			egDestAmpl    = voiceState.egAmplitudeMod4;
-			egDestFreq    = voiceState.egFrequencyMod4;
-			egDestFilt    = voiceState.egFilterMod4;
-			usingRatio    = voiceState.useRatio4;
-			amplitudeVel  = voiceState.ampVelSens4;
-			filterVel     = voiceState.filtVelSens4;
-			wave          = voiceState.wave4;
-			filterRes     = voiceState.filterRes4;
+	m_EGDestBitmask = 0b000;
 
-			break;
-		default:
-			break;
-	}
+	if ( op.egAmplitudeMod ) m_EGDestBitmask = m_EGDestBitmask | 0b100;
+	if ( op.egFrequencyMod ) m_EGDestBitmask = m_EGDestBitmask | 0b010;
+	if ( op.egFilterMod )    m_EGDestBitmask = m_EGDestBitmask | 0b001;
+
+	m_UsingRatio = op.useRatio;
+	m_UsingGlideRetrigger = voiceState.glideRetrigger;
+	m_UsingMono = voiceState.monophonic;
+
+	if ( presetEvent.fieldChanged(ARMor8PresetField::EG_DESTINATIONS) ) this->markWidgetDirty( ARMOR8_WIDGETS::EG_DEST );
+	if ( presetEvent.fieldChanged(ARMor8PresetField::GLIDE_RETRIGGER) ) this->markWidgetDirty( ARMOR8_WIDGETS::GLIDE_RETRIG );
 
-	if ( wave == OscillatorMode::SINE )
+	if ( presetEvent.fieldChanged(ARMor8PresetField::MONOPHONIC) ) this->updateMonoPolyStr();
+	if ( presetEvent.fieldChanged(ARMor8PresetField::RATIO) ) this->updateRatioFixedStr();
+
+	if ( presetEvent.fieldChanged(ARMor8PresetField::AMPLITUDE) )
 	{
-		m_WaveNumCurrentlyBeingEdited = 1;
+		this->updateAmplitudeStr( op.amplitude, buffer, bufferLen );
 	}
-	else if ( wave == OscillatorMode::TRIANGLE )
+	// the frequency is shown as a ratio or in hz depending on the ratio setting, so it's reformatted when either changes
+	if ( presetEvent.fieldChanged(ARMor8PresetField::FREQUENCY) || presetEvent.fieldChanged(ARMor8PresetField::RATIO) )
 	{
-		m_WaveNumCurrentlyBeingEdited = 2;
+		this->updateFrequencyStr( op.frequency, buffer, bufferLen );
 	}
-	else if ( wave == OscillatorMode::SQUARE )
+	if ( presetEvent.fieldChanged(ARMor8PresetField::DETUNE) )
 	{
-		m_WaveNumCurrentlyBeingEdited = 3;
+		this->updateDetuneStr( op.detune, buffer, bufferLen );
 	}
-	else if ( wave == OscillatorMode::SAWTOOTH )
+	if ( presetEvent.fieldChanged(ARMor8PresetField::FILTER_FREQ) )
 	{
-		m_WaveNumCurrentlyBeingEdited = 4;
+		this->updateFiltFreqStr( op.filterFreq, buffer, bufferLen );
 	}
 
-	m_EGDestBitmask = 0b000;
-
-	if ( egDestAmpl ) m_EGDestBitmask = m_EGDestBitmask | 0b100;
-	if ( egDestFreq ) m_EGDestBitmask = m_EGDestBitmask | 0b010;
-	if ( egDestFilt ) m_EGDestBitmask = m_EGDestBitmask | 0b001;
-
-	m_UsingRatio = usingRatio;
-	m_UsingGlideRetrigger = usingGlide;
-	m_UsingMono = usingMono;
-
-	this->updateMonoPolyStr();
-	this->updateWaveStr();
-	this->updateRatioFixedStr();
-
-	this->updateAmplitudeStr( amplitude, buffer, bufferLen );
-	this->updateFrequencyStr( frequency, buffer, bufferLen );
-	this->updateDetuneStr( detune, buffer, bufferLen );
-	this->updateFiltFreqStr( filtFrequency, buffer, bufferLen );
-
-	this->updateOpModStr( 1, op1ModAmount, buffer, bufferLen );
-	this->updateOpModStr( 2, op2ModAmount, buffer, bufferLen );
-	this->updateOpModStr( 3, op3ModAmount, buffer, bufferLen );
-	this->updateOpModStr( 4, op4ModAmount, buffer, bufferLen );
+	if ( presetEvent.fieldChanged(ARMor8PresetField::OP1_MOD_AMOUNT) )
+	{
+		this->updateOpModStr( 1, op.op1ModAmount, buffer, bufferLen );
+	}
+	if ( presetEvent.fieldChanged(ARMor8PresetField::OP2_MOD_AMOUNT) )
+	{
+		this->updateOpModStr( 2, op.op2ModAmount, buffer, bufferLen );
+	}
+	if ( presetEvent.fieldChanged(ARMor8PresetField::OP3_MOD_AMOUNT) )
+	{
+		this->updateOpModStr( 3, op.op3ModAmount, buffer, bufferLen );
+	}
+	if ( presetEvent.fieldChanged(ARMor8PresetField::OP4_MOD_AMOUNT) )
+	{
+		this->updateOpModStr( 4, op.op4ModAmount, buffer, bufferLen );
+	}
 
-	this->updateAttackStr( attackAmount, buffer, bufferLen );
-	this->updateDecayStr( decayAmount, buffer, bufferLen );
-	this->updateSustainStr( sustainAmount, buffer, bufferLen );
-	this->updateReleaseStr( releaseAmount, buffer, bufferLen );
+	if ( presetEvent.fieldChanged(ARMor8PresetField::ATTACK) )
+	{
+		this->updateAttackStr( op.attack, buffer, bufferLen );
+	}
+	if ( presetEvent.fieldChanged(ARMor8PresetField::DECAY) )
+	{
+		this->updateDecayStr( op.decay, buffer, bufferLen );
+	}
+	if ( presetEvent.fieldChanged(ARMor8PresetField::SUSTAIN) )
+	{
+		this->updateSustainStr( op.sustain, buffer, bufferLen );
+	}
+	if ( presetEvent.fieldChanged(ARMor8PresetField::RELEASE) )
+	{
+		this->updateReleaseStr( op.release, buffer, bufferLen );
+	}
 
-	this->updateAttackExpoStr( attackExpo, buffer, bufferLen );
-	this->updateDecayExpoStr( decayExpo, buffer, bufferLen );
-	this->updateReleaseExpoStr( releaseExpo, buffer, bufferLen );
+	if ( presetEvent.fieldChanged(ARMor8PresetField::ATTACK_EXPO) )
+	{
+		this->updateAttackExpoStr( op.attackExpo, buffer, bufferLen );
+	}
+	if ( presetEvent.fieldChanged(ARMor8PresetField::DECAY_EXPO) )
+	{
+		this->updateDecayExpoStr( op.decayExpo, buffer, bufferLen );
+	}
+	if ( presetEvent.fieldChanged(ARMor8PresetField::RELEASE_EXPO) )
+	{
+		this->updateReleaseExpoStr( op.releaseExpo, buffer, bufferLen );
+	}
 
-	this->updateAmplitudeVelStr( amplitudeVel, buffer, bufferLen );
-	this->updateFilterVelStr( filterVel, buffer, bufferLen );
+	if ( presetEvent.fieldChanged(ARMor8PresetField::AMP_VEL_SENS) )
+	{
+		this->updateAmplitudeVelStr( op.ampVelSens, buffer, bufferLen );
+	}
+	if ( presetEvent.fieldChanged(ARMor8PresetField::FILT_VEL_SENS) )
+	{
+		this->updateFilterVelStr( op.filtVelSens, buffer, bufferLen );
+	}
 
-	this->updateGlideStr( glideTime, buffer, bufferLen );
-	this->updatePitchBendStr( pitchBendSemitones, buffer, bufferLen );
+	if ( presetEvent.fieldChanged(ARMor8PresetField::GLIDE_TIME) )
+	{
+		this->updateGlideStr( voiceState.glideTime, buffer, bufferLen );
+	}
+	if ( presetEvent.fieldChanged(ARMor8PresetField::PITCH_BEND) )
+	{
+		this->updatePitchBendStr( voiceState.pitchBendSemitones, buffer, bufferLen );
+	}
 
-	this->updateFiltResStr( filterRes, buffer, bufferLen );
+	if ( presetEvent.fieldChanged(ARMor8PresetField::FILTER_RES) )
+	{
+		this->updateFiltResStr( op.filterRes, buffer, bufferLen );
+	}
 
 	std::cout << "OP TO EDIT: " << m_OpCurrentlyBeingEdited << std::endl;
 	std::cout << "PRESET NUM: " << m_CurrentPresetNum << std::endl;
@@ -500,8 +476,7 @@ void ARMor8UiManager::onARMor8PresetChangedEvent (const ARMor8PresetEvent& prese
 	std::cout << "GLIDE RETRIG: " << std::to_string( m_UsingGlideRetrigger ) << std::endl;
 	std::cout << "MONO: " << std::to_string( m_UsingMono ) << std::endl;
 
-	m_CurrentMenu = ARMOR8_MENUS::STATUS;
-	this->draw();
+	this->showMenu( ARMOR8_MENUS::STATUS );
 }
 
 void ARMor8UiManager::onARMor8ParameterEvent (const ARMor8ParameterEvent& paramEvent)
@@ -518,20 +493,7 @@ void ARMor8UiManager::onARMor8ParameterEvent (const ARMor8ParameterEvent& paramE
 			float amplitudeAmount = paramEvent.getValue();
 			this->updateAmplitudeStr( amplitudeAmount, buffer, bufferLen );
 
-			if ( m_CurrentMenu == ARMOR8_MENUS::STATUS )
-			{
-				m_Graphics->setColor( false );
-				m_Graphics->drawBoxFilled( 0.0f, 0.65f, 0.62f, 0.73f );
-				m_Graphics->setColor( true );
-				m_Graphics->drawText( -0.02f, 0.65f, m_OpAmpStr, 1.0f );
-
-				this->publishPartialLCDRefreshEvent( 0.0f, 0.65f, 0.62f, 0.73f );
-			}
-			else
-			{
-				m_CurrentMenu = ARMOR8_MENUS::STATUS;
-				this->draw();
-			}
+			this->showMenu( ARMOR8_MENUS::STATUS );
 		}
 
 			break;
@@ -540,20 +502,7 @@ void ARMor8UiManager::onARMor8ParameterEvent (const ARMor8ParameterEvent& paramE
 			float filtFrequencyAmount = paramEvent.getValue();
 			this->updateFiltFreqStr( filtFrequencyAmount, buffer, bufferLen );
 
-			if ( m_CurrentMenu == ARMOR8_MENUS::STATUS )
-			{
-				m_Graphics->setColor( false );
-				m_Graphics->drawBoxFilled( 0.0f, 0.83f, 0.62f, 0.92f );
-				m_Graphics->setColor( true );
-				m_Graphics->drawText( -0.02f, 0.83f, m_FiltFreqStr, 1.0f );
-
-				this->publishPartialLCDRefreshEvent( 0.0f, 0.83f, 0.62f, 0.92f );
-			}
-			else
-			{
-				m_CurrentMenu = ARMOR8_MENUS::STATUS;
-				this->draw();
-			}
+			this->showMenu( ARMOR8_MENUS::STATUS );
 		}
 
 			break;
@@ -562,20 +511,7 @@ void ARMor8UiManager::onARMor8ParameterEvent (const ARMor8ParameterEvent& paramE
 			float frequencyAmount = paramEvent.getValue();
 			this->updateFrequencyStr( frequencyAmount, buffer, bufferLen );
 
-			if ( m_CurrentMenu == ARMOR8_MENUS::STATUS )
-			{
-				m_Graphics->setColor( false );
-				m_Graphics->drawBoxFilled( 0.0f, 0.74f, 0.62f, 0.82f );
-				m_Graphics->setColor( true );
-				m_Graphics->drawText( -0.02f, 0.74f, m_FreqStr, 1.0f );
-
-				this->publishPartialLCDRefreshEvent( 0.0f, 0.74f, 0.62f, 0.82f );
-			}
-			else
-			{
-				m_CurrentMenu = ARMOR8_MENUS::STATUS;
-				this->draw();
-			}
+			this->showMenu( ARMOR8_MENUS::STATUS );
 		}
 
 			break;
@@ -584,20 +520,7 @@ void ARMor8UiManager::onARMor8ParameterEvent (const ARMor8ParameterEvent& paramE
 			float attackAmount = paramEvent.getValue();
 			this->updateAttackStr( attackAmount, buffer, bufferLen );
 
-			if ( m_CurrentMenu == ARMOR8_MENUS::STATUS )
-			{
-				m_Graphics->setColor( false );
-				m_Graphics->drawBoxFilled( 0.0f, 0.16f, 0.5f, 0.26f );
-				m_Graphics->setColor( true );
-				m_Graphics->drawText( -0.02f, 0.16f, m_AttackStr,  1.0f );
-
-				this->publishPartialLCDRefreshEvent( 0.0f, 0.16f, 0.5f, 0.26f );
-			}
-			else
-			{
-				m_CurrentMenu = ARMOR8_MENUS::STATUS;
-				this->draw();
-			}
+			this->showMenu( ARMOR8_MENUS::STATUS );
 		}
 
 			break;
@@ -606,20 +529,7 @@ void ARMor8UiManager::onARMor8ParameterEvent (const ARMor8ParameterEvent& paramE
 			float decayAmount = paramEvent.getValue();
 			this->updateDecayStr( decayAmount, buffer, bufferLen );
 
-			if ( m_CurrentMenu == ARMOR8_MENUS::STATUS )
-			{
-				m_Graphics->setColor( false );
-				m_Graphics->drawBoxFilled( 0.0f, 0.28f, 0.5f, 0.38f );
-				m_Graphics->setColor( true );
-				m_Graphics->drawText( -0.02f, 0.28f, m_DecayStr, 1.0f );
-
-				this->publishPartialLCDRefreshEvent( 0.0f, 0.28f, 0.5f, 0.38f );
-			}
-			else
-			{
-				m_CurrentMenu = ARMOR8_MENUS::STATUS;
-				this->draw();
-			}
+			this->showMenu( ARMOR8_MENUS::STATUS );
 		}
 			break;
 		case POT_CHANNEL::SUSTAIN:
@@ -627,20 +537,7 @@ void ARMor8UiManager::onARMor8ParameterEvent (const ARMor8ParameterEvent& paramE
 			float sustainAmount = paramEvent.getValue();
 			this->updateSustainStr( sustainAmount, buffer, bufferLen );
 
-			if ( m_CurrentMenu == ARMOR8_MENUS::STATUS )
-			{
-				m_Graphics->setColor( false );
-				m_Graphics->drawBoxFilled( 0.0f, 0.39f, 0.5f, 0.49f );
-				m_Graphics->setColor( true );
-				m_Graphics->drawText( -0.02f, 0.39f, m_SustainStr, 1.0f );
-
-				this->publishPartialLCDRefreshEvent( 0.0f, 0.39f, 0.5f, 0.49f );
-			}
-			else
-			{
-				m_CurrentMenu = ARMOR8_MENUS::STATUS;
-				this->draw();
-			}
+			this->showMenu( ARMOR8_MENUS::STATUS );
 		}
 
 			break;
@@ -649,20 +546,7 @@ void ARMor8UiManager::onARMor8ParameterEvent (const ARMor8ParameterEvent& paramE
 			float releaseAmount = paramEvent.getValue();
 			this->updateReleaseStr( releaseAmount, buffer, bufferLen );
 
-			if ( m_CurrentMenu == ARMOR8_MENUS::STATUS )
-			{
-				m_Graphics->setColor( false );
-				m_Graphics->drawBoxFilled( 0.0f, 0.5f, 0.5f, 0.6f );
-				m_Graphics->setColor( true );
-				m_Graphics->drawText( -0.02f, 0.50f, m_ReleaseStr, 1.0f );
-
-				this->publishPartialLCDRefreshEvent( 0.0f, 0.5f, 0.5f, 0.6f );
-			}
-			else
-			{
-				m_CurrentMenu = ARMOR8_MENUS::STATUS;
-				this->draw();
-			}
+			this->showMenu( ARMOR8_MENUS::STATUS );
 		}
 
 			break;
@@ -671,20 +555,7 @@ void ARMor8UiManager::onARMor8ParameterEvent (const ARMor8ParameterEvent& paramE
 			float op1ModAmount = paramEvent.getValue();
 			this->updateOpModStr( 1, op1ModAmount, buffer, bufferLen, false );
 
-			if ( m_CurrentMenu == ARMOR8_MENUS::STATUS )
-			{
-				m_Graphics->setColor( false );
-				m_Graphics->drawBoxFilled( 0.52f, 0.16f, 1.1f, 0.26f );
-				m_Graphics->setColor( true );
-				m_Graphics->drawText( 0.52f, 0.16f, m_Op1Str, 1.0f );
-
-				this->publishPartialLCDRefreshEvent( 0.52f, 0.16f, 1.0f, 0.28f );
-			}
-			else
-			{
-				m_CurrentMenu = ARMOR8_MENUS::STATUS;
-				this->draw();
-			}
+			this->showMenu( ARMOR8_MENUS::STATUS );
 		}
 
 			break;
@@ -693,20 +564,7 @@ void ARMor8UiManager::onARMor8ParameterEvent (const ARMor8ParameterEvent& paramE
 			float op2ModAmount = paramEvent.getValue();
 			this->updateOpModStr( 2, op2ModAmount, buffer, bufferLen, false );
 
-			if ( m_CurrentMenu == ARMOR8_MENUS::STATUS )
-			{
-				m_Graphics->setColor( false );
-				m_Graphics->drawBoxFilled( 0.52f, 0.28f, 1.1f, 0.38f );
-				m_Graphics->setColor( true );
-				m_Graphics->drawText( 0.52f, 0.28f, m_Op2Str, 1.0f );
-
-				this->publishPartialLCDRefreshEvent( 0.52f, 0.28f, 1.0f, 0.38f );
-			}
-			else
-			{
-				m_CurrentMenu = ARMOR8_MENUS::STATUS;
-				this->draw();
-			}
+			this->showMenu( ARMOR8_MENUS::STATUS );
 		}
 
 			break;
@@ -715,20 +573,7 @@ void ARMor8UiManager::onARMor8ParameterEvent (const ARMor8ParameterEvent& paramE
 			float op3ModAmount = paramEvent.getValue();
 			this->updateOpModStr( 3, op3ModAmount, buffer, bufferLen, false );
 
-			if ( m_CurrentMenu == ARMOR8_MENUS::STATUS )
-			{
-				m_Graphics->setColor( false );
-				m_Graphics->drawBoxFilled( 0.52f, 0.39f, 1.1f, 0.49f );
-				m_Graphics->setColor( true );
-				m_Graphics->drawText( 0.52f, 0.39f, m_Op3Str, 1.0f );
-
-				this->publishPartialLCDRefreshEvent( 0.52f, 0.39f, 1.0f, 0.49f );
-			}
-			else
-			{
-				m_CurrentMenu = ARMOR8_MENUS::STATUS;
-				this->draw();
-			}
+			this->showMenu( ARMOR8_MENUS::STATUS );
 		}
 
 			break;
@@ -737,20 +582,7 @@ void ARMor8UiManager::onARMor8ParameterEvent (const ARMor8ParameterEvent& paramE
 			float op4ModAmount = paramEvent.getValue();
 			this->updateOpModStr( 4, op4ModAmount, buffer, bufferLen, false );
 
-			if ( m_CurrentMenu == ARMOR8_MENUS::STATUS )
-			{
-				m_Graphics->setColor( false );
-				m_Graphics->drawBoxFilled( 0.52f, 0.50f, 1.1f, 0.60f );
-				m_Graphics->setColor( true );
-				m_Graphics->drawText( 0.52f, 0.50f, m_Op4Str, 1.0f );
-
-				this->publishPartialLCDRefreshEvent( 0.52f, 0.50f, 1.0f, 0.60f );
-			}
-			else
-			{
-				m_CurrentMenu = ARMOR8_MENUS::STATUS;
-				this->draw();
-			}
+			this->showMenu( ARMOR8_MENUS::STATUS );
 		}
 
 			break;
@@ -760,20 +592,7 @@ void ARMor8UiManager::onARMor8ParameterEvent (const ARMor8ParameterEvent& paramE
 			int detuneAmount = *reinterpret_cast<int*>( &detuneAmountF );
 			this->updateDetuneStr( detuneAmount, buffer, bufferLen );
 
-			if ( m_CurrentMenu == ARMOR8_MENUS::ADDITIONAL )
-			{
-				m_Graphics->setColor( false );
-				m_Graphics->drawBoxFilled( 0.0f, 0.0f, 1.0f, 0.08f );
-				m_Graphics->setColor( true );
-				m_Graphics->drawText( -0.02f, 0.0f, m_DetuneStr, 1.0f );
-
-				this->publishPartialLCDRefreshEvent( 0.0f, 0.0f, 1.0f, 0.08f );
-			}
-			else
-			{
-				m_CurrentMenu = ARMOR8_MENUS::ADDITIONAL;
-				this->draw();
-			}
+			this->showMenu( ARMOR8_MENUS::ADDITIONAL );
 		}
 
 			break;
@@ -782,20 +601,7 @@ void ARMor8UiManager::onARMor8ParameterEvent (const ARMor8ParameterEvent& paramE
 			float attackExpoAmount = paramEvent.getValue();
 			this->updateAttackExpoStr( attackExpoAmount, buffer, bufferLen );
 
-			if ( m_CurrentMenu == ARMOR8_MENUS::ADDITIONAL )
-			{
-				m_Graphics->setColor( false );
-				m_Graphics->drawBoxFilled( 0.0f, 0.16f, 0.6f, 0.26f );
-				m_Graphics->setColor( true );
-				m_Graphics->drawText( -0.02f, 0.16f, m_AttackExpoStr, 1.0f );
-
-				this->publishPartialLCDRefreshEvent( 0.0f, 0.16f, 0.6f, 0.26f );
-			}
-			else
-			{
-				m_CurrentMenu = ARMOR8_MENUS::ADDITIONAL;
-				this->draw();
-			}
+			this->showMenu( ARMOR8_MENUS::ADDITIONAL );
 		}
 
 			break;
@@ -804,20 +610,7 @@ void ARMor8UiManager::onARMor8ParameterEvent (const ARMor8ParameterEvent& paramE
 			float decayExpoAmount = paramEvent.getValue();
 			this->updateDecayExpoStr( decayExpoAmount, buffer, bufferLen );
 
-			if ( m_CurrentMenu == ARMOR8_MENUS::ADDITIONAL )
-			{
-				m_Graphics->setColor( false );
-				m_Graphics->drawBoxFilled( 0.0f, 0.3f, 0.6f, 0.4 );
-				m_Graphics->setColor( true );
-				m_Graphics->drawText( -0.02f, 0.30f, m_DecayExpoStr, 1.0f );
-
-				this->publishPartialLCDRefreshEvent( 0.0f, 0.3f, 0.6f, 0.4f );
-			}
-			else
-			{
-				m_CurrentMenu = ARMOR8_MENUS::ADDITIONAL;
-				this->draw();
-			}
+			this->showMenu( ARMOR8_MENUS::ADDITIONAL );
 		}
 
 			break;
@@ -826,20 +619,7 @@ void ARMor8UiManager::onARMor8ParameterEvent (const ARMor8ParameterEvent& paramE
 			float releaseExpoAmount = paramEvent.getValue();
 			this->updateReleaseExpoStr( releaseExpoAmount, buffer, bufferLen );
 
-			if ( m_CurrentMenu == ARMOR8_MENUS::ADDITIONAL )
-			{
-				m_Graphics->setColor( false );
-				m_Graphics->drawBoxFilled( 0.0f, 0.42f, 0.6f, 0.52f );
-				m_Graphics->setColor( true );
-				m_Graphics->drawText( -0.02f, 0.42f, m_ReleaseExpoStr, 1.0f );
-
-				this->publishPartialLCDRefreshEvent( 0.0f, 0.42f, 0.6f, 0.52f );
-			}
-			else
-			{
-				m_CurrentMenu = ARMOR8_MENUS::ADDITIONAL;
-				this->draw();
-			}
+			this->showMenu( ARMOR8_MENUS::ADDITIONAL );
 		}
 
 			break;
@@ -848,20 +628,7 @@ void ARMor8UiManager::onARMor8ParameterEvent (const ARMor8ParameterEvent& paramE
 			float amplitudeVelAmount = paramEvent.getValue();
 			this->updateAmplitudeVelStr( amplitudeVelAmount, buffer, bufferLen );
 
-			if ( m_CurrentMenu == ARMOR8_MENUS::ADDITIONAL )
-			{
-				m_Graphics->setColor( false );
-				m_Graphics->drawBoxFilled( 0.0f, 0.6f, 0.6f, 0.7f );
-				m_Graphics->setColor( true );
-				m_Graphics->drawText( -0.02f, 0.60f, m_AmplitudeVelStr, 1.0f );
-
-				this->publishPartialLCDRefreshEvent( 0.0f, 0.6f, 0.6f, 0.7f );
-			}
-			else
-			{
-				m_CurrentMenu = ARMOR8_MENUS::ADDITIONAL;
-				this->draw();
-			}
+			this->showMenu( ARMOR8_MENUS::ADDITIONAL );
 		}
 
 			break;
@@ -870,20 +637,7 @@ void ARMor8UiManager::onARMor8ParameterEvent (const ARMor8ParameterEvent& paramE
 			float filterVelAmount = paramEvent.getValue();
 			this->updateFilterVelStr( filterVelAmount, buffer, bufferLen );
 
-			if ( m_CurrentMenu == ARMOR8_MENUS::ADDITIONAL )
-			{
-				m_Graphics->setColor( false );
-				m_Graphics->drawBoxFilled( 0.0f, 0.72f, 0.6f, 0.81f );
-				m_Graphics->setColor( true );
-				m_Graphics->drawText( -0.02f, 0.72f, m_FiltVelStr, 1.0f );
-
-				this->publishPartialLCDRefreshEvent( 0.0f, 0.72f, 0.6f, 0.81f );
-			}
-			else
-			{
-				m_CurrentMenu = ARMOR8_MENUS::ADDITIONAL;
-				this->draw();
-			}
+			this->showMenu( ARMOR8_MENUS::ADDITIONAL );
 		}
 
 			break;
@@ -892,20 +646,7 @@ void ARMor8UiManager::onARMor8ParameterEvent (const ARMor8ParameterEvent& paramE
 			float glideTimeAmount = paramEvent.getValue();
 			this->updateGlideStr( glideTimeAmount, buffer, bufferLen );
 
-			if ( m_CurrentMenu == ARMOR8_MENUS::ADDITIONAL )
-			{
-				m_Graphics->setColor( false );
-				m_Graphics->drawBoxFilled( 0.03f, 0.83f, 0.97f, 0.92f );
-				m_Graphics->setColor( true );
-				m_Graphics->drawText( 0.03f, 0.83f, m_GlideStr, 1.0f );
-
-				this->publishPartialLCDRefreshEvent( 0.03f, 0.83f, 0.97f, 0.92f );
-			}
-			else
-			{
-				m_CurrentMenu = ARMOR8_MENUS::ADDITIONAL;
-				this->draw();
-			}
+			this->showMenu( ARMOR8_MENUS::ADDITIONAL );
 		}
 
 			break;
@@ -916,20 +657,7 @@ void ARMor8UiManager::onARMor8ParameterEvent (const ARMor8ParameterEvent& paramE
 			int pitchBendAmountInt = static_cast<int>( pitchBendAmountUInt );
 			this->updatePitchBendStr( pitchBendAmountInt, buffer, bufferLen );
 
-			if ( m_CurrentMenu == ARMOR8_MENUS::ADDITIONAL )
-			{
-				m_Graphics->setColor( false );
-				m_Graphics->drawBoxFilled( 0.03f, 0.93f, 0.97f, 1.0f );
-				m_Graphics->setColor( true );
-				m_Graphics->drawText( 0.03f, 0.93f, m_PitchBendStr, 1.0f );
-
-				this->publishPartialLCDRefreshEvent( 0.03f, 0.93f, 0.97f, 1.0f );
-			}
-			else
-			{
-				m_CurrentMenu = ARMOR8_MENUS::ADDITIONAL;
-				this->draw();
-			}
+			this->showMenu( ARMOR8_MENUS::ADDITIONAL );
 		}
 
 			break;
@@ -938,20 +666,7 @@ void ARMor8UiManager::onARMor8ParameterEvent (const ARMor8ParameterEvent& paramE
 			float filtResAmount = paramEvent.getValue();
 			this->updateFiltResStr( filtResAmount, buffer, bufferLen );
 
-			if ( m_CurrentMenu == ARMOR8_MENUS::ADDITIONAL )
-			{
-				m_Graphics->setColor( false );
-				m_Graphics->drawBoxFilled( 0.71f, 0.3f, 0.93f, 0.4f );
-				m_Graphics->setColor( true );
-				m_Graphics->drawText( 0.71f, 0.3f, m_FiltResStr, 1.0f );
-
-				this->publishPartialLCDRefreshEvent( 0.71f, 0.3f, 0.93f, 0.4f );
-			}
-			else
-			{
-				m_CurrentMenu = ARMOR8_MENUS::ADDITIONAL;
-				this->draw();
-			}
+			this->showMenu( ARMOR8_MENUS::ADDITIONAL );
 		}
 
 			break;
@@ -1487,14 +1202,38 @@ void ARMor8UiManager::updateEGDestState()
 	}
 }
 
-void ARMor8UiManager::publishPartialLCDRefreshEvent (float xStart, float yStart, float xEnd, float yEnd)
+void ARMor8UiManager::queueLCDRefresh (float xStart, float yStart, float xEnd, float yEnd)
 {
 	unsigned int xStartUInt = m_Graphics->convertXPercentageToUInt( xStart );
 	unsigned int yStartUInt = m_Graphics->convertYPercentageToUInt( yStart );
 	unsigned int xEndUInt   = m_Graphics->convertXPercentageToUInt( xEnd   );
 	unsigned int yEndUInt   = m_Graphics->convertYPercentageToUInt( yEnd   );
 
-	IARMor8LCDRefreshEventListener::PublishEvent( ARMor8LCDRefreshEvent(xStartUInt, yStartUInt, xEndUInt, yEndUInt, 0) );
+	m_LCDRefreshAggregator.addRect( xStartUInt, yStartUInt, xEndUInt, yEndUInt );
+}
+
+void ARMor8UiManager::setWidget (const ARMOR8_WIDGETS& widget, const ARMOR8_MENUS& menu, const char* text, float textX,
+					float textY, float xStart, float yStart, float xEnd, float yEnd)
+{
+	ARMor8UiWidget& uiWidget = m_Widgets[static_cast<unsigned int>( widget )];
+
+	uiWidget.menu = menu;
+	uiWidget.text = text;
+	uiWidget.textX = textX;
+	uiWidget.textY = textY;
+	uiWidget.box = ARMor8UiRect{ xStart, yStart, xEnd, yEnd };
+	uiWidget.dirty = true;
+}
+
+void ARMor8UiManager::markWidgetDirty (const ARMOR8_WIDGETS& widget)
+{
+	m_Widgets[static_cast<unsigned int>( widget )].dirty = true;
+}
+
+void ARMor8UiManager::showMenu (const ARMOR8_MENUS& menu)
+{
+	m_CurrentMenu = menu;
+	this->draw();
 }
 
 void ARMor8UiManager::lockAllPots()
@@ -1545,12 +1284,14 @@ void ARMor8UiManager::updateOpNumberStr (char* buffer, unsigned int bufferLen)
 {
 	this->intToCString( m_OpCurrentlyBeingEdited, buffer, bufferLen );
 	this->concatDigitStr( m_OpCurrentlyBeingEdited, buffer, m_PrstAndOpStr, 15, 1 );
+	this->markWidgetDirty( ARMOR8_WIDGETS::PRST_AND_OP );
 }
 
 void ARMor8UiManager::updatePrstNumberStr (char* buffer, unsigned int bufferLen)
 {
 	this->intToCString( m_CurrentPresetNum, buffer, bufferLen );
 	this->concatDigitStr( m_CurrentPresetNum, buffer, m_PrstAndOpStr, 7, 2 );
+	this->markWidgetDirty( ARMOR8_WIDGETS::PRST_AND_OP );
 }
 
 void ARMor8UiManager::updateMonoPolyStr()
@@ -1569,6 +1310,7 @@ void ARMor8UiManager::updateMonoPolyStr()
 		m_MonoPolyStr[3] = 'L';
 		m_MonoPolyStr[4] = 'Y';
 	}
+	this->markWidgetDirty( ARMOR8_WIDGETS::MONO_POLY );
 }
 
 void ARMor8UiManager::updateWaveStr()
@@ -1601,6 +1343,7 @@ void ARMor8UiManager::updateWaveStr()
 		m_WaveStr[2] = 'W';
 		m_WaveStr[3] = ' ';
 	}
+	this->markWidgetDirty( ARMOR8_WIDGETS::WAVE );
 }
 
 void ARMor8UiManager::updateRatioFixedStr()
@@ -1621,6 +1364,7 @@ void ARMor8UiManager::updateRatioFixedStr()
 		m_RatioFixedStr[4] = 'E';
 		m_RatioFixedStr[5] = 'D';
 	}
+	this->markWidgetDirty( ARMOR8_WIDGETS::RATIO_FIXED );
 }
 
 void ARMor8UiManager::updateAmplitudeStr (float amplitude, char* buffer, unsigned int bufferLen)
@@ -1628,6 +1372,7 @@ void ARMor8UiManager::updateAmplitudeStr (float amplitude, char* buffer, unsigne
 	int amplitudeInt = static_cast<int>( amplitude * 1000.0f );
 	this->intToCString( amplitudeInt, buffer, bufferLen );
 	this->concatDigitStr( amplitudeInt, buffer, m_OpAmpStr, 6, 5, 2 );
+	this->markWidgetDirty( ARMOR8_WIDGETS::AMPLITUDE );
 }
 
 void ARMor8UiManager::updateFrequencyStr (float frequency, char* buffer, unsigned int bufferLen)
@@ -1705,6 +1450,7 @@ void ARMor8UiManager::updateFrequencyStr (float frequency, char* buffer, unsigne
 		this->intToCString( frequencyInt, buffer, bufferLen );
 		this->concatDigitStr( frequencyInt, buffer, m_FreqStr, 6, 5 );
 	}
+	this->markWidgetDirty( ARMOR8_WIDGETS::FREQUENCY );
 }
 
 void ARMor8UiManager::updateFiltFreqStr (float filtFrequency, char* buffer, unsigned int bufferLen)
@@ -1712,6 +1458,7 @@ void ARMor8UiManager::updateFiltFreqStr (float filtFrequency, char* buffer, unsi
 	int filtFreqInt = static_cast<int>( filtFrequency );
 	this->intToCString( filtFreqInt, buffer, bufferLen );
 	this->concatDigitStr( filtFreqInt, buffer, m_FiltFreqStr, 6, 5 );
+	this->markWidgetDirty( ARMOR8_WIDGETS::FILT_FREQ );
 }
 
 void ARMor8UiManager::updateOpModStr (unsigned int opNum, float opModAmount, char* buffer, unsigned int bufferLen, bool div)
@@ -1745,6 +1492,11 @@ void ARMor8UiManager::updateOpModStr (unsigned int opNum, float opModAmount, cha
 		this->intToCString( op4ModAmountInt, buffer, bufferLen );
 		this->concatDigitStr( op4ModAmountInt, buffer, m_Op4Str, 4, 5, 2 );
 	}
+
+	if ( opNum >= 1 && opNum <= 4 )
+	{
+		this->markWidgetDirty( static_cast<ARMOR8_WIDGETS>(static_cast<unsigned int>(ARMOR8_WIDGETS::OP1_MOD) + opNum - 1) );
+	}
 }
 
 void ARMor8UiManager::updateAttackStr (float attackAmount, char* buffer, unsigned int bufferLen)
@@ -1752,6 +1504,7 @@ void ARMor8UiManager::updateAttackStr (float attackAmount, char* buffer, unsigne
 	int attackAmountInt = static_cast<int>( attackAmount * 1000.0f );
 	this->intToCString( attackAmountInt, buffer, bufferLen );
 	this->concatDigitStr( attackAmountInt, buffer, m_AttackStr, 4, 5, 2 );
+	this->markWidgetDirty( ARMOR8_WIDGETS::ATTACK );
 }
 
 void ARMor8UiManager::updateDecayStr (float decayAmount, char* buffer, unsigned int bufferLen)
@@ -1759,6 +1512,7 @@ void ARMor8UiManager::updateDecayStr (float decayAmount, char* buffer, unsigned
 	int decayAmountInt = static_cast<int>( decayAmount * 1000.0f );
 	this->intToCString( decayAmountInt, buffer, bufferLen );
 	this->concatDigitStr( decayAmountInt, buffer, m_DecayStr, 4, 5, 2 );
+	this->markWidgetDirty( ARMOR8_WIDGETS::DECAY );
 }
 
 void ARMor8UiManager::updateSustainStr (float sustainAmount, char* buffer, unsigned int bufferLen)
@@ -1766,6 +1520,7 @@ void ARMor8UiManager::updateSustainStr (float sustainAmount, char* buffer, unsig
 	int sustainAmountInt = static_cast<int>( sustainAmount * 1000.0f );
 	this->intToCString( sustainAmountInt, buffer, bufferLen );
 	this->concatDigitStr( sustainAmountInt, buffer, m_SustainStr, 4, 5, 2 );
+	this->markWidgetDirty( ARMOR8_WIDGETS::SUSTAIN );
 }
 
 void ARMor8UiManager::updateReleaseStr (float releaseAmount, char* buffer, unsigned int bufferLen)
@@ -1773,12 +1528,14 @@ void ARMor8UiManager::updateReleaseStr (float releaseAmount, char* buffer, unsig
 	int releaseAmountInt = static_cast<int>( releaseAmount * 1000.0f );
 	this->intToCString( releaseAmountInt, buffer, bufferLen );
 	this->concatDigitStr( releaseAmountInt, buffer, m_ReleaseStr, 4, 5, 2 );
+	this->markWidgetDirty( ARMOR8_WIDGETS::RELEASE );
 }
 
 void ARMor8UiManager::updateDetuneStr (int detuneAmount, char* buffer, unsigned int bufferLen)
 {
 	this->intToCString( detuneAmount, buffer, bufferLen );
 	this->concatDigitStr( detuneAmount, buffer, m_DetuneStr, 7, 5 );
+	this->markWidgetDirty( ARMOR8_WIDGETS::DETUNE );
 }
 
 void ARMor8UiManager::updateAttackExpoStr (float attackExpoAmount, char* buffer, unsigned int bufferLen)
@@ -1787,6 +1544,7 @@ void ARMor8UiManager::updateAttackExpoStr (float attackExpoAmount, char* buffer,
 	int attackExpoAmountInt = static_cast<int>( attackExpoAmount * 100.0f );
 	this->intToCString( attackExpoAmountInt, buffer, bufferLen );
 	this->concatDigitStr( attackExpoAmountInt, buffer, m_AttackExpoStr, 7, 4, 2 );
+	this->markWidgetDirty( ARMOR8_WIDGETS::ATTACK_EXPO );
 }
 
 void ARMor8UiManager::updateDecayExpoStr (float decayExpoAmount, char* buffer, unsigned int bufferLen)
@@ -1795,6 +1553,7 @@ void ARMor8UiManager::updateDecayExpoStr (float decayExpoAmount, char* buffer, u
 	int decayExpoAmountInt = static_cast<int>( decayExpoAmount * 100.0f );
 	this->intToCString( decayExpoAmountInt, buffer, bufferLen );
 	this->concatDigitStr( decayExpoAmountInt, buffer, m_DecayExpoStr, 7, 4, 2 );
+	this->markWidgetDirty( ARMOR8_WIDGETS::DECAY_EXPO );
 }
 
 void ARMor8UiManager::updateReleaseExpoStr (float releaseExpoAmount, char* buffer, unsigned int bufferLen)
@@ -1803,6 +1562,7 @@ void ARMor8UiManager::updateReleaseExpoStr (float releaseExpoAmount, char* buffe
 	int releaseExpoAmountInt = static_cast<int>( releaseExpoAmount * 100.0f );
 	this->intToCString( releaseExpoAmountInt, buffer, bufferLen );
 	this->concatDigitStr( releaseExpoAmountInt, buffer, m_ReleaseExpoStr, 7, 4, 2 );
+	this->markWidgetDirty( ARMOR8_WIDGETS::RELEASE_EXPO );
 }
 
 void ARMor8UiManager::updateAmplitudeVelStr (float amplitudeVelAmount, char* buffer, unsigned int bufferLen)
@@ -1810,6 +1570,7 @@ void ARMor8UiManager::updateAmplitudeVelStr (float amplitudeVelAmount, char* buf
 	int amplitudeVelAmountInt = static_cast<int>( amplitudeVelAmount * 100.0f );
 	this->intToCString( amplitudeVelAmountInt, buffer, bufferLen );
 	this->concatDigitStr( amplitudeVelAmountInt, buffer, m_AmplitudeVelStr, 7, 4, 2 );
+	this->markWidgetDirty( ARMOR8_WIDGETS::AMP_VEL );
 }
 
 void ARMor8UiManager::updateFilterVelStr (float filterVelAmount, char* buffer, unsigned int bufferLen)
@@ -1817,6 +1578,7 @@ void ARMor8UiManager::updateFilterVelStr (float filterVelAmount, char* buffer, u
 	int filterVelAmountInt = static_cast<int>( filterVelAmount * 100.0f );
 	this->intToCString( filterVelAmountInt, buffer, bufferLen );
 	this->concatDigitStr( filterVelAmountInt, buffer, m_FiltVelStr, 7, 4, 2 );
+	this->markWidgetDirty( ARMOR8_WIDGETS::FILT_VEL );
 }
 
 void ARMor8UiManager::updateGlideStr (float glideAmount, char* buffer, unsigned int bufferLen)
@@ -1824,6 +1586,7 @@ void ARMor8UiManager::updateGlideStr (float glideAmount, char* buffer, unsigned
 	int glideAmountInt = static_cast<int>( glideAmount * 1000.0f );
 	this->intToCString( glideAmountInt, buffer, bufferLen );
 	this->concatDigitStr( glideAmountInt, buffer, m_GlideStr, 12, 5, 2 );
+	this->markWidgetDirty( ARMOR8_WIDGETS::GLIDE_TIME );
 }
 
 void ARMor8UiManager::updatePitchBendStr (unsigned int pitchBendAmount, char* buffer, unsigned int bufferLen)
@@ -1831,6 +1594,7 @@ void ARMor8UiManager::updatePitchBendStr (unsigned int pitchBendAmount, char* bu
 	int pitchBendAmountInt = static_cast<int>( pitchBendAmount );
 	this->intToCString( pitchBendAmountInt, buffer, bufferLen );
 	this->concatDigitStr( pitchBendAmountInt, buffer, m_PitchBendStr, 15, 2 );
+	this->markWidgetDirty( ARMOR8_WIDGETS::PITCH_BEND );
 }
 
 void ARMor8UiManager::updateFiltResStr (float filtResAmount, char* buffer, unsigned int bufferLen)
@@ -1839,137 +1603,37 @@ void ARMor8UiManager::updateFiltResStr (float filtResAmount, char* buffer, unsig
 	int filtResAmountInt = static_cast<int>( filtResAmount * 100.0f );
 	this->intToCString( filtResAmountInt, buffer, bufferLen );
 	this->concatDigitStr( filtResAmountInt, buffer, m_FiltResStr, 0, 4, 2 );
+	this->markWidgetDirty( ARMOR8_WIDGETS::FILT_RES );
 }
 
 void ARMor8UiManager::refreshEGDest()
 {
-	if ( m_CurrentMenu == ARMOR8_MENUS::STATUS )
-	{
-		m_Graphics->setColor( false );
-		m_Graphics->drawBoxFilled( 0.92f, 0.64f, 1.0f, 0.9f );
-		m_Graphics->setColor( true );
-
-		// eg destination amplitude
-		if ( m_EGDestBitmask & 0b100 )
-		{
-			m_Graphics->drawCircle( 0.96f, 0.67f, 0.02f );
-			m_Graphics->drawCircleFilled( 0.96f, 0.67f, 0.02f );
-		}
-		else
-		{
-			m_Graphics->drawCircle( 0.96f, 0.67f, 0.02f );
-		}
-
-		// eg destination frequency
-		if ( m_EGDestBitmask & 0b010 )
-		{
-			m_Graphics->drawCircle( 0.96f, 0.77f, 0.02f );
-			m_Graphics->drawCircleFilled( 0.96f, 0.77f, 0.02f );
-		}
-		else
-		{
-			m_Graphics->drawCircle( 0.96f, 0.77f, 0.02f );
-		}
-
-		// eg destination filter
-		if ( m_EGDestBitmask & 0b001 )
-		{
-			m_Graphics->drawCircle( 0.96f, 0.87f, 0.02f );
-			m_Graphics->drawCircleFilled( 0.96f, 0.87f, 0.02f );
-		}
-		else
-		{
-			m_Graphics->drawCircle( 0.96f, 0.87f, 0.02f );
-		}
-
-		this->publishPartialLCDRefreshEvent( 0.92f, 0.64f, 1.0f, 0.9f );
-	}
-	else
-	{
-		m_CurrentMenu = ARMOR8_MENUS::STATUS;
-		this->draw();
-	}
+	this->markWidgetDirty( ARMOR8_WIDGETS::EG_DEST );
+	this->showMenu( ARMOR8_MENUS::STATUS );
 }
 
 void ARMor8UiManager::refreshRatioFixed()
 {
-	if ( m_CurrentMenu == ARMOR8_MENUS::STATUS )
-	{
-		m_Graphics->setColor( false );
-		m_Graphics->drawBoxFilled( 0.625f, 0.93f, 1.0f, 1.0f );
-		m_Graphics->setColor( true );
-		m_Graphics->drawText( 0.625f, 0.93f, m_RatioFixedStr, 1.0f );
-
-		this->publishPartialLCDRefreshEvent( 0.625f, 0.93f, 1.0f, 1.0f );
-	}
-	else
-	{
-		m_CurrentMenu = ARMOR8_MENUS::STATUS;
-		this->draw();
-	}
+	this->markWidgetDirty( ARMOR8_WIDGETS::RATIO_FIXED );
+	this->showMenu( ARMOR8_MENUS::STATUS );
 }
 
 void ARMor8UiManager::refreshMonoPoly()
 {
-	if ( m_CurrentMenu == ARMOR8_MENUS::STATUS )
-	{
-		m_Graphics->setColor( false );
-		m_Graphics->drawBoxFilled( 0.0f, 0.93f, 0.4f, 1.0f );
-		m_Graphics->setColor( true );
-		m_Graphics->drawText( 0.0f, 0.93f, m_MonoPolyStr, 1.0f );
-
-		this->publishPartialLCDRefreshEvent( 0.0f, 0.93f, 0.4f, 1.0f );
-	}
-	else
-	{
-		m_CurrentMenu = ARMOR8_MENUS::STATUS;
-		this->draw();
-	}
+	this->markWidgetDirty( ARMOR8_WIDGETS::MONO_POLY );
+	this->showMenu( ARMOR8_MENUS::STATUS );
 }
 
 void ARMor8UiManager::refreshWave()
 {
-	if ( m_CurrentMenu == ARMOR8_MENUS::STATUS )
-	{
-		m_Graphics->setColor( false );
-		m_Graphics->drawBoxFilled( 0.37f, 0.94f, 0.63f, 1.0f );
-		m_Graphics->setColor( true );
-		m_Graphics->drawText( 0.37f, 0.94f, m_WaveStr, 1.0f );
-
-		this->publishPartialLCDRefreshEvent( 0.37f, 0.94f, 0.63f, 1.0f );
-	}
-	else
-	{
-		m_CurrentMenu = ARMOR8_MENUS::STATUS;
-		this->draw();
-	}
+	this->markWidgetDirty( ARMOR8_WIDGETS::WAVE );
+	this->showMenu( ARMOR8_MENUS::STATUS );
 }
 
 void ARMor8UiManager::refreshGlideRetrig()
 {
-	if ( m_CurrentMenu == ARMOR8_MENUS::ADDITIONAL )
-	{
-		m_Graphics->setColor( false );
-		m_Graphics->drawBoxFilled( 0.76f, 0.63f, 0.86f, 0.75f );
-
-		m_Graphics->setColor( true );
-		if ( m_UsingGlideRetrigger )
-		{
-			m_Graphics->drawCircle( 0.81f, 0.67f, 0.03f );
-			m_Graphics->drawCircleFilled( 0.81f, 0.67f, 0.03f );
-		}
-		else
-		{
-			m_Graphics->drawCircle( 0.81f, 0.67f, 0.03f );
-		}
-
-		this->publishPartialLCDRefreshEvent( 0.76f, 0.63f, 0.86f, 0.75f );
-	}
-	else
-	{
-		m_CurrentMenu = ARMOR8_MENUS::ADDITIONAL;
-		this->draw();
-	}
+	this->markWidgetDirty( ARMOR8_WIDGETS::GLIDE_RETRIG );
+	this->showMenu( ARMOR8_MENUS::ADDITIONAL );
 }
 
 void ARMor8UiManager::intToCString (int val, char* buffer, unsigned int bufferLen)
@@ -1,6 +1,10 @@
 #include "ARMor8Voice.hpp"
 
 #include "IEnvelopeGenerator.hpp"
+#include "ARMor8Constants.hpp"
+#include "AudioConstants.hpp"
+
+#include <cmath>
 
 const unsigned int numOps = 4;
 
@@ -35,12 +39,28 @@ ARMor8Voice::ARMor8Voice() :
 	m_Op3 (&m_Osc3, &m_Eg3, &m_Filt3, 1.0f, 1000.0f),
 	m_Op4 (&m_Osc4, &m_Eg4, &m_Filt4, 1.0f, 1000.0f),
 	m_Operators { &m_Op1, &m_Op2, &m_Op3, &m_Op4 },
-	m_ActiveKeyEvent()
+	m_ActiveKeyEvent(),
+	m_StolenKeyEvent(),
+	m_StealFadeSamplesLeft( 0 ),
+	m_OutputLevel( 0.0f ),
+	m_LevelDecay( 0.0f ),
+	m_StealFadeLength( 1 ),
+	m_Decimator4xTo2x(),
+	m_Decimator2xTo1x(),
+	m_MaxOversamplingFactor( 1 ),
+	m_NextOversamplingFactor( 1 ),
+	m_OversamplingFactor( 1 ),
+	m_SampleRate( static_cast<float>(SAMPLE_RATE) ),
+	m_RateScale( 1.0f ),
+	m_PitchFactor( 1.0f ),
+	m_UnisonDetune( 0 )
 {
 	m_KeyEventServer.registerListener(&m_Op1);
 	m_KeyEventServer.registerListener(&m_Op2);
 	m_KeyEventServer.registerListener(&m_Op3);
 	m_KeyEventServer.registerListener(&m_Op4);
+
+	this->calculateOutputRateValues();
 }
 
 ARMor8Voice::~ARMor8Voice()
@@ -59,7 +79,7 @@ void ARMor8Voice::setOperatorDetune (unsigned int opNum, int cents)
 {
 	if (opNum < numOps)
 	{
-		m_Operators[opNum]->setDetune(cents);
+		m_Operators[opNum]->setDetune( this->scaleDetune(cents) );
 	}
 }
 
@@ -89,7 +109,7 @@ void ARMor8Voice::setOperatorEGAttack (unsigned int opNum, float seconds, float
 {
 	if (opNum < numOps)
 	{
-		( (ADSREnvelopeGenerator*) m_Operators[opNum]->getEnvelopeGenerator() )->setAttack(seconds, expo);
+		( (ADSREnvelopeGenerator*) m_Operators[opNum]->getEnvelopeGenerator() )->setAttack(this->scaleTime(seconds), expo);
 	}
 }
 
@@ -97,7 +117,7 @@ void ARMor8Voice::setOperatorEGDecay (unsigned int opNum, float seconds, float e
 {
 	if (opNum < numOps)
 	{
-		( (ADSREnvelopeGenerator*) m_Operators[opNum]->getEnvelopeGenerator() )->setDecay(seconds, expo);
+		( (ADSREnvelopeGenerator*) m_Operators[opNum]->getEnvelopeGenerator() )->setDecay(this->scaleTime(seconds), expo);
 	}
 }
 
@@ -113,7 +133,7 @@ void ARMor8Voice::setOperatorEGRelease (unsigned int opNum, float seconds, float
 {
 	if (opNum < numOps)
 	{
-		( (ADSREnvelopeGenerator*) m_Operators[opNum]->getEnvelopeGenerator() )->setRelease(seconds, expo);
+		( (ADSREnvelopeGenerator*) m_Operators[opNum]->getEnvelopeGenerator() )->setRelease(this->scaleTime(seconds), expo);
 	}
 }
 
@@ -136,11 +156,65 @@ void ARMor8Voice::setOperatorModulation (unsigned int sourceOpNum, unsigned int
 {
 	if (sourceOpNum < numOps && destOpNum < numOps)
 	{
-		m_Operators[destOpNum]->setModSourceAmplitude(m_Operators[sourceOpNum], modulationAmount);
+		m_Operators[destOpNum]->setModSourceAmplitude(m_Operators[sourceOpNum], this->scaleFrequency(modulationAmount));
 	}
 }
 
 float ARMor8Voice::nextSample()
+{
+	float output = this->renderDecimatedSample();
+
+	if ( m_StealFadeSamplesLeft > 0 )
+	{
+		m_StealFadeSamplesLeft--;
+		output *= static_cast<float>( m_StealFadeSamplesLeft ) / static_cast<float>( m_StealFadeLength );
+
+		if ( m_StealFadeSamplesLeft == 0 )
+		{
+			this->onKeyEvent( m_StolenKeyEvent );
+		}
+	}
+
+	float outputMagnitude = std::fabs( output );
+	m_OutputLevel *= m_LevelDecay;
+	if ( outputMagnitude > m_OutputLevel )
+	{
+		m_OutputLevel = outputMagnitude;
+	}
+	else if ( m_OutputLevel < ARMOR8_DENORMAL_THRESHOLD )
+	{
+		m_OutputLevel = 0.0f;
+	}
+
+	return output;
+}
+
+float ARMor8Voice::renderDecimatedSample()
+{
+	if ( m_OversamplingFactor == 2 )
+	{
+		float sample1 = this->renderSample();
+		float sample2 = this->renderSample();
+
+		return m_Decimator2xTo1x.processSamples( sample1, sample2 );
+	}
+	else if ( m_OversamplingFactor == 4 )
+	{
+		float sample1 = this->renderSample();
+		float sample2 = this->renderSample();
+		float sample3 = this->renderSample();
+		float sample4 = this->renderSample();
+
+		float halfRate1 = m_Decimator4xTo2x.processSamples( sample1, sample2 );
+		float halfRate2 = m_Decimator4xTo2x.processSamples( sample3, sample4 );
+
+		return m_Decimator2xTo1x.processSamples( halfRate1, halfRate2 );
+	}
+
+	return this->renderSample();
+}
+
+float ARMor8Voice::renderSample()
 {
 	float output = 0.0f;
 	output += m_Op1.nextSample();
@@ -153,18 +227,270 @@ float ARMor8Voice::nextSample()
 
 void ARMor8Voice::onKeyEvent (const KeyEvent& keyEvent)
 {
+	// a new event while a stolen voice is still fading out, so start the pending note first
+	if ( m_StealFadeSamplesLeft > 0 )
+	{
+		m_StealFadeSamplesLeft = 0;
+		this->onKeyEvent( m_StolenKeyEvent );
+	}
+
+	// only decide on oversampling for new notes on a silent voice (the level follower snaps to zero), so a voice that's
+	// still sounding never has its rate changed. this can be on the midi thread, so the switch itself waits for
+	// updateOversampling() on the audio thread
+	if ( keyEvent.pressed() == KeyPressedEnum::PRESSED && m_OutputLevel == 0.0f )
+	{
+		m_NextOversamplingFactor = this->calculateOversamplingFactor();
+	}
+
 	m_ActiveKeyEvent = keyEvent;
 	m_KeyEventServer.propagateKeyEvent(keyEvent);
 }
 
+void ARMor8Voice::setMaxOversamplingFactor (unsigned int maxOversamplingFactor)
+{
+	if ( maxOversamplingFactor >= 4 )
+	{
+		m_MaxOversamplingFactor = 4;
+	}
+	else if ( maxOversamplingFactor >= 2 )
+	{
+		m_MaxOversamplingFactor = 2;
+	}
+	else
+	{
+		m_MaxOversamplingFactor = 1;
+	}
+
+	// lowering the cap is picked up by the next updateOversampling()
+}
+
+unsigned int ARMor8Voice::getOversamplingFactor()
+{
+	return m_OversamplingFactor;
+}
+
+void ARMor8Voice::updateOversampling()
+{
+	unsigned int oversamplingFactor = m_NextOversamplingFactor;
+	if ( oversamplingFactor > m_MaxOversamplingFactor )
+	{
+		oversamplingFactor = m_MaxOversamplingFactor;
+	}
+
+	if ( oversamplingFactor != m_OversamplingFactor )
+	{
+		this->setOversamplingFactor( oversamplingFactor );
+	}
+}
+
+unsigned int ARMor8Voice::calculateOversamplingFactor()
+{
+	if ( m_MaxOversamplingFactor == 1 )
+	{
+		return 1;
+	}
+
+	// the summed modulation depth is a good enough estimate of how far the fm sidebands will spread
+	float modDepth = 0.0f;
+	for ( unsigned int destOp = 0; destOp < numOps; destOp++ )
+	{
+		for ( unsigned int sourceOp = 0; sourceOp < numOps; sourceOp++ )
+		{
+			modDepth += this->unscaleFrequency( m_Operators[destOp]->getModulationAmount(m_Operators[sourceOp]) );
+		}
+	}
+
+	if ( modDepth >= ARMOR8_OVERSAMPLING_4X_MOD_DEPTH && m_MaxOversamplingFactor >= 4 )
+	{
+		return 4;
+	}
+	else if ( modDepth >= ARMOR8_OVERSAMPLING_2X_MOD_DEPTH )
+	{
+		return 2;
+	}
+
+	return 1;
+}
+
+void ARMor8Voice::setSampleRate (float sampleRate)
+{
+	if ( sampleRate > 0.0f && sampleRate != m_SampleRate )
+	{
+		this->setRate( m_OversamplingFactor, sampleRate );
+
+		m_Decimator4xTo2x.reset();
+		m_Decimator2xTo1x.reset();
+	}
+}
+
+float ARMor8Voice::getSampleRate()
+{
+	return m_SampleRate;
+}
+
+void ARMor8Voice::setOversamplingFactor (unsigned int oversamplingFactor)
+{
+	// only a decimator that wasn't in use has stale history, the one still running carries on so there's no click
+	if ( m_OversamplingFactor < 2 )
+	{
+		m_Decimator2xTo1x.reset();
+	}
+	if ( m_OversamplingFactor < 4 )
+	{
+		m_Decimator4xTo2x.reset();
+	}
+
+	this->setRate( oversamplingFactor, m_SampleRate );
+}
+
+void ARMor8Voice::setRate (unsigned int oversamplingFactor, float sampleRate)
+{
+	// only the rate dependent values are read back unscaled and set again at the new rate, nothing else is touched
+	float attacks[numOps];
+	float decays[numOps];
+	float releases[numOps];
+	float filterFreqs[numOps];
+	float modAmounts[numOps][numOps];
+	for ( unsigned int op = 0; op < numOps; op++ )
+	{
+		attacks[op] = this->getOperatorAttack( op );
+		decays[op] = this->getOperatorDecay( op );
+		releases[op] = this->getOperatorRelease( op );
+		filterFreqs[op] = this->unscaleFrequency( m_Operators[op]->getFilterFreq() );
+
+		for ( unsigned int sourceOp = 0; sourceOp < numOps; sourceOp++ )
+		{
+			modAmounts[op][sourceOp] = this->unscaleFrequency( m_Operators[op]->getModulationAmount(m_Operators[sourceOp]) );
+		}
+	}
+	float glideTime = this->unscaleTime( m_Operators[0]->getGlideTime() );
+
+	m_OversamplingFactor = oversamplingFactor;
+	m_SampleRate = sampleRate;
+	m_RateScale = static_cast<float>( oversamplingFactor ) * sampleRate / static_cast<float>( SAMPLE_RATE );
+
+	for ( unsigned int op = 0; op < numOps; op++ )
+	{
+		this->setOperatorEGAttack( op, attacks[op], this->getOperatorAttackExpo(op) );
+		this->setOperatorEGDecay( op, decays[op], this->getOperatorDecayExpo(op) );
+		this->setOperatorEGRelease( op, releases[op], this->getOperatorReleaseExpo(op) );
+		this->setOperatorFilterFreq( op, filterFreqs[op] );
+
+		for ( unsigned int sourceOp = 0; sourceOp < numOps; sourceOp++ )
+		{
+			this->setOperatorModulation( sourceOp, op, modAmounts[op][sourceOp] );
+		}
+	}
+	this->setGlideTime( glideTime );
+
+	this->sendPitchFactor();
+	this->calculateOutputRateValues();
+}
+
+void ARMor8Voice::calculateOutputRateValues()
+{
+	// one pole decay for the output level follower, the voice allocator uses the level to find quiet voices
+	m_LevelDecay = std::exp( -1.0f / (ARMOR8_VOICE_LEVEL_DECAY_TIME * m_SampleRate) );
+	m_StealFadeLength = static_cast<unsigned int>( ARMOR8_VOICE_STEAL_FADE_TIME * m_SampleRate ) + 1;
+}
+
+void ARMor8Voice::setUnisonDetune (int cents)
+{
+	if ( cents == m_UnisonDetune )
+	{
+		return;
+	}
+
+	int opDetunes[numOps];
+	for ( unsigned int op = 0; op < numOps; op++ )
+	{
+		opDetunes[op] = this->unscaleDetune( m_Operators[op]->getDetune() );
+	}
+
+	m_UnisonDetune = cents;
+
+	for ( unsigned int op = 0; op < numOps; op++ )
+	{
+		m_Operators[op]->setDetune( this->scaleDetune(opDetunes[op]) );
+	}
+}
+
+int ARMor8Voice::getUnisonDetune()
+{
+	return m_UnisonDetune;
+}
+
+float ARMor8Voice::scaleTime (float seconds)
+{
+	return seconds * m_RateScale;
+}
+
+float ARMor8Voice::unscaleTime (float seconds)
+{
+	return seconds / m_RateScale;
+}
+
+float ARMor8Voice::scaleFrequency (float frequency)
+{
+	return frequency / m_RateScale;
+}
+
+float ARMor8Voice::unscaleFrequency (float frequency)
+{
+	return frequency * m_RateScale;
+}
+
+int ARMor8Voice::scaleDetune (int cents)
+{
+	return cents + m_UnisonDetune;
+}
+
+int ARMor8Voice::unscaleDetune (int cents)
+{
+	return cents - m_UnisonDetune;
+}
+
 void ARMor8Voice::onPitchEvent (const PitchEvent& pitchEvent)
 {
+	m_PitchFactor = pitchEvent.getPitchFactor();
+
+	this->sendPitchFactor();
+}
+
+void ARMor8Voice::sendPitchFactor()
+{
+	// the operators render at the oversampled rate but think it's SAMPLE_RATE, so every frequency they play has to be
+	// divided by the rate scale. the pitch factor multiplies all of them, so it's exact at any rate
+	PitchEvent scaledPitchEvent( m_PitchFactor / m_RateScale, 0 );
+
 	for (unsigned int op = 0; op < numOps; op++)
 	{
-		m_Operators[op]->onPitchEvent( pitchEvent );
+		m_Operators[op]->onPitchEvent( scaledPitchEvent );
+	}
+}
+
+void ARMor8Voice::stealForKeyEvent (const KeyEvent& keyEvent)
+{
+	if ( m_OutputLevel > ARMOR8_VOICE_STEAL_FADE_LEVEL )
+	{
+		// a previous steal that hasn't finished fading just gets its pending note replaced
+		m_StolenKeyEvent = keyEvent;
+		if ( m_StealFadeSamplesLeft == 0 )
+		{
+			m_StealFadeSamplesLeft = m_StealFadeLength;
+		}
+	}
+	else
+	{
+		this->onKeyEvent( keyEvent );
 	}
 }
 
+float ARMor8Voice::getOutputLevel()
+{
+	return m_OutputLevel;
+}
+
 const KeyEvent& ARMor8Voice::getActiveKeyEvent()
 {
 	return m_ActiveKeyEvent;
@@ -182,7 +508,7 @@ void ARMor8Voice::setOperatorFilterFreq (unsigned int opNum, float frequency)
 {
 	if (opNum < numOps)
 	{
-		m_Operators[opNum]->setFilterFreq(frequency);
+		m_Operators[opNum]->setFilterFreq( this->scaleFrequency(frequency) );
 	}
 }
 
@@ -230,7 +556,7 @@ void ARMor8Voice::setGlideTime (const float glideTime)
 {
 	for (unsigned int op = 0; op < numOps; op++)
 	{
-		m_Operators[op]->setGlideTime( glideTime );
+		m_Operators[op]->setGlideTime( this->scaleTime(glideTime) );
 	}
 }
 
@@ -309,13 +635,13 @@ float ARMor8Voice::getOperatorAttack (unsigned int opNum)
 	switch (opNum)
 	{
 		case 0:
-			return m_Eg1.getAttack();
+			return this->unscaleTime( m_Eg1.getAttack() );
 		case 1:
-			return m_Eg2.getAttack();
+			return this->unscaleTime( m_Eg2.getAttack() );
 		case 2:
-			return m_Eg3.getAttack();
+			return this->unscaleTime( m_Eg3.getAttack() );
 		case 3:
-			return m_Eg4.getAttack();
+			return this->unscaleTime( m_Eg4.getAttack() );
 		default:
 			return 0.0f;
 	}
@@ -326,13 +652,13 @@ float ARMor8Voice::getOperatorDecay (unsigned int opNum)
 	switch (opNum)
 	{
 		case 0:
-			return m_Eg1.getDecay();
+			return this->unscaleTime( m_Eg1.getDecay() );
 		case 1:
-			return m_Eg2.getDecay();
+			return this->unscaleTime( m_Eg2.getDecay() );
 		case 2:
-			return m_Eg3.getDecay();
+			return this->unscaleTime( m_Eg3.getDecay() );
 		case 3:
-			return m_Eg4.getDecay();
+			return this->unscaleTime( m_Eg4.getDecay() );
 		default:
 			return 0.0f;
 	}
@@ -343,13 +669,13 @@ float ARMor8Voice::getOperatorRelease (unsigned int opNum)
 	switch (opNum)
 	{
 		case 0:
-			return m_Eg1.getRelease();
+			return this->unscaleTime( m_Eg1.getRelease() );
 		case 1:
-			return m_Eg2.getRelease();
+			return this->unscaleTime( m_Eg2.getRelease() );
 		case 2:
-			return m_Eg3.getRelease();
+			return this->unscaleTime( m_Eg3.getRelease() );
 		case 3:
-			return m_Eg4.getRelease();
+			return this->unscaleTime( m_Eg4.getRelease() );
 		default:
 			return 0.0f;
 	}
@@ -433,104 +759,104 @@ ARMor8VoiceState ARMor8Voice::getState()
 	state.frequency1 = m_Op1.getFrequency();
 	state.useRatio1 = m_Op1.getRatio();
 	state.wave1 = m_Op1.getWave();
-	state.attack1 = m_Eg1.getAttack();
+	state.attack1 = this->unscaleTime( m_Eg1.getAttack() );
 	state.attackExpo1 = m_AtkResponse1.getSlope();
-	state.decay1 = m_Eg1.getDecay();
+	state.decay1 = this->unscaleTime( m_Eg1.getDecay() );
 	state.decayExpo1 = m_DecResponse1.getSlope();
 	state.sustain1 = m_Eg1.getSustain();
-	state.release1 = m_Eg1.getRelease();
+	state.release1 = this->unscaleTime( m_Eg1.getRelease() );
 	state.releaseExpo1 = m_RelResponse1.getSlope();
 	state.egAmplitudeMod1 = m_Op1.egModAmplitudeSet();
 	state.egFrequencyMod1 = m_Op1.egModFrequencySet();
 	state.egFilterMod1 = m_Op1.egModFilterSet();
-	state.op1ModAmount1 = m_Op1.getModulationAmount(&m_Op1);
-	state.op2ModAmount1 = m_Op1.getModulationAmount(&m_Op2);
-	state.op3ModAmount1 = m_Op1.getModulationAmount(&m_Op3);
-	state.op4ModAmount1 = m_Op1.getModulationAmount(&m_Op4);
+	state.op1ModAmount1 = this->unscaleFrequency( m_Op1.getModulationAmount(&m_Op1) );
+	state.op2ModAmount1 = this->unscaleFrequency( m_Op1.getModulationAmount(&m_Op2) );
+	state.op3ModAmount1 = this->unscaleFrequency( m_Op1.getModulationAmount(&m_Op3) );
+	state.op4ModAmount1 = this->unscaleFrequency( m_Op1.getModulationAmount(&m_Op4) );
 	state.amplitude1 = m_Op1.getAmplitude();
-	state.filterFreq1 = m_Op1.getFilterFreq();
+	state.filterFreq1 = this->unscaleFrequency( m_Op1.getFilterFreq() );
 	state.filterRes1 = m_Op1.getFilterRes();
 	state.ampVelSens1 = m_Op1.getAmpVelSens();
 	state.filtVelSens1 = m_Op1.getFiltVelSens();
-	state.detune1 = m_Op1.getDetune();
+	state.detune1 = this->unscaleDetune( m_Op1.getDetune() );
 
 	// operator 2 state
 	state.frequency2 = m_Op2.getFrequency();
 	state.useRatio2 = m_Op2.getRatio();
 	state.wave2 = m_Op2.getWave();
-	state.attack2 = m_Eg2.getAttack();
+	state.attack2 = this->unscaleTime( m_Eg2.getAttack() );
 	state.attackExpo2 = m_AtkResponse2.getSlope();
-	state.decay2 = m_Eg2.getDecay();
+	state.decay2 = this->unscaleTime( m_Eg2.getDecay() );
 	state.decayExpo2 = m_DecResponse2.getSlope();
 	state.sustain2 = m_Eg2.getSustain();
-	state.release2 = m_Eg2.getRelease();
+	state.release2 = this->unscaleTime( m_Eg2.getRelease() );
 	state.releaseExpo2 = m_RelResponse2.getSlope();
 	state.egAmplitudeMod2 = m_Op2.egModAmplitudeSet();
 	state.egFrequencyMod2 = m_Op2.egModFrequencySet();
 	state.egFilterMod2 = m_Op2.egModFilterSet();
-	state.op1ModAmount2 = m_Op2.getModulationAmount(&m_Op1);
-	state.op2ModAmount2 = m_Op2.getModulationAmount(&m_Op2);
-	state.op3ModAmount2 = m_Op2.getModulationAmount(&m_Op3);
-	state.op4ModAmount2 = m_Op2.getModulationAmount(&m_Op4);
+	state.op1ModAmount2 = this->unscaleFrequency( m_Op2.getModulationAmount(&m_Op1) );
+	state.op2ModAmount2 = this->unscaleFrequency( m_Op2.getModulationAmount(&m_Op2) );
+	state.op3ModAmount2 = this->unscaleFrequency( m_Op2.getModulationAmount(&m_Op3) );
+	state.op4ModAmount2 = this->unscaleFrequency( m_Op2.getModulationAmount(&m_Op4) );
 	state.amplitude2 = m_Op2.getAmplitude();
-	state.filterFreq2 = m_Op2.getFilterFreq();
+	state.filterFreq2 = this->unscaleFrequency( m_Op2.getFilterFreq() );
 	state.filterRes2 = m_Op2.getFilterRes();
 	state.ampVelSens2 = m_Op2.getAmpVelSens();
 	state.filtVelSens2 = m_Op2.getFiltVelSens();
-	state.detune2 = m_Op2.getDetune();
+	state.detune2 = this->unscaleDetune( m_Op2.getDetune() );
 
 	// operator 3 state
 	state.frequency3 = m_Op3.getFrequency();
 	state.useRatio3 = m_Op3.getRatio();
 	state.wave3 = m_Op3.getWave();
-	state.attack3 = m_Eg3.getAttack();
+	state.attack3 = this->unscaleTime( m_Eg3.getAttack() );
 	state.attackExpo3 = m_AtkResponse3.getSlope();
-	state.decay3 = m_Eg3.getDecay();
+	state.decay3 = this->unscaleTime( m_Eg3.getDecay() );
 	state.decayExpo3 = m_DecResponse3.getSlope();
 	state.sustain3 = m_Eg3.getSustain();
-	state.release3 = m_Eg3.getRelease();
+	state.release3 = this->unscaleTime( m_Eg3.getRelease() );
 	state.releaseExpo3 = m_RelResponse3.getSlope();
 	state.egAmplitudeMod3 = m_Op3.egModAmplitudeSet();
 	state.egFrequencyMod3 = m_Op3.egModFrequencySet();
 	state.egFilterMod3 = m_Op3.egModFilterSet();
-	state.op1ModAmount3 = m_Op3.getModulationAmount(&m_Op1);
-	state.op2ModAmount3 = m_Op3.getModulationAmount(&m_Op2);
-	state.op3ModAmount3 = m_Op3.getModulationAmount(&m_Op3);
-	state.op4ModAmount3 = m_Op3.getModulationAmount(&m_Op4);
+	state.op1ModAmount3 = this->unscaleFrequency( m_Op3.getModulationAmount(&m_Op1) );
+	state.op2ModAmount3 = this->unscaleFrequency( m_Op3.getModulationAmount(&m_Op2) );
+	state.op3ModAmount3 = this->unscaleFrequency( m_Op3.getModulationAmount(&m_Op3) );
+	state.op4ModAmount3 = this->unscaleFrequency( m_Op3.getModulationAmount(&m_Op4) );
 	state.amplitude3 = m_Op3.getAmplitude();
-	state.filterFreq3 = m_Op3.getFilterFreq();
+	state.filterFreq3 = this->unscaleFrequency( m_Op3.getFilterFreq() );
 	state.filterRes3 = m_Op3.getFilterRes();
 	state.ampVelSens3 = m_Op3.getAmpVelSens();
 	state.filtVelSens3 = m_Op3.getFiltVelSens();
-	state.detune3 = m_Op3.getDetune();
+	state.detune3 = this->unscaleDetune( m_Op3.getDetune() );
 
 	// operator 4 state
 	state.frequency4 = m_Op4.getFrequency();
 	state.useRatio4 = m_Op4.getRatio();
 	state.wave4 = m_Op4.getWave();
-	state.attack4 = m_Eg4.getAttack();
+	state.attack4 = this->unscaleTime( m_Eg4.getAttack() );
 	state.attackExpo4 = m_AtkResponse4.getSlope();
-	state.decay4 = m_Eg4.getDecay();
+	state.decay4 = this->unscaleTime( m_Eg4.getDecay() );
 	state.decayExpo4 = m_DecResponse4.getSlope();
 	state.sustain4 = m_Eg4.getSustain();
-	state.release4 = m_Eg4.getRelease();
+	state.release4 = this->unscaleTime( m_Eg4.getRelease() );
 	state.releaseExpo4 = m_RelResponse4.getSlope();
 	state.egAmplitudeMod4 = m_Op4.egModAmplitudeSet();
 	state.egFrequencyMod4 = m_Op4.egModFrequencySet();
 	state.egFilterMod4 = m_Op4.egModFilterSet();
-	state.op1ModAmount4 = m_Op4.getModulationAmount(&m_Op1);
-	state.op2ModAmount4 = m_Op4.getModulationAmount(&m_Op2);
-	state.op3ModAmount4 = m_Op4.getModulationAmount(&m_Op3);
-	state.op4ModAmount4 = m_Op4.getModulationAmount(&m_Op4);
+	state.op1ModAmount4 = this->unscaleFrequency( m_Op4.getModulationAmount(&m_Op1) );
+	state.op2ModAmount4 = this->unscaleFrequency( m_Op4.getModulationAmount(&m_Op2) );
+	state.op3ModAmount4 = this->unscaleFrequency( m_Op4.getModulationAmount(&m_Op3) );
+	state.op4ModAmount4 = this->unscaleFrequency( m_Op4.getModulationAmount(&m_Op4) );
 	state.amplitude4 = m_Op4.getAmplitude();
-	state.filterFreq4 = m_Op4.getFilterFreq();
+	state.filterFreq4 = this->unscaleFrequency( m_Op4.getFilterFreq() );
 	state.filterRes4 = m_Op4.getFilterRes();
 	state.ampVelSens4 = m_Op4.getAmpVelSens();
 	state.filtVelSens4 = m_Op4.getFiltVelSens();
-	state.detune4 = m_Op4.getDetune();
+	state.detune4 = this->unscaleDetune( m_Op4.getDetune() );
 
 	// global states
-	state.glideTime = m_Op1.getGlideTime();
+	state.glideTime = this->unscaleTime( m_Op1.getGlideTime() );
 	state.glideRetrigger = m_Op1.getGlideRetrigger();
 
 	return state;
@@ -543,10 +869,10 @@ void ARMor8Voice::setState (const ARMor8VoiceState& state)
 	m_Op1.setFrequency( state.frequency1 );
 	m_Op1.setRatio( state.useRatio1 );
 	m_Op1.setWave( state.wave1 );
-	m_Eg1.setAttack( state.attack1, state.attackExpo1 );
-	m_Eg1.setDecay( state.decay1, state.decayExpo1 );
+	m_Eg1.setAttack( this->scaleTime(state.attack1), state.attackExpo1 );
+	m_Eg1.setDecay( this->scaleTime(state.decay1), state.decayExpo1 );
 	m_Eg1.setSustain( state.sustain1 );
-	m_Eg1.setRelease( state.release1, state.releaseExpo1 );
+	m_Eg1.setRelease( this->scaleTime(state.release1), state.releaseExpo1 );
 	if (state.egAmplitudeMod1)
 	{
 		m_Op1.setEGModDestination( EGModDestination::AMPLITUDE, true );
@@ -571,26 +897,26 @@ void ARMor8Voice::setState (const ARMor8VoiceState& state)
 	{
 		m_Op1.setEGModDestination( EGModDestination::FILT_FREQUENCY, false );
 	}
-	m_Op1.setModSourceAmplitude( &m_Op1, state.op1ModAmount1 );
-	m_Op1.setModSourceAmplitude( &m_Op2, state.op2ModAmount1 );
-	m_Op1.setModSourceAmplitude( &m_Op3, state.op3ModAmount1 );
-	m_Op1.setModSourceAmplitude( &m_Op4, state.op4ModAmount1 );
+	m_Op1.setModSourceAmplitude( &m_Op1, this->scaleFrequency(state.op1ModAmount1) );
+	m_Op1.setModSourceAmplitude( &m_Op2, this->scaleFrequency(state.op2ModAmount1) );
+	m_Op1.setModSourceAmplitude( &m_Op3, this->scaleFrequency(state.op3ModAmount1) );
+	m_Op1.setModSourceAmplitude( &m_Op4, this->scaleFrequency(state.op4ModAmount1) );
 	m_Op1.setAmplitude( state.amplitude1 );
-	m_Op1.setFilterFreq( state.filterFreq1 );
+	m_Op1.setFilterFreq( this->scaleFrequency(state.filterFreq1) );
 	m_Op1.setFilterRes( state.filterRes1 );
 	m_Op1.setAmpVelSens( state.ampVelSens1 );
 	m_Op1.setFiltVelSens( state.filtVelSens1 );
-	m_Op1.setDetune( state.detune1 );
+	m_Op1.setDetune( this->scaleDetune(state.detune1) );
 
 	// operator 2 state
 	m_Op2.setUseGlide( true );
 	m_Op2.setFrequency( state.frequency2 );
 	m_Op2.setRatio( state.useRatio2 );
 	m_Op2.setWave( state.wave2 );
-	m_Eg2.setAttack( state.attack2, state.attackExpo2 );
-	m_Eg2.setDecay( state.decay2, state.decayExpo2 );
+	m_Eg2.setAttack( this->scaleTime(state.attack2), state.attackExpo2 );
+	m_Eg2.setDecay( this->scaleTime(state.decay2), state.decayExpo2 );
 	m_Eg2.setSustain( state.sustain2 );
-	m_Eg2.setRelease( state.release2, state.releaseExpo2 );
+	m_Eg2.setRelease( this->scaleTime(state.release2), state.releaseExpo2 );
 	if (state.egAmplitudeMod2)
 	{
 		m_Op2.setEGModDestination( EGModDestination::AMPLITUDE, true );
@@ -615,26 +941,26 @@ void ARMor8Voice::setState (const ARMor8VoiceState& state)
 	{
 		m_Op2.setEGModDestination( EGModDestination::FILT_FREQUENCY, false );
 	}
-	m_Op2.setModSourceAmplitude( &m_Op1, state.op1ModAmount2 );
-	m_Op2.setModSourceAmplitude( &m_Op2, state.op2ModAmount2 );
-	m_Op2.setModSourceAmplitude( &m_Op3, state.op3ModAmount2 );
-	m_Op2.setModSourceAmplitude( &m_Op4, state.op4ModAmount2 );
+	m_Op2.setModSourceAmplitude( &m_Op1, this->scaleFrequency(state.op1ModAmount2) );
+	m_Op2.setModSourceAmplitude( &m_Op2, this->scaleFrequency(state.op2ModAmount2) );
+	m_Op2.setModSourceAmplitude( &m_Op3, this->scaleFrequency(state.op3ModAmount2) );
+	m_Op2.setModSourceAmplitude( &m_Op4, this->scaleFrequency(state.op4ModAmount2) );
 	m_Op2.setAmplitude( state.amplitude2 );
-	m_Op2.setFilterFreq( state.filterFreq2 );
+	m_Op2.setFilterFreq( this->scaleFrequency(state.filterFreq2) );
 	m_Op2.setFilterRes( state.filterRes2 );
 	m_Op2.setAmpVelSens( state.ampVelSens2 );
 	m_Op2.setFiltVelSens( state.filtVelSens2 );
-	m_Op2.setDetune( state.detune2 );
+	m_Op2.setDetune( this->scaleDetune(state.detune2) );
 
 	// operator 3 state
 	m_Op3.setUseGlide( true );
 	m_Op3.setFrequency( state.frequency3 );
 	m_Op3.setRatio( state.useRatio3 );
 	m_Op3.setWave( state.wave3 );
-	m_Eg3.setAttack( state.attack3, state.attackExpo3 );
-	m_Eg3.setDecay( state.decay3, state.decayExpo3 );
+	m_Eg3.setAttack( this->scaleTime(state.attack3), state.attackExpo3 );
+	m_Eg3.setDecay( this->scaleTime(state.decay3), state.decayExpo3 );
 	m_Eg3.setSustain( state.sustain3 );
-	m_Eg3.setRelease( state.release3, state.releaseExpo3 );
+	m_Eg3.setRelease( this->scaleTime(state.release3), state.releaseExpo3 );
 	if (state.egAmplitudeMod3)
 	{
 		m_Op3.setEGModDestination( EGModDestination::AMPLITUDE, true );
@@ -659,26 +985,26 @@ void ARMor8Voice::setState (const ARMor8VoiceState& state)
 	{
 		m_Op3.setEGModDestination( EGModDestination::FILT_FREQUENCY, false );
 	}
-	m_Op3.setModSourceAmplitude( &m_Op1, state.op1ModAmount3 );
-	m_Op3.setModSourceAmplitude( &m_Op2, state.op2ModAmount3 );
-	m_Op3.setModSourceAmplitude( &m_Op3, state.op3ModAmount3 );
-	m_Op3.setModSourceAmplitude( &m_Op4, state.op4ModAmount3 );
+	m_Op3.setModSourceAmplitude( &m_Op1, this->scaleFrequency(state.op1ModAmount3) );
+	m_Op3.setModSourceAmplitude( &m_Op2, this->scaleFrequency(state.op2ModAmount3) );
+	m_Op3.setModSourceAmplitude( &m_Op3, this->scaleFrequency(state.op3ModAmount3) );
+	m_Op3.setModSourceAmplitude( &m_Op4, this->scaleFrequency(state.op4ModAmount3) );
 	m_Op3.setAmplitude( state.amplitude3 );
-	m_Op3.setFilterFreq( state.filterFreq3 );
+	m_Op3.setFilterFreq( this->scaleFrequency(state.filterFreq3) );
 	m_Op3.setFilterRes( state.filterRes3 );
 	m_Op3.setAmpVelSens( state.ampVelSens3 );
 	m_Op3.setFiltVelSens( state.filtVelSens3 );
-	m_Op3.setDetune( state.detune3 );
+	m_Op3.setDetune( this->scaleDetune(state.detune3) );
 
 	// operator 4 state
 	m_Op4.setUseGlide( true );
 	m_Op4.setFrequency( state.frequency4 );
 	m_Op4.setRatio( state.useRatio4 );
 	m_Op4.setWave( state.wave4 );
-	m_Eg4.setAttack( state.attack4, state.attackExpo4 );
-	m_Eg4.setDecay( state.decay4, state.decayExpo4 );
+	m_Eg4.setAttack( this->scaleTime(state.attack4), state.attackExpo4 );
+	m_Eg4.setDecay( this->scaleTime(state.decay4), state.decayExpo4 );
 	m_Eg4.setSustain( state.sustain4 );
-	m_Eg4.setRelease( state.release4, state.releaseExpo4 );
+	m_Eg4.setRelease( this->scaleTime(state.release4), state.releaseExpo4 );
 	if (state.egAmplitudeMod4)
 	{
 		m_Op4.setEGModDestination( EGModDestination::AMPLITUDE, true );
@@ -703,21 +1029,21 @@ void ARMor8Voice::setState (const ARMor8VoiceState& state)
 	{
 		m_Op4.setEGModDestination( EGModDestination::FILT_FREQUENCY, false );
 	}
-	m_Op4.setModSourceAmplitude( &m_Op1, state.op1ModAmount4 );
-	m_Op4.setModSourceAmplitude( &m_Op2, state.op2ModAmount4 );
-	m_Op4.setModSourceAmplitude( &m_Op3, state.op3ModAmount4 );
-	m_Op4.setModSourceAmplitude( &m_Op4, state.op4ModAmount4 );
+	m_Op4.setModSourceAmplitude( &m_Op1, this->scaleFrequency(state.op1ModAmount4) );
+	m_Op4.setModSourceAmplitude( &m_Op2, this->scaleFrequency(state.op2ModAmount4) );
+	m_Op4.setModSourceAmplitude( &m_Op3, this->scaleFrequency(state.op3ModAmount4) );
+	m_Op4.setModSourceAmplitude( &m_Op4, this->scaleFrequency(state.op4ModAmount4) );
 	m_Op4.setAmplitude( state.amplitude4 );
-	m_Op4.setFilterFreq( state.filterFreq4 );
+	m_Op4.setFilterFreq( this->scaleFrequency(state.filterFreq4) );
 	m_Op4.setFilterRes( state.filterRes4 );
 	m_Op4.setAmpVelSens( state.ampVelSens4 );
 	m_Op4.setFiltVelSens( state.filtVelSens4 );
-	m_Op4.setDetune( state.detune4 );
+	m_Op4.setDetune( this->scaleDetune(state.detune4) );
 
 	// global states
 	for (unsigned int op = 0; op < numOps; op++)
 	{
-		m_Operators[op]->setGlideTime( state.glideTime );
+		m_Operators[op]->setGlideTime( this->scaleTime(state.glideTime) );
 		m_Operators[op]->setGlideRetrigger( state.glideRetrigger );
 	}
 }
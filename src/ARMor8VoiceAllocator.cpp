@@ -0,0 +1,249 @@
+#include "ARMor8VoiceAllocator.hpp"
+
+#include "ARMor8Voice.hpp"
+#include "ARMor8Constants.hpp"
+
+ARMor8VoiceAllocator::ARMor8VoiceAllocator (ARMor8Voice** voices) :
+	m_Voices( voices ),
+	m_StealingStrategy( VOICE_STEALING_STRATEGY::RELEASING_FIRST ),
+	m_SameNoteReuse( true ),
+	m_TriggerCount( 0 ),
+	m_FreeHead( NO_VOICE ),
+	m_FreeTail( NO_VOICE ),
+	m_ActiveHead( NO_VOICE ),
+	m_ActiveTail( NO_VOICE )
+{
+	this->reset();
+}
+
+ARMor8VoiceAllocator::~ARMor8VoiceAllocator()
+{
+}
+
+void ARMor8VoiceAllocator::setStealingStrategy (const VOICE_STEALING_STRATEGY& strategy)
+{
+	m_StealingStrategy = strategy;
+}
+
+VOICE_STEALING_STRATEGY ARMor8VoiceAllocator::getStealingStrategy()
+{
+	return m_StealingStrategy;
+}
+
+void ARMor8VoiceAllocator::setSameNoteReuse (bool on)
+{
+	m_SameNoteReuse = on;
+}
+
+bool ARMor8VoiceAllocator::getSameNoteReuse()
+{
+	return m_SameNoteReuse;
+}
+
+unsigned int ARMor8VoiceAllocator::allocateVoice (unsigned int note, bool& needsFade)
+{
+	note = note % MIDI_NUM_NOTES;
+	needsFade = false;
+
+	int voice = m_NoteToVoice[note];
+
+	if ( voice != NO_VOICE ) // retriggering a note that's already sounding, so it becomes the newest
+	{
+		this->unlink( voice, m_ActiveHead, m_ActiveTail );
+	}
+	else
+	{
+		int releasedVoice = m_ReleasedNoteToVoice[note];
+		if ( m_SameNoteReuse && releasedVoice != NO_VOICE && m_VoiceToNote[releasedVoice] == NO_NOTE
+				&& m_LastNoteOfVoice[releasedVoice] == static_cast<int>(note) )
+		{
+			voice = releasedVoice;
+		}
+		else
+		{
+			// a held voice is only ever stolen when there are no free voices left
+			int queueHead = ( m_FreeHead != NO_VOICE ) ? m_FreeHead : m_ActiveHead;
+
+			if ( m_StealingStrategy == VOICE_STEALING_STRATEGY::OLDEST )
+			{
+				voice = this->findOldestVoice( queueHead );
+			}
+			else if ( m_StealingStrategy == VOICE_STEALING_STRATEGY::QUIETEST )
+			{
+				voice = this->findQuietestVoice( queueHead );
+			}
+			else // releasing first
+			{
+				voice = queueHead;
+			}
+		}
+
+		// take the voice out of whichever queue it's in, stealing it from its note if it's held
+		int stolenNote = m_VoiceToNote[voice];
+		if ( stolenNote != NO_NOTE )
+		{
+			this->unlink( voice, m_ActiveHead, m_ActiveTail );
+			m_NoteToVoice[stolenNote] = NO_VOICE;
+			needsFade = true;
+		}
+		else
+		{
+			this->unlink( voice, m_FreeHead, m_FreeTail );
+			needsFade = ( m_Voices[voice]->getOutputLevel() > ARMOR8_VOICE_STEAL_FADE_LEVEL );
+		}
+
+		// this voice won't be playing its last note's release tail anymore
+		int lastNote = m_LastNoteOfVoice[voice];
+		if ( lastNote != NO_NOTE && m_ReleasedNoteToVoice[lastNote] == voice )
+		{
+			m_ReleasedNoteToVoice[lastNote] = NO_VOICE;
+		}
+	}
+
+	m_NoteToVoice[note] = voice;
+	m_VoiceToNote[voice] = note;
+	m_LastNoteOfVoice[voice] = note;
+	m_VoiceTriggerTime[voice] = m_TriggerCount++;
+	this->pushBack( voice, m_ActiveHead, m_ActiveTail );
+
+	return static_cast<unsigned int>( voice );
+}
+
+int ARMor8VoiceAllocator::releaseNote (unsigned int note)
+{
+	note = note % MIDI_NUM_NOTES;
+
+	int voice = m_NoteToVoice[note];
+
+	if ( voice != NO_VOICE )
+	{
+		m_NoteToVoice[note] = NO_VOICE;
+		m_VoiceToNote[voice] = NO_NOTE;
+		m_ReleasedNoteToVoice[note] = voice;
+		this->unlink( voice, m_ActiveHead, m_ActiveTail );
+		this->pushBack( voice, m_FreeHead, m_FreeTail );
+	}
+
+	return voice;
+}
+
+int ARMor8VoiceAllocator::getVoiceForNote (unsigned int note)
+{
+	return m_NoteToVoice[note % MIDI_NUM_NOTES];
+}
+
+int ARMor8VoiceAllocator::getNoteForVoice (unsigned int voice)
+{
+	if ( voice < MAX_VOICES )
+	{
+		return m_VoiceToNote[voice];
+	}
+
+	return NO_NOTE;
+}
+
+void ARMor8VoiceAllocator::reset()
+{
+	for ( unsigned int note = 0; note < MIDI_NUM_NOTES; note++ )
+	{
+		m_NoteToVoice[note] = NO_VOICE;
+		m_ReleasedNoteToVoice[note] = NO_VOICE;
+	}
+
+	m_FreeHead = NO_VOICE;
+	m_FreeTail = NO_VOICE;
+	m_ActiveHead = NO_VOICE;
+	m_ActiveTail = NO_VOICE;
+
+	for ( unsigned int voice = 0; voice < MAX_VOICES; voice++ )
+	{
+		m_VoiceToNote[voice] = NO_NOTE;
+		m_LastNoteOfVoice[voice] = NO_NOTE;
+		m_VoiceTriggerTime[voice] = 0;
+		this->pushBack( voice, m_FreeHead, m_FreeTail );
+	}
+
+	m_TriggerCount = 0;
+}
+
+int ARMor8VoiceAllocator::findOldestVoice (int queueHead)
+{
+	int oldestVoice = queueHead;
+	unsigned int oldestAge = 0;
+
+	for ( int voice = queueHead; voice != NO_VOICE; voice = m_NextVoice[voice] )
+	{
+		// unsigned subtraction, so this still works when the trigger count wraps around
+		unsigned int age = m_TriggerCount - m_VoiceTriggerTime[voice];
+		if ( age > oldestAge )
+		{
+			oldestAge = age;
+			oldestVoice = voice;
+		}
+	}
+
+	return oldestVoice;
+}
+
+int ARMor8VoiceAllocator::findQuietestVoice (int queueHead)
+{
+	int quietestVoice = NO_VOICE;
+	float quietestLevel = 0.0f;
+
+	// checked in queue order, so on a tie the voice that was released (or triggered) first wins
+	for ( int voice = queueHead; voice != NO_VOICE; voice = m_NextVoice[voice] )
+	{
+		float level = m_Voices[voice]->getOutputLevel();
+		if ( quietestVoice == NO_VOICE || level < quietestLevel )
+		{
+			quietestLevel = level;
+			quietestVoice = voice;
+		}
+	}
+
+	return quietestVoice;
+}
+
+void ARMor8VoiceAllocator::pushBack (unsigned int voice, int& head, int& tail)
+{
+	m_PrevVoice[voice] = tail;
+	m_NextVoice[voice] = NO_VOICE;
+
+	if ( tail != NO_VOICE )
+	{
+		m_NextVoice[tail] = voice;
+	}
+	else
+	{
+		head = voice;
+	}
+
+	tail = voice;
+}
+
+void ARMor8VoiceAllocator::unlink (unsigned int voice, int& head, int& tail)
+{
+	int prev = m_PrevVoice[voice];
+	int next = m_NextVoice[voice];
+
+	if ( prev != NO_VOICE )
+	{
+		m_NextVoice[prev] = next;
+	}
+	else
+	{
+		head = next;
+	}
+
+	if ( next != NO_VOICE )
+	{
+		m_PrevVoice[next] = prev;
+	}
+	else
+	{
+		tail = prev;
+	}
+
+	m_PrevVoice[voice] = NO_VOICE;
+	m_NextVoice[voice] = NO_VOICE;
+}
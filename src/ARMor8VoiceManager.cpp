@@ -3,14 +3,14 @@
 #include "IARMor8PresetEventListener.hpp"
 #include "IARMor8ParameterEventListener.hpp"
 #include "MidiHandler.hpp"
-#include "PresetManager.hpp"
+#include "ARMor8PresetCache.hpp"
 #include "AudioConstants.hpp"
 #include <string.h>
 #include <cmath>
 
-ARMor8VoiceManager::ARMor8VoiceManager (MidiHandler* midiHandler, PresetManager* presetManager) :
+ARMor8VoiceManager::ARMor8VoiceManager (MidiHandler* midiHandler, ARMor8PresetCache* presetCache) :
 	m_MidiHandler (midiHandler),
-	m_PresetManager (presetManager),
+	m_PresetCache (presetCache),
 	m_OpToEdit (0),
 	m_Monophonic (false),
 	m_Voice1(),
@@ -20,9 +20,18 @@ ARMor8VoiceManager::ARMor8VoiceManager (MidiHandler* midiHandler, PresetManager*
 	m_Voice5(),
 	m_Voice6(),
 	m_Voices { &m_Voice1, &m_Voice2, &m_Voice3, &m_Voice4, &m_Voice5, &m_Voice6 },
-	m_ActiveKeyEventIndex (0),
+	m_VoiceAllocator( m_Voices ),
+	m_NoteStack(),
+	m_UnisonVoices (1),
+	m_UnisonDetuneCents (0),
+	m_UnisonGain (1.0f),
+	m_UnisonSpread (0.0f),
+	m_UnisonGainsL{ 0.0f },
+	m_UnisonGainsR{ 0.0f },
 	m_PitchBendSemitones (1),
-	m_PresetHeader ({1, 1, 0, true})
+	m_PresetHeader ({1, 2, 0, true}),
+	m_DelayEffect(),
+	m_PatchSnapshot()
 {
 }
 
@@ -73,6 +82,8 @@ void ARMor8VoiceManager::setOperatorFreq (unsigned int opNum, float freq)
 	{
 		m_Voices[voice]->setOperatorFreq(opNum, freq);
 	}
+
+	m_PatchSnapshot.invalidate( ARMor8PresetField::FREQUENCY );
 }
 
 void ARMor8VoiceManager::setOperatorDetune (unsigned int opNum, int cents)
@@ -81,6 +92,8 @@ void ARMor8VoiceManager::setOperatorDetune (unsigned int opNum, int cents)
 	{
 		m_Voices[voice]->setOperatorDetune(opNum, cents);
 	}
+
+	m_PatchSnapshot.invalidate( ARMor8PresetField::DETUNE );
 }
 
 void ARMor8VoiceManager::setOperatorWave (unsigned int opNum, const OscillatorMode& wave)
@@ -89,6 +102,8 @@ void ARMor8VoiceManager::setOperatorWave (unsigned int opNum, const OscillatorMo
 	{
 		m_Voices[voice]->setOperatorWave(opNum, wave);
 	}
+
+	m_PatchSnapshot.invalidate( ARMor8PresetField::WAVE );
 }
 
 void ARMor8VoiceManager::setOperatorEGAttack (unsigned int opNum, float seconds, float expo)
@@ -97,6 +112,9 @@ void ARMor8VoiceManager::setOperatorEGAttack (unsigned int opNum, float seconds,
 	{
 		m_Voices[voice]->setOperatorEGAttack(opNum, seconds, expo);
 	}
+
+	m_PatchSnapshot.invalidate( ARMor8PresetField::ATTACK );
+	m_PatchSnapshot.invalidate( ARMor8PresetField::ATTACK_EXPO );
 }
 
 void ARMor8VoiceManager::setOperatorEGDecay (unsigned int opNum, float seconds, float expo)
@@ -105,6 +123,9 @@ void ARMor8VoiceManager::setOperatorEGDecay (unsigned int opNum, float seconds,
 	{
 		m_Voices[voice]->setOperatorEGDecay(opNum, seconds, expo);
 	}
+
+	m_PatchSnapshot.invalidate( ARMor8PresetField::DECAY );
+	m_PatchSnapshot.invalidate( ARMor8PresetField::DECAY_EXPO );
 }
 
 void ARMor8VoiceManager::setOperatorEGSustain (unsigned int opNum, float lvl)
@@ -114,6 +135,8 @@ void ARMor8VoiceManager::setOperatorEGSustain (unsigned int opNum, float lvl)
 
 		m_Voices[voice]->setOperatorEGSustain(opNum, lvl);
 	}
+
+	m_PatchSnapshot.invalidate( ARMor8PresetField::SUSTAIN );
 }
 
 void ARMor8VoiceManager::setOperatorEGRelease (unsigned int opNum, float seconds, float expo)
@@ -122,6 +145,9 @@ void ARMor8VoiceManager::setOperatorEGRelease (unsigned int opNum, float seconds
 	{
 		m_Voices[voice]->setOperatorEGRelease(opNum, seconds, expo);
 	}
+
+	m_PatchSnapshot.invalidate( ARMor8PresetField::RELEASE );
+	m_PatchSnapshot.invalidate( ARMor8PresetField::RELEASE_EXPO );
 }
 
 void ARMor8VoiceManager::setOperatorEGModDestination (unsigned int opNum, const EGModDestination& modDest, const bool on)
@@ -130,6 +156,8 @@ void ARMor8VoiceManager::setOperatorEGModDestination (unsigned int opNum, const
 	{
 		m_Voices[voice]->setOperatorEGModDestination(opNum, modDest, on);
 	}
+
+	m_PatchSnapshot.invalidate( ARMor8PresetField::EG_DESTINATIONS );
 }
 
 void ARMor8VoiceManager::setOperatorModulation (unsigned int sourceOpNum, unsigned int destOpNum, float modulationAmount)
@@ -138,6 +166,8 @@ void ARMor8VoiceManager::setOperatorModulation (unsigned int sourceOpNum, unsign
 	{
 		m_Voices[voice]->setOperatorModulation(sourceOpNum, destOpNum, modulationAmount);
 	}
+
+	m_PatchSnapshot.invalidate( static_cast<unsigned int>(ARMor8PresetField::OP1_MOD_AMOUNT) << sourceOpNum );
 }
 
 void ARMor8VoiceManager::setOperatorAmplitude (unsigned int opNum, float amplitude)
@@ -146,6 +176,8 @@ void ARMor8VoiceManager::setOperatorAmplitude (unsigned int opNum, float amplitu
 	{
 		m_Voices[voice]->setOperatorAmplitude(opNum, amplitude);
 	}
+
+	m_PatchSnapshot.invalidate( ARMor8PresetField::AMPLITUDE );
 }
 
 void ARMor8VoiceManager::setOperatorFilterFreq (unsigned int opNum, float frequency)
@@ -154,6 +186,8 @@ void ARMor8VoiceManager::setOperatorFilterFreq (unsigned int opNum, float freque
 	{
 		m_Voices[voice]->setOperatorFilterFreq(opNum, frequency);
 	}
+
+	m_PatchSnapshot.invalidate( ARMor8PresetField::FILTER_FREQ );
 }
 
 void ARMor8VoiceManager::setOperatorFilterRes (unsigned int opNum, float resonance)
@@ -162,6 +196,8 @@ void ARMor8VoiceManager::setOperatorFilterRes (unsigned int opNum, float resonan
 	{
 		m_Voices[voice]->setOperatorFilterRes(opNum, resonance);
 	}
+
+	m_PatchSnapshot.invalidate( ARMor8PresetField::FILTER_RES );
 }
 
 void ARMor8VoiceManager::setOperatorRatio (unsigned int opNum, bool useRatio)
@@ -170,6 +206,8 @@ void ARMor8VoiceManager::setOperatorRatio (unsigned int opNum, bool useRatio)
 	{
 		m_Voices[voice]->setOperatorRatio(opNum, useRatio);
 	}
+
+	m_PatchSnapshot.invalidate( ARMor8PresetField::RATIO );
 }
 
 void ARMor8VoiceManager::setOperatorAmpVelSens (unsigned int opNum, float ampVelSens)
@@ -178,6 +216,8 @@ void ARMor8VoiceManager::setOperatorAmpVelSens (unsigned int opNum, float ampVel
 	{
 		m_Voices[voice]->setOperatorAmpVelSens(opNum, ampVelSens);
 	}
+
+	m_PatchSnapshot.invalidate( ARMor8PresetField::AMP_VEL_SENS );
 }
 
 void ARMor8VoiceManager::setOperatorFiltVelSens (unsigned int opNum, float filtVelSens)
@@ -186,6 +226,8 @@ void ARMor8VoiceManager::setOperatorFiltVelSens (unsigned int opNum, float filtV
 	{
 		m_Voices[voice]->setOperatorFiltVelSens(opNum, filtVelSens);
 	}
+
+	m_PatchSnapshot.invalidate( ARMor8PresetField::FILT_VEL_SENS );
 }
 
 void ARMor8VoiceManager::setGlideTime (const float glideTime)
@@ -194,6 +236,8 @@ void ARMor8VoiceManager::setGlideTime (const float glideTime)
 	{
 		m_Voices[voice]->setGlideTime( glideTime );
 	}
+
+	m_PatchSnapshot.invalidate( ARMor8PresetField::GLIDE_TIME );
 }
 
 void ARMor8VoiceManager::setGlideRetrigger (const bool useRetrigger)
@@ -202,6 +246,8 @@ void ARMor8VoiceManager::setGlideRetrigger (const bool useRetrigger)
 	{
 		m_Voices[voice]->setGlideRetrigger( useRetrigger );
 	}
+
+	m_PatchSnapshot.invalidate( ARMor8PresetField::GLIDE_RETRIGGER );
 }
 
 void ARMor8VoiceManager::setUseGlide (const bool useGlide)
@@ -215,38 +261,300 @@ void ARMor8VoiceManager::setUseGlide (const bool useGlide)
 void ARMor8VoiceManager::setPitchBendSemitones (const unsigned int pitchBendSemitones)
 {
 	m_PitchBendSemitones = pitchBendSemitones;
+
+	m_PatchSnapshot.invalidate( ARMor8PresetField::PITCH_BEND );
+}
+
+void ARMor8VoiceManager::setDelayEffectMemory (IARMor8ExternalMemory* memory, unsigned int offsetInBytes, unsigned int sizeInBytes)
+{
+	m_DelayEffect.setMemory( memory, offsetInBytes, sizeInBytes );
+}
+
+void ARMor8VoiceManager::setDelayEffectMode (const DELAY_EFFECT_MODE& mode)
+{
+	m_DelayEffect.setMode( mode );
+}
+
+void ARMor8VoiceManager::setDelayTime (float seconds)
+{
+	seconds = ( seconds < ARMOR8_DELAY_TIME_MIN ) ? ARMOR8_DELAY_TIME_MIN : seconds;
+	seconds = ( seconds > ARMOR8_DELAY_TIME_MAX ) ? ARMOR8_DELAY_TIME_MAX : seconds;
+
+	m_DelayEffect.setDelayTime( seconds );
+}
+
+void ARMor8VoiceManager::setDelayFeedback (float feedback)
+{
+	feedback = ( feedback < 0.0f ) ? 0.0f : feedback;
+	feedback = ( feedback > ARMOR8_DELAY_FEEDBACK_MAX ) ? ARMOR8_DELAY_FEEDBACK_MAX : feedback;
+
+	m_DelayEffect.setFeedback( feedback );
+}
+
+void ARMor8VoiceManager::setDelayMix (float mix)
+{
+	mix = ( mix < 0.0f ) ? 0.0f : mix;
+	mix = ( mix > 1.0f ) ? 1.0f : mix;
+
+	m_DelayEffect.setMix( mix );
+}
+
+void ARMor8VoiceManager::setChorusRate (float hz)
+{
+	hz = ( hz < ARMOR8_CHORUS_RATE_MIN ) ? ARMOR8_CHORUS_RATE_MIN : hz;
+	hz = ( hz > ARMOR8_CHORUS_RATE_MAX ) ? ARMOR8_CHORUS_RATE_MAX : hz;
+
+	m_DelayEffect.setChorusRate( hz );
+}
+
+void ARMor8VoiceManager::setChorusDepth (float seconds)
+{
+	seconds = ( seconds < 0.0f ) ? 0.0f : seconds;
+	seconds = ( seconds > ARMOR8_CHORUS_DEPTH_MAX ) ? ARMOR8_CHORUS_DEPTH_MAX : seconds;
+
+	m_DelayEffect.setChorusDepth( seconds );
 }
 
 void ARMor8VoiceManager::call (float* writeBuffer)
+{
+	this->renderBlock( writeBuffer, ABUFFER_SIZE );
+}
+
+void ARMor8VoiceManager::renderBlock (float* writeBuffer, unsigned int numSamples)
 {
 	// first clear write buffer
-	memset(writeBuffer, 0, sizeof(float) * ABUFFER_SIZE);
+	memset(writeBuffer, 0, sizeof(float) * numSamples);
 
 	if (!m_Monophonic) // if polyphonic, we sum the voices
 	{
 		for (unsigned int voice = 0; voice < MAX_VOICES; voice++)
 		{
 			ARMor8Voice& currentVoice = *m_Voices[voice];
+			currentVoice.updateOversampling();
 
-			for (unsigned int sample = 0; sample < ABUFFER_SIZE; sample++)
+			for (unsigned int sample = 0; sample < numSamples; sample++)
 			{
 				writeBuffer[sample] += currentVoice.nextSample();
 			}
 		}
 	}
-	else // if monophonic, we only output the first voice
+	else // if monophonic, we only output the first voice and its unison voices
 	{
-		for (unsigned int sample = 0; sample < ABUFFER_SIZE; sample++)
+		for (unsigned int voice = 0; voice < m_UnisonVoices; voice++)
 		{
-			ARMor8Voice& voice = *m_Voices[0];
-			writeBuffer[sample] += voice.nextSample();
+			ARMor8Voice& currentVoice = *m_Voices[voice];
+			currentVoice.updateOversampling();
+
+			for (unsigned int sample = 0; sample < numSamples; sample++)
+			{
+				writeBuffer[sample] += currentVoice.nextSample();
+			}
+		}
+
+		if ( m_UnisonVoices > 1 )
+		{
+			for (unsigned int sample = 0; sample < numSamples; sample++)
+			{
+				writeBuffer[sample] *= m_UnisonGain;
+			}
+		}
+	}
+
+	// effects on the summed voices
+	m_DelayEffect.process( writeBuffer, numSamples );
+}
+
+void ARMor8VoiceManager::renderBlock (float* writeBufferL, float* writeBufferR, unsigned int numSamples)
+{
+	// without unison there's nothing to spread
+	if ( !m_Monophonic || m_UnisonVoices < 2 )
+	{
+		this->renderBlock( writeBufferL, numSamples );
+		memcpy( writeBufferR, writeBufferL, sizeof(float) * numSamples );
+
+		return;
+	}
+
+	memset( writeBufferL, 0, sizeof(float) * numSamples );
+	memset( writeBufferR, 0, sizeof(float) * numSamples );
+
+	for (unsigned int voice = 0; voice < m_UnisonVoices; voice++)
+	{
+		ARMor8Voice& currentVoice = *m_Voices[voice];
+		currentVoice.updateOversampling();
+
+		const float gainL = m_UnisonGainsL[voice];
+		const float gainR = m_UnisonGainsR[voice];
+		for (unsigned int sample = 0; sample < numSamples; sample++)
+		{
+			const float voiceSample = currentVoice.nextSample();
+			writeBufferL[sample] += voiceSample * gainL;
+			writeBufferR[sample] += voiceSample * gainR;
+		}
+	}
+
+	// the delay line is mono, so it runs on the mid signal and whatever it changes is added back to both channels
+	const unsigned int chunkSize = 64;
+	float mid[chunkSize];
+	float processed[chunkSize];
+	for (unsigned int chunkStart = 0; chunkStart < numSamples; chunkStart += chunkSize)
+	{
+		const unsigned int numChunkSamples = ( numSamples - chunkStart < chunkSize ) ? numSamples - chunkStart : chunkSize;
+
+		for (unsigned int sample = 0; sample < numChunkSamples; sample++)
+		{
+			mid[sample] = ( writeBufferL[chunkStart + sample] + writeBufferR[chunkStart + sample] ) * 0.5f;
+			processed[sample] = mid[sample];
+		}
+
+		m_DelayEffect.process( processed, numChunkSamples );
+
+		for (unsigned int sample = 0; sample < numChunkSamples; sample++)
+		{
+			const float effect = processed[sample] - mid[sample];
+			writeBufferL[chunkStart + sample] += effect;
+			writeBufferR[chunkStart + sample] += effect;
 		}
 	}
 }
 
 void ARMor8VoiceManager::setMonophonic (bool on)
 {
+	if ( on != m_Monophonic )
+	{
+		this->releaseAllVoices();
+	}
+
 	m_Monophonic = on;
+
+	this->updateUnisonVoices();
+
+	m_PatchSnapshot.invalidate( ARMor8PresetField::MONOPHONIC );
+}
+
+void ARMor8VoiceManager::setUnison (unsigned int numVoices)
+{
+	if ( numVoices < 1 )
+	{
+		numVoices = 1;
+	}
+	else if ( numVoices > MAX_VOICES )
+	{
+		numVoices = MAX_VOICES;
+	}
+
+	// release any unison voices that are no longer used, so they don't hang
+	for (unsigned int voice = numVoices; voice < m_UnisonVoices; voice++)
+	{
+		if ( m_Monophonic && m_ActiveKeyEvents[voice].pressed() != KeyPressedEnum::RELEASED )
+		{
+			KeyEvent releaseEvent( KeyPressedEnum::RELEASED, m_ActiveKeyEvents[voice].note(), m_ActiveKeyEvents[voice].velocity() );
+			m_ActiveKeyEvents[voice] = releaseEvent;
+			m_Voices[voice]->onKeyEvent( releaseEvent );
+		}
+	}
+
+	m_UnisonVoices = numVoices;
+	m_UnisonGain = 1.0f / std::sqrt( static_cast<float>(numVoices) ); // keeps the loudness roughly constant
+
+	this->updateUnisonVoices();
+}
+
+void ARMor8VoiceManager::setUnisonDetune (int cents)
+{
+	m_UnisonDetuneCents = cents;
+
+	this->updateUnisonVoices();
+}
+
+void ARMor8VoiceManager::setUnisonSpread (float spread)
+{
+	m_UnisonSpread = ( spread < 0.0f ) ? 0.0f : ( (spread > 1.0f) ? 1.0f : spread );
+
+	this->updateUnisonVoices();
+}
+
+void ARMor8VoiceManager::updateUnisonVoices()
+{
+	const float quarterPi = 0.78539816f;
+
+	for (unsigned int voice = 0; voice < MAX_VOICES; voice++)
+	{
+		int detune = 0;
+		float position = 0.0f;
+
+		// unison voices are spread evenly between -detune and +detune, and panned in the same order
+		if ( m_Monophonic && m_UnisonVoices > 1 && voice < m_UnisonVoices )
+		{
+			position = ( (2.0f * voice) / static_cast<float>(m_UnisonVoices - 1) ) - 1.0f;
+			detune = static_cast<int>( std::round(position * static_cast<float>(m_UnisonDetuneCents)) );
+		}
+
+		m_Voices[voice]->setUnisonDetune( detune );
+
+		// constant power panning, scaled up so a voice in the center is as loud as it is in the mono render
+		const float panAngle = ( (position * m_UnisonSpread) + 1.0f ) * quarterPi;
+		m_UnisonGainsL[voice] = m_UnisonGain * std::sqrt( 2.0f ) * std::cos( panAngle );
+		m_UnisonGainsR[voice] = m_UnisonGain * std::sqrt( 2.0f ) * std::sin( panAngle );
+	}
+}
+
+void ARMor8VoiceManager::sendMonoKeyEvent (const KeyEvent& keyEvent)
+{
+	for (unsigned int voice = 0; voice < m_UnisonVoices; voice++)
+	{
+		m_ActiveKeyEvents[voice] = keyEvent;
+		m_Voices[voice]->onKeyEvent( keyEvent );
+	}
+}
+
+void ARMor8VoiceManager::releaseAllVoices()
+{
+	for (unsigned int voice = 0; voice < MAX_VOICES; voice++)
+	{
+		if ( m_ActiveKeyEvents[voice].pressed() != KeyPressedEnum::RELEASED )
+		{
+			KeyEvent releaseEvent( KeyPressedEnum::RELEASED, m_ActiveKeyEvents[voice].note(), m_ActiveKeyEvents[voice].velocity() );
+			m_ActiveKeyEvents[voice] = releaseEvent;
+			m_Voices[voice]->onKeyEvent( releaseEvent );
+		}
+	}
+
+	m_VoiceAllocator.reset();
+	m_NoteStack.reset();
+}
+
+void ARMor8VoiceManager::setOversampling (bool on)
+{
+	for (unsigned int voice = 0; voice < MAX_VOICES; voice++)
+	{
+		m_Voices[voice]->setMaxOversamplingFactor( (on) ? ARMOR8_MAX_OVERSAMPLING : 1 );
+	}
+}
+
+void ARMor8VoiceManager::setSampleRate (float sampleRate)
+{
+	for (unsigned int voice = 0; voice < MAX_VOICES; voice++)
+	{
+		m_Voices[voice]->setSampleRate( sampleRate );
+	}
+
+	m_DelayEffect.setSampleRate( sampleRate );
+}
+
+void ARMor8VoiceManager::setVoiceStealingStrategy (const VOICE_STEALING_STRATEGY& strategy)
+{
+	m_VoiceAllocator.setStealingStrategy( strategy );
+}
+
+void ARMor8VoiceManager::setSameNoteReuse (bool on)
+{
+	m_VoiceAllocator.setSameNoteReuse( on );
+}
+
+void ARMor8VoiceManager::setMonoNotePriority (const MONO_NOTE_PRIORITY& priority)
+{
+	m_NoteStack.setPriority( priority );
 }
 
 void ARMor8VoiceManager::onKeyEvent (const KeyEvent& keyEvent)
@@ -255,164 +563,61 @@ void ARMor8VoiceManager::onKeyEvent (const KeyEvent& keyEvent)
 	{
 		if ( keyEvent.pressed() == KeyPressedEnum::PRESSED )
 		{
-			bool containsKeyEvent = false;
-			for (unsigned int voice = 0; voice < MAX_VOICES; voice++)
-			{
-				if ( m_ActiveKeyEvents[voice].isNoteAndType( keyEvent ) )
-				{
-					containsKeyEvent = true;
-					m_ActiveKeyEvents[voice] = keyEvent;
-					m_Voices[voice]->onKeyEvent(keyEvent);
+			bool needsFade = false;
+			unsigned int voice = m_VoiceAllocator.allocateVoice( keyEvent.note(), needsFade );
+			m_ActiveKeyEvents[voice] = keyEvent;
 
-					return;
-				}
+			if ( needsFade )
+			{
+				m_Voices[voice]->stealForKeyEvent( keyEvent );
 			}
-
-			if (!containsKeyEvent)
+			else
 			{
-				// ensure we aren't overwriting a pressed key
-				unsigned int initialActiveKeyEventIndex = m_ActiveKeyEventIndex;
-				while ( m_ActiveKeyEvents[m_ActiveKeyEventIndex].pressed() == KeyPressedEnum::PRESSED )
-				{
-					m_ActiveKeyEventIndex = (m_ActiveKeyEventIndex + 1) % MAX_VOICES;
-
-					if ( m_ActiveKeyEventIndex == initialActiveKeyEventIndex )
-					{
-						break;
-					}
-				}
-				m_ActiveKeyEvents[m_ActiveKeyEventIndex] = keyEvent;
-				m_Voices[m_ActiveKeyEventIndex]->onKeyEvent(keyEvent);
-
-				m_ActiveKeyEventIndex = (m_ActiveKeyEventIndex + 1) % MAX_VOICES;
-
-				return;
+				m_Voices[voice]->onKeyEvent( keyEvent );
 			}
+
+			return;
 		}
 		else if ( keyEvent.pressed() == KeyPressedEnum::RELEASED )
 		{
-			for (unsigned int voice = 0; voice < MAX_VOICES; voice++)
+			int voice = m_VoiceAllocator.releaseNote( keyEvent.note() );
+			if ( voice != NO_VOICE )
 			{
-				if ( m_ActiveKeyEvents[voice].isNoteAndType( keyEvent, KeyPressedEnum::PRESSED ) )
-				{
-					m_ActiveKeyEvents[voice] = keyEvent;
-					m_Voices[voice]->onKeyEvent( keyEvent );
-
-					return;
-				}
+				m_ActiveKeyEvents[voice] = keyEvent;
+				m_Voices[voice]->onKeyEvent( keyEvent );
 			}
+
+			return;
 		}
 	}
 	else // monophonic implementation
 	{
+		int previousNote = m_NoteStack.getActiveNote();
+
 		if ( keyEvent.pressed() == KeyPressedEnum::PRESSED )
 		{
-			// if a key is currently playing
-			KeyPressedEnum activeKeyPressed = m_ActiveKeyEvents[0].pressed();
-			if ( activeKeyPressed == KeyPressedEnum::PRESSED || activeKeyPressed == KeyPressedEnum::HELD )
-			{
-				// build a 'held' key event, since we don't want to retrigger the envelope generator
-				KeyEvent newKeyEvent( KeyPressedEnum::HELD, keyEvent.note(), keyEvent.velocity() );
+			m_NoteStack.pushNote( keyEvent.note(), keyEvent.velocity() );
+		}
+		else if ( keyEvent.pressed() == KeyPressedEnum::RELEASED )
+		{
+			m_NoteStack.removeNote( keyEvent.note() );
+		}
 
-				if ( m_ActiveKeyEvents[0].note() < newKeyEvent.note() )
-				{
-					KeyEvent oldKeyEvent( KeyPressedEnum::HELD, m_ActiveKeyEvents[0].note(), m_ActiveKeyEvents[0].velocity() );
-
-					// look for a place to store the old key event, since we only want to play the highest note
-					for (unsigned int voice = 1; voice < MAX_VOICES; voice++)
-					{
-						if ( m_ActiveKeyEvents[voice].pressed() == KeyPressedEnum::RELEASED )
-						{
-							m_ActiveKeyEvents[voice] = oldKeyEvent;
-							break;
-						}
-					}
-
-					m_ActiveKeyEvents[0] = newKeyEvent;
-					m_Voices[0]->onKeyEvent( newKeyEvent );
-
-					return;
-				}
-				else if ( m_ActiveKeyEvents[0].note() > newKeyEvent.note() )
-				{
-					// look for a place to store this key event, since we only want to play the highest note
-					for (unsigned int voice = 1; voice < MAX_VOICES; voice++)
-					{
-						if ( m_ActiveKeyEvents[voice].pressed() == KeyPressedEnum::RELEASED )
-						{
-							m_ActiveKeyEvents[voice] = newKeyEvent;
-							break;
-						}
-					}
-
-					return;
-				}
-			}
-			else // there is no note currently active
-			{
-				m_ActiveKeyEvents[0] = keyEvent;
-				m_Voices[0]->onKeyEvent( keyEvent );
+		int activeNote = m_NoteStack.getActiveNote();
 
-				return;
-			}
+		if ( previousNote == NO_NOTE && activeNote != NO_NOTE ) // there was no note active, so trigger the voice
+		{
+			this->sendMonoKeyEvent( keyEvent );
 		}
-		else if ( keyEvent.pressed() == KeyPressedEnum::RELEASED )
+		else if ( previousNote != NO_NOTE && activeNote == NO_NOTE ) // the last held key was released
 		{
-			// look for this note in the active key events array
-			for (unsigned int voice = 0; voice < MAX_VOICES; voice++)
-			{
-				// if there is a note that matches and isn't released
-				KeyPressedEnum voiceKeyPressed = m_ActiveKeyEvents[voice].pressed();
-				unsigned int voiceKeyNote = m_ActiveKeyEvents[voice].note();
-				if ( voiceKeyPressed != KeyPressedEnum::RELEASED && voiceKeyNote == keyEvent.note() )
-				{
-					// if the main active voice is released, replace with lower note
-					if (voice == 0)
-					{
-						int highestNote = -1; // negative 1 means no highest note found
-						for (unsigned int voice2 = 1; voice2 < MAX_VOICES; voice2++)
-						{
-							KeyPressedEnum voice2KeyPressed = m_ActiveKeyEvents[voice2].pressed();
-							int voice2KeyNote = m_ActiveKeyEvents[voice2].note();
-							if ( voice2KeyPressed == KeyPressedEnum::HELD && voice2KeyNote > highestNote )
-							{
-								highestNote = voice2;
-							}
-						}
-
-						if ( highestNote > 0 ) // if an active lower key is found
-						{
-							// store the lower key
-							KeyEvent newActiveKeyEvent = m_ActiveKeyEvents[highestNote];
-
-							// replace the lower key with a released key event
-							unsigned int keyNote = m_ActiveKeyEvents[highestNote].note();
-							unsigned int keyVelocity = m_ActiveKeyEvents[highestNote].velocity();
-							KeyEvent inactiveKeyEvent( KeyPressedEnum::RELEASED, keyNote, keyVelocity );
-							m_ActiveKeyEvents[highestNote] = inactiveKeyEvent;
-
-							// replace the currently active note with the lower key
-							m_ActiveKeyEvents[0] = newActiveKeyEvent;
-							m_Voices[0]->onKeyEvent( newActiveKeyEvent );
-
-							return;
-						}
-						else // if there are no active lower keys
-						{
-							m_ActiveKeyEvents[0] = keyEvent;
-							m_Voices[0]->onKeyEvent( keyEvent );
-
-							return;
-						}
-					}
-					else // if one of the lower notes is released, replace with released key event
-					{
-						m_ActiveKeyEvents[voice] = keyEvent;
-
-						return;
-					}
-				}
-			}
+			this->sendMonoKeyEvent( keyEvent );
+		}
+		else if ( activeNote != previousNote )
+		{
+			// build a 'held' key event, since we don't want to retrigger the envelope generator
+			KeyEvent newKeyEvent( KeyPressedEnum::HELD, activeNote, m_NoteStack.getVelocity(activeNote) );
+			this->sendMonoKeyEvent( newKeyEvent );
 		}
 	}
 }
@@ -630,38 +835,22 @@ void ARMor8VoiceManager::onButtonEvent (const ButtonEvent& buttonEvent)
 		{
 			case BUTTON_CHANNEL::OP1:
 				m_OpToEdit = 0;
-
-				IARMor8PresetEventListener::PublishEvent( ARMor8PresetEvent(this->getState(),
-										m_OpToEdit,
-										m_PresetManager->getCurrentPresetNum(),
-										0) );
+				this->publishPresetEvent();
 
 				break;
 			case BUTTON_CHANNEL::OP2:
 				m_OpToEdit = 1;
-
-				IARMor8PresetEventListener::PublishEvent( ARMor8PresetEvent(this->getState(),
-										m_OpToEdit,
-										m_PresetManager->getCurrentPresetNum(),
-										0) );
+				this->publishPresetEvent();
 
 				break;
 			case BUTTON_CHANNEL::OP3:
 				m_OpToEdit = 2;
-
-				IARMor8PresetEventListener::PublishEvent( ARMor8PresetEvent(this->getState(),
-										m_OpToEdit,
-										m_PresetManager->getCurrentPresetNum(),
-										0) );
+				this->publishPresetEvent();
 
 				break;
 			case BUTTON_CHANNEL::OP4:
 				m_OpToEdit = 3;
-
-				IARMor8PresetEventListener::PublishEvent( ARMor8PresetEvent(this->getState(),
-										m_OpToEdit,
-										m_PresetManager->getCurrentPresetNum(),
-										0) );
+				this->publishPresetEvent();
 
 				break;
 			case BUTTON_CHANNEL::SINE:
@@ -682,8 +871,8 @@ void ARMor8VoiceManager::onButtonEvent (const ButtonEvent& buttonEvent)
 				break;
 			case BUTTON_CHANNEL::PREV_PRESET:
 				{
-					ARMor8VoiceState preset = m_PresetManager->prevPreset<ARMor8VoiceState>();
-					this->setState( preset );
+					ARMor8PackedPreset preset = m_PresetCache->prevPreset();
+					this->setState( ARMor8PresetCodec::unpack(preset) );
 					IButtonEventListener::PublishEvent( ButtonEvent(BUTTON_STATE::RELEASED,
 							static_cast<unsigned int>(BUTTON_CHANNEL::OP1)) );
 				}
@@ -691,8 +880,8 @@ void ARMor8VoiceManager::onButtonEvent (const ButtonEvent& buttonEvent)
 				break;
 			case BUTTON_CHANNEL::NEXT_PRESET:
 				{
-					ARMor8VoiceState preset = m_PresetManager->nextPreset<ARMor8VoiceState>();
-					this->setState( preset );
+					ARMor8PackedPreset preset = m_PresetCache->nextPreset();
+					this->setState( ARMor8PresetCodec::unpack(preset) );
 					IButtonEventListener::PublishEvent( ButtonEvent(BUTTON_STATE::RELEASED,
 							static_cast<unsigned int>(BUTTON_CHANNEL::OP1)) );
 				}
@@ -700,8 +889,8 @@ void ARMor8VoiceManager::onButtonEvent (const ButtonEvent& buttonEvent)
 				break;
 			case BUTTON_CHANNEL::WRITE_PRESET:
 				{
-					ARMor8VoiceState presetToWrite = this->getState();
-					m_PresetManager->writePreset<ARMor8VoiceState>( presetToWrite, m_PresetManager->getCurrentPresetNum() );
+					ARMor8PackedPreset presetToWrite = ARMor8PresetCodec::pack( this->getState() );
+					m_PresetCache->writePreset( presetToWrite, m_PresetCache->getCurrentPresetNum() );
 				}
 
 				break;
@@ -718,7 +907,7 @@ void ARMor8VoiceManager::onButtonEvent (const ButtonEvent& buttonEvent)
 
 				break;
 			case BUTTON_CHANNEL::MONOPHONIC:
-				m_Monophonic = true;
+				this->setMonophonic( true );
 
 				break;
 			case BUTTON_CHANNEL::GLIDE_RETRIG:
@@ -748,7 +937,7 @@ void ARMor8VoiceManager::onButtonEvent (const ButtonEvent& buttonEvent)
 
 				break;
 			case BUTTON_CHANNEL::MONOPHONIC:
-				m_Monophonic = false;
+				this->setMonophonic( false );
 
 				break;
 			case BUTTON_CHANNEL::GLIDE_RETRIG:
@@ -771,13 +960,18 @@ void ARMor8VoiceManager::onButtonEvent (const ButtonEvent& buttonEvent)
 	}
 }
 
-ARMor8VoiceState ARMor8VoiceManager::getState()
+const ARMor8VoiceState& ARMor8VoiceManager::getState()
 {
-	ARMor8VoiceState state = m_Voices[0]->getState();
-	state.monophonic = m_Monophonic;
-	state.pitchBendSemitones = m_PitchBendSemitones;
+	if ( m_PatchSnapshot.isStale() )
+	{
+		ARMor8VoiceState state = m_Voices[0]->getState();
+		state.monophonic = m_Monophonic;
+		state.pitchBendSemitones = m_PitchBendSemitones;
 
-	return state;
+		m_PatchSnapshot.update( state );
+	}
+
+	return m_PatchSnapshot.getState();
 }
 
 void ARMor8VoiceManager::setState (const ARMor8VoiceState& state)
@@ -788,9 +982,27 @@ void ARMor8VoiceManager::setState (const ARMor8VoiceState& state)
 	}
 
 	// global
-	m_Monophonic = state.monophonic;
+	if ( state.monophonic != m_Monophonic )
+	{
+		this->releaseAllVoices();
+		m_Monophonic = state.monophonic;
+		this->updateUnisonVoices();
+	}
 	m_PitchBendSemitones = state.pitchBendSemitones;
 	m_MidiHandler->setNumberOfSemitonesToPitchBend( m_PitchBendSemitones );
+
+	// every voice now has exactly this state, so there's no need to read it back from them
+	m_PatchSnapshot.update( state );
+}
+
+void ARMor8VoiceManager::publishPresetEvent()
+{
+	const ARMor8VoiceState& state = this->getState();
+	unsigned int presetNum = m_PresetCache->getCurrentPresetNum();
+	unsigned int changedFields = m_PatchSnapshot.takeChangedFields( m_OpToEdit, presetNum );
+
+	IARMor8PresetEventListener::PublishEvent( ARMor8PresetEvent(state, changedFields, m_PatchSnapshot.getVersion(),
+									m_OpToEdit, presetNum, 0) );
 }
 
 ARMor8PresetHeader ARMor8VoiceManager::getPresetHeader()
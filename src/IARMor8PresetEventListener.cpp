@@ -4,10 +4,12 @@
 EventDispatcher<IARMor8PresetEventListener, ARMor8PresetEvent,
 		&IARMor8PresetEventListener::onARMor8PresetChangedEvent> IARMor8PresetEventListener::m_EventDispatcher;
 
-ARMor8PresetEvent::ARMor8PresetEvent (const ARMor8VoiceState& preset, unsigned int opToEdit, unsigned int presetNum,
-					unsigned int channel) :
+ARMor8PresetEvent::ARMor8PresetEvent (const ARMor8VoiceState& preset, unsigned int changedFields, unsigned int version,
+					unsigned int opToEdit, unsigned int presetNum, unsigned int channel) :
 	IEvent( channel ),
 	m_Preset( preset ),
+	m_ChangedFields( changedFields ),
+	m_Version( version ),
 	m_OpToEdit( opToEdit ),
 	m_PresetNum( presetNum )
 {
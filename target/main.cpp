@@ -1,10 +1,19 @@
 #include "../lib/STM32f302x8-HAL/llpd/include/LLPD.hpp"
+#include "stm32f302x8.h"
 
 #include "ARMor8VoiceManager.hpp"
+#include "ARMor8PresetCodec.hpp"
+#include "ARMor8PresetCache.hpp"
+#include "ARMor8PresetJournal.hpp"
+#include "ARMor8FactoryPresetStore.hpp"
+#include "ARMor8PresetStorageService.hpp"
+#include "ARMor8BootSequencer.hpp"
 #include "MidiHandler.hpp"
 #include "PresetManager.hpp"
 #include "AudioBuffer.hpp"
 
+#include <string.h>
+
 const int SYS_CLOCK_FREQUENCY = 32000000;
 const int EEPROM_SIZE = 8192; // EEPROM is CAT24C64
 const int SRAM_SIZE = 65536; // SRAM is 23A256/23K256
@@ -33,203 +42,645 @@ public:
 
 AudioBuffer audioBuffer;
 MidiHandler midiHandler;
-PresetManager presetManager( sizeof(ARMor8PresetHeader), 20, new FakeStorageMedia() );
-// ARMor8VoiceManager armor8VoiceManager( &midiHandler, &presetManager );
+PresetManager presetManager( sizeof(ARMor8PresetHeader), ARMOR8_NUM_PRESETS, new FakeStorageMedia() );
 */
 
 ARMor8Voice* voice;
 PolyBLEPOsc* osc;
 
-void writeDataToSRAM (uint16_t address, uint8_t data)
+// the 23K256 is put in sequential mode, so a transfer of any length only costs one instruction and address. the payload
+// goes over SPI2 with DMA (channel 5 for tx and channel 4 for rx), short transfers aren't worth setting the DMA up for.
+// the start functions return as soon as the DMA is running, only one transfer is in flight at a time so starting
+// another one (or any blocking transfer) first waits for the previous one to finish
+class SpiSram
 {
-	// pull cs low
-	LLPD::gpio_output_set( GPIO_PORT::B, GPIO_PIN::PIN_12, false );
+public:
+	static const unsigned int MIN_DMA_SIZE = 8;
 
-	// send write instruction
-	LLPD::spi_master_send_and_recieve( SPI_NUM::SPI_2, 0b00000010 );
+	SpiSram() : m_DummyByte( 0 ), m_DmaInProgress( false ) {}
+	~SpiSram() {}
 
-	// send first half of address
-	LLPD::spi_master_send_and_recieve( SPI_NUM::SPI_2, (address >> 8) );
+	// call after LLPD has set up SPI2 and the chip select pin
+	void init()
+	{
+		RCC->AHBENR |= RCC_AHBENR_DMA1EN;
 
-	// send second half of address
-	LLPD::spi_master_send_and_recieve( SPI_NUM::SPI_2, (address & 0b0000000011111111) );
+		// write status register, sequential mode
+		LLPD::gpio_output_set( GPIO_PORT::B, GPIO_PIN::PIN_12, false );
+		LLPD::spi_master_send_and_recieve( SPI_NUM::SPI_2, INSTRUCTION_WRSR );
+		LLPD::spi_master_send_and_recieve( SPI_NUM::SPI_2, STATUS_SEQUENTIAL_MODE );
+		LLPD::gpio_output_set( GPIO_PORT::B, GPIO_PIN::PIN_12, true );
+	}
 
-	// send data
-	LLPD::spi_master_send_and_recieve( SPI_NUM::SPI_2, data );
+	void writeBytes (const uint8_t* data, unsigned int sizeInBytes, unsigned int address)
+	{
+		this->startWriteBytes( data, sizeInBytes, address );
+		this->waitForTransfers();
+	}
 
-	// pull cs high
-	LLPD::gpio_output_set( GPIO_PORT::B, GPIO_PIN::PIN_12, true );
+	void readBytes (uint8_t* data, unsigned int sizeInBytes, unsigned int address)
+	{
+		this->startReadBytes( data, sizeInBytes, address );
+		this->waitForTransfers();
+	}
+
+	// data must stay untouched until waitForTransfers() returns
+	void startWriteBytes (const uint8_t* data, unsigned int sizeInBytes, unsigned int address)
+	{
+		this->waitForTransfers();
+		this->beginTransfer( INSTRUCTION_WRITE, address );
+
+		if ( sizeInBytes < MIN_DMA_SIZE )
+		{
+			for ( unsigned int byte = 0; byte < sizeInBytes; byte++ )
+			{
+				LLPD::spi_master_send_and_recieve( SPI_NUM::SPI_2, data[byte] );
+			}
+
+			LLPD::gpio_output_set( GPIO_PORT::B, GPIO_PIN::PIN_12, true );
+		}
+		else
+		{
+			// whatever comes back while writing is thrown away
+			this->startDma( data, true, &m_DummyByte, false, sizeInBytes );
+		}
+	}
+
+	void startReadBytes (uint8_t* data, unsigned int sizeInBytes, unsigned int address)
+	{
+		this->waitForTransfers();
+		this->beginTransfer( INSTRUCTION_READ, address );
+
+		if ( sizeInBytes < MIN_DMA_SIZE )
+		{
+			for ( unsigned int byte = 0; byte < sizeInBytes; byte++ )
+			{
+				data[byte] = LLPD::spi_master_send_and_recieve( SPI_NUM::SPI_2, 0b00000000 );
+			}
+
+			LLPD::gpio_output_set( GPIO_PORT::B, GPIO_PIN::PIN_12, true );
+		}
+		else
+		{
+			// the same dummy byte is clocked out for every byte read
+			m_DummyByte = 0;
+			this->startDma( &m_DummyByte, false, data, true, sizeInBytes );
+		}
+	}
+
+	void waitForTransfers()
+	{
+		if ( ! m_DmaInProgress )
+		{
+			return;
+		}
+
+		// the last byte is received after the last byte is sent, so rx finishing means the whole transfer is done
+		while ( !(DMA1->ISR & DMA_ISR_TCIF4) ) {}
+		while ( SPI2->SR & SPI_SR_BSY ) {}
+
+		DMA1->IFCR = DMA_IFCR_CGIF4 | DMA_IFCR_CGIF5;
+		DMA1_Channel4->CCR = 0;
+		DMA1_Channel5->CCR = 0;
+		SPI2->CR2 &= ~( SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN );
+
+		LLPD::gpio_output_set( GPIO_PORT::B, GPIO_PIN::PIN_12, true );
+		m_DmaInProgress = false;
+	}
+
+private:
+	static const uint8_t INSTRUCTION_READ = 0b00000011;
+	static const uint8_t INSTRUCTION_WRITE = 0b00000010;
+	static const uint8_t INSTRUCTION_WRSR = 0b00000001;
+	static const uint8_t STATUS_SEQUENTIAL_MODE = 0b01000000;
+
+	uint8_t m_DummyByte;
+	bool    m_DmaInProgress;
+
+	void beginTransfer (uint8_t instruction, unsigned int address)
+	{
+		LLPD::gpio_output_set( GPIO_PORT::B, GPIO_PIN::PIN_12, false );
+		LLPD::spi_master_send_and_recieve( SPI_NUM::SPI_2, instruction );
+		LLPD::spi_master_send_and_recieve( SPI_NUM::SPI_2, (address >> 8) & 0b0000000011111111 );
+		LLPD::spi_master_send_and_recieve( SPI_NUM::SPI_2, address & 0b0000000011111111 );
+	}
+
+	// sizeInBytes must fit in 16 bits, chip select is left low until waitForTransfers()
+	void startDma (const uint8_t* txData, bool incrementTx, uint8_t* rxData, bool incrementRx, unsigned int sizeInBytes)
+	{
+		// rx channel is enabled first, so no received byte can be missed (8 bit transfers to and from the data register)
+		DMA1_Channel4->CCR = 0;
+		DMA1_Channel4->CPAR = reinterpret_cast<uint32_t>( &SPI2->DR );
+		DMA1_Channel4->CMAR = reinterpret_cast<uint32_t>( rxData );
+		DMA1_Channel4->CNDTR = sizeInBytes;
+		DMA1_Channel4->CCR = ( incrementRx ) ? DMA_CCR_MINC : 0;
+		SPI2->CR2 |= SPI_CR2_RXDMAEN;
+		DMA1_Channel4->CCR |= DMA_CCR_EN;
+
+		DMA1_Channel5->CCR = 0;
+		DMA1_Channel5->CPAR = reinterpret_cast<uint32_t>( &SPI2->DR );
+		DMA1_Channel5->CMAR = reinterpret_cast<uint32_t>( txData );
+		DMA1_Channel5->CNDTR = sizeInBytes;
+		DMA1_Channel5->CCR = DMA_CCR_DIR | ( (incrementTx) ? DMA_CCR_MINC : 0 );
+		DMA1_Channel5->CCR |= DMA_CCR_EN;
+		SPI2->CR2 |= SPI_CR2_TXDMAEN;
+
+		m_DmaInProgress = true;
+	}
+};
+
+SpiSram sram;
+
+volatile float sramWriteBytesPerSecond = 0.0f;
+volatile float sramReadBytesPerSecond = 0.0f;
+
+// sustained throughput over the whole SRAM with blockSize byte transfers, results are left in the volatiles above
+bool benchmarkSram (unsigned int blockSize)
+{
+	const unsigned int maxBlockSize = 1024;
+	static uint8_t block[maxBlockSize];
+	if ( blockSize > maxBlockSize )
+	{
+		blockSize = maxBlockSize;
+	}
+
+	// time with the cycle counter (started at boot)
+	uint32_t writeCycles = 0;
+	for ( unsigned int address = 0; address < static_cast<unsigned int>(SRAM_SIZE); address += blockSize )
+	{
+		for ( unsigned int byte = 0; byte < blockSize; byte++ )
+		{
+			block[byte] = ( address + byte ) % 256;
+		}
+
+		uint32_t startCycle = DWT->CYCCNT;
+		sram.writeBytes( block, blockSize, address );
+		writeCycles += DWT->CYCCNT - startCycle;
+	}
+
+	bool dataIsValid = true;
+	uint32_t readCycles = 0;
+	for ( unsigned int address = 0; address < static_cast<unsigned int>(SRAM_SIZE); address += blockSize )
+	{
+		uint32_t startCycle = DWT->CYCCNT;
+		sram.readBytes( block, blockSize, address );
+		readCycles += DWT->CYCCNT - startCycle;
+
+		for ( unsigned int byte = 0; byte < blockSize; byte++ )
+		{
+			if ( block[byte] != ( address + byte ) % 256 )
+			{
+				dataIsValid = false;
+			}
+		}
+	}
+
+	sramWriteBytesPerSecond = static_cast<float>( SRAM_SIZE ) * SYS_CLOCK_FREQUENCY / writeCycles;
+	sramReadBytesPerSecond = static_cast<float>( SRAM_SIZE ) * SYS_CLOCK_FREQUENCY / readCycles;
+
+	return dataIsValid;
 }
 
-uint8_t readDataFromSRAM (uint16_t address)
+// the CAT24C64 takes up to a page of bytes per write cycle, and each write cycle takes up to 5ms no matter how many bytes
+// are in it. LLPD's i2c transfers take their bytes as variadic arguments and don't report NACKs, so page writes, ACK
+// polling and long sequential reads talk to the I2C2 registers directly (after LLPD has set the peripheral up). every wait
+// is bounded, so a missing or stuck EEPROM fails the transfer instead of hanging the main loop
+class Cat24c64Eeprom : public IARMor8ExternalMemory
 {
-	// pull cs low
-	LLPD::gpio_output_set( GPIO_PORT::B, GPIO_PIN::PIN_12, false );
+public:
+	static const unsigned int PAGE_SIZE = 32;
+	static const unsigned int MAX_READ_SIZE = 255; // the most bytes a single I2C transfer can count
+	static const unsigned int MAX_FLAG_POLLS = 10000; // a byte takes 90us at 100kHz, this is a few byte times at 32MHz
+	static const unsigned int MAX_WRITE_CYCLE_POLLS = 100; // a knock takes about 100us, so this is twice the 5ms write cycle
 
-	LLPD::spi_master_send_and_recieve( SPI_NUM::SPI_2, 0b00000011 );
+	Cat24c64Eeprom (uint8_t slaveAddress) : m_SlaveAddress( slaveAddress ) {}
+	~Cat24c64Eeprom() override {}
 
-	// send first half of address
-	LLPD::spi_master_send_and_recieve( SPI_NUM::SPI_2, (address >> 8) );
+	// splits the write at page boundaries, so each page is a single write cycle
+	bool writeBytes (const uint8_t* data, unsigned int sizeInBytes, unsigned int offsetInBytes) override
+	{
+		while ( sizeInBytes > 0 )
+		{
+			unsigned int bytesLeftInPage = PAGE_SIZE - ( offsetInBytes % PAGE_SIZE );
+			unsigned int bytesToWrite = ( sizeInBytes < bytesLeftInPage ) ? sizeInBytes : bytesLeftInPage;
 
-	// send second half of address
-	LLPD::spi_master_send_and_recieve( SPI_NUM::SPI_2, (address & 0b0000000011111111) );
+			if ( ! this->writePage(data, bytesToWrite, offsetInBytes) || ! this->waitForWriteCycle() )
+			{
+				this->abortTransfer();
+				return false;
+			}
 
-	// recieve data
-	uint8_t data = LLPD::spi_master_send_and_recieve( SPI_NUM::SPI_2, 0b00000000 );
+			data += bytesToWrite;
+			sizeInBytes -= bytesToWrite;
+			offsetInBytes += bytesToWrite;
+		}
 
-	// pull cs high
-	LLPD::gpio_output_set( GPIO_PORT::B, GPIO_PIN::PIN_12, true );
+		return true;
+	}
+
+	// the address only needs to be sent once, after that the EEPROM keeps incrementing it
+	bool readBytes (uint8_t* data, unsigned int sizeInBytes, unsigned int offsetInBytes) override
+	{
+		while ( sizeInBytes > 0 )
+		{
+			unsigned int bytesToRead = ( sizeInBytes < MAX_READ_SIZE ) ? sizeInBytes : MAX_READ_SIZE;
+
+			// address phase, with no stop so the read starts with a repeated start
+			I2C2->CR2 = ( m_SlaveAddress << 1 ) | ( 2 << I2C_CR2_NBYTES_Pos ) | I2C_CR2_START;
+			if ( ! this->transmitByte(offsetInBytes >> 8)
+					|| ! this->transmitByte(offsetInBytes & 0b0000000011111111)
+					|| ! this->waitForFlag(I2C_ISR_TC) )
+			{
+				this->abortTransfer();
+				return false;
+			}
+
+			I2C2->CR2 = ( m_SlaveAddress << 1 ) | I2C_CR2_RD_WRN | ( bytesToRead << I2C_CR2_NBYTES_Pos ) | I2C_CR2_AUTOEND
+					| I2C_CR2_START;
+			for ( unsigned int byte = 0; byte < bytesToRead; byte++ )
+			{
+				if ( ! this->waitForFlag(I2C_ISR_RXNE) )
+				{
+					this->abortTransfer();
+					return false;
+				}
+
+				data[byte] = I2C2->RXDR;
+			}
+
+			if ( ! this->waitForStop() )
+			{
+				this->abortTransfer();
+				return false;
+			}
 
-	// return data from spi
-	return data;
+			data += bytesToRead;
+			sizeInBytes -= bytesToRead;
+			offsetInBytes += bytesToRead;
+		}
+
+		return true;
+	}
+
+private:
+	uint8_t m_SlaveAddress;
+
+	bool writePage (const uint8_t* data, unsigned int sizeInBytes, unsigned int offsetInBytes)
+	{
+		I2C2->CR2 = ( m_SlaveAddress << 1 ) | ( (sizeInBytes + 2) << I2C_CR2_NBYTES_Pos ) | I2C_CR2_AUTOEND | I2C_CR2_START;
+		if ( ! this->transmitByte(offsetInBytes >> 8) || ! this->transmitByte(offsetInBytes & 0b0000000011111111) )
+		{
+			return false;
+		}
+
+		for ( unsigned int byte = 0; byte < sizeInBytes; byte++ )
+		{
+			if ( ! this->transmitByte(data[byte]) )
+			{
+				return false;
+			}
+		}
+
+		return this->waitForStop();
+	}
+
+	// the EEPROM doesn't acknowledge its address until the write cycle is done, so keep knocking instead of delaying 5ms
+	bool waitForWriteCycle()
+	{
+		for ( unsigned int poll = 0; poll < MAX_WRITE_CYCLE_POLLS; poll++ )
+		{
+			I2C2->CR2 = ( m_SlaveAddress << 1 ) | ( 0 << I2C_CR2_NBYTES_Pos ) | I2C_CR2_AUTOEND | I2C_CR2_START;
+			if ( ! this->waitForFlag(I2C_ISR_STOPF) ) // a stop is sent after the address either way
+			{
+				return false;
+			}
+
+			const bool acknowledged = !( I2C2->ISR & I2C_ISR_NACKF );
+			I2C2->ICR = I2C_ICR_NACKCF | I2C_ICR_STOPCF;
+
+			if ( acknowledged )
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// a NACK in the middle of a write means TXIS is never coming
+	bool transmitByte (uint8_t data)
+	{
+		if ( ! this->waitForFlag(I2C_ISR_TXIS | I2C_ISR_NACKF) || (I2C2->ISR & I2C_ISR_NACKF) )
+		{
+			return false;
+		}
+
+		I2C2->TXDR = data;
+
+		return true;
+	}
+
+	bool waitForStop()
+	{
+		if ( ! this->waitForFlag(I2C_ISR_STOPF) )
+		{
+			return false;
+		}
+
+		I2C2->ICR = I2C_ICR_STOPCF;
+
+		return true;
+	}
+
+	// returns false if none of the flags were set in time
+	bool waitForFlag (uint32_t flags)
+	{
+		for ( unsigned int poll = 0; poll < MAX_FLAG_POLLS; poll++ )
+		{
+			if ( I2C2->ISR & flags )
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// turning the peripheral off and on again releases the bus and clears every flag, so the next transfer starts clean.
+	// PE has to stay low for 3 APB clocks, reading it back before setting it again covers that
+	void abortTransfer()
+	{
+		I2C2->CR1 &= ~I2C_CR1_PE;
+		static_cast<void>( I2C2->CR1 );
+		I2C2->CR1 |= I2C_CR1_PE;
+	}
+};
+
+Cat24c64Eeprom eeprom( 0b01010000 ); // A0 = low, A1 = low, A2 = low
+
+// the preset cache is mirrored in the SRAM at boot, so browsing presets doesn't wait on the EEPROM. the delay and chorus
+// effect isn't attached on the target, it lives in the ARMor8VoiceManager and the target still renders a single voice a
+// sample at a time from TIM6_DAC_IRQHandler, so nothing but the main loop ever talks to the SRAM
+const unsigned int SRAM_PRESET_CACHE_OFFSET = 0;
+static_assert( SRAM_PRESET_CACHE_OFFSET + (ARMOR8_PRESET_CACHE_MAX_PRESETS * ARMOR8_PACKED_PRESET_SIZE) <= static_cast<unsigned int>(SRAM_SIZE),
+		"preset cache doesn't fit in the SRAM" );
+
+// a region of the SRAM starting at baseAddress
+class SramMemory : public IARMor8ExternalMemory
+{
+public:
+	SramMemory (unsigned int baseAddress) : m_BaseAddress( baseAddress ) {}
+	~SramMemory() override {}
+
+	bool writeBytes (const uint8_t* data, unsigned int sizeInBytes, unsigned int offsetInBytes) override
+	{
+		sram.writeBytes( data, sizeInBytes, m_BaseAddress + offsetInBytes );
+
+		return true;
+	}
+
+	bool readBytes (uint8_t* data, unsigned int sizeInBytes, unsigned int offsetInBytes) override
+	{
+		sram.readBytes( data, sizeInBytes, m_BaseAddress + offsetInBytes );
+
+		return true;
+	}
+
+	void startWriteBytes (const uint8_t* data, unsigned int sizeInBytes, unsigned int offsetInBytes) override
+	{
+		sram.startWriteBytes( data, sizeInBytes, m_BaseAddress + offsetInBytes );
+	}
+
+	void startReadBytes (uint8_t* data, unsigned int sizeInBytes, unsigned int offsetInBytes) override
+	{
+		sram.startReadBytes( data, sizeInBytes, m_BaseAddress + offsetInBytes );
+	}
+
+	void waitForTransfers() override
+	{
+		sram.waitForTransfers();
+	}
+
+private:
+	unsigned int m_BaseAddress;
+};
+
+/*
+SramMemory sramPresetCacheMemory( SRAM_PRESET_CACHE_OFFSET );
+ARMor8PresetJournal presetJournal( &eeprom, EEPROM_SIZE ); // the presets are journaled, so saves don't wear out one spot
+ARMor8FactoryPresetStore presetStore( &presetJournal ); // presets the user hasn't written come from flash
+ARMor8PresetCache presetCache( &presetStore, &sramPresetCacheMemory );
+ARMor8PresetStorageService presetStorageService( &presetStore );
+// ARMor8VoiceManager armor8VoiceManager( &midiHandler, &presetCache );
+*/
+
+// the DWT cycle counter times the boot and the SRAM benchmark
+void enableCycleCounter()
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
 }
 
-void writeDataToEEPROM (uint16_t address, uint8_t data)
+// raw cycles, the boot sequencer widens them and only converts to microseconds after subtracting, since the counter wraps
+// every couple of minutes
+uint32_t bootClock()
 {
-	// store address in two bytes
-	uint8_t addrH = (address >> 8);
-	uint8_t addrL = (address & 0b0000000011111111);
+	return DWT->CYCCNT;
+}
+
+// the boot tasks, the audio is already running by the time these are called from the main loop so each step should only
+// block for a short while
 
-	// set address to A0 = low, A1 = low, A2 = low
-	LLPD::i2c_master_set_slave_address( I2C_NUM::I2C_2, I2C_ADDR_MODE::BITS_7, 0b01010000 );
+bool controlsAreSetUp = false;
+
+bool bootControls (void* context)
+{
+	// LED pin
+	LLPD::gpio_output_setup( GPIO_PORT::A, GPIO_PIN::PIN_0, GPIO_PUPD::NONE, GPIO_OUTPUT_TYPE::PUSH_PULL,
+					GPIO_OUTPUT_SPEED::HIGH );
+
+	// pushbutton setup example
+	LLPD::gpio_digital_input_setup( GPIO_PORT::A, GPIO_PIN::PIN_1, GPIO_PUPD::PULL_DOWN );
 
-	LLPD::i2c_master_write( I2C_NUM::I2C_2, true, 3, addrH, addrL, data );
+	// the ADC itself is set up in main() before the audio counts as running, since adc_init() uses the delay function
+
+	controlsAreSetUp = true;
+
+	return true;
 }
 
-uint8_t readDataFromEEPROM (uint16_t address)
+bool bootSram (void* context)
 {
-	// store address in two bytes
-	uint8_t addrH = (address >> 8);
-	uint8_t addrL = (address & 0b0000000011111111);
+	// put the SRAM in sequential mode
+	sram.init();
+
+	/*
+	// test all addresses in SRAM, and measure the throughput of preset sized and large transfers
+	if ( ! benchmarkSram(sizeof(ARMor8PackedPreset)) || ! benchmarkSram(1024) )
+	{
+		keepBlinking = false;
+	}
+	*/
+
+	return true;
+}
 
-	// set address to A0 = low, A1 = low, A2 = low
-	LLPD::i2c_master_set_slave_address( I2C_NUM::I2C_2, I2C_ADDR_MODE::BITS_7, 0b01010000 );
+enum class PresetBootStage : unsigned int
+{
+	SETUP_I2C,
+	MOUNT_JOURNAL,
+	LOAD_CACHE
+};
 
-	// send address bytes
-	LLPD::i2c_master_write( I2C_NUM::I2C_2, false, 2, addrH, addrL );
+PresetBootStage presetBootStage = PresetBootStage::SETUP_I2C;
 
-	// variable to store data
-	uint8_t data = 45;
-	LLPD::i2c_master_read( I2C_NUM::I2C_2, true, 1, &data );
+// a record or preset per step, so the main loop never waits on the whole EEPROM
+bool bootPresets (void* context)
+{
+	switch ( presetBootStage )
+	{
+		case PresetBootStage::SETUP_I2C:
+			// i2c setup (8MHz source 100KHz clock 0x00201D2B, 32MHz source 100KHz clock 0x00B07CB4)
+			LLPD::i2c_master_setup( I2C_NUM::I2C_2, 0x00B07CB4 );
 
-	return data;
+			/*
+			// test all addresses in EEPROM, a page at a time (this overwrites the user presets)
+			for ( int address = 0; address < EEPROM_SIZE; address += Cat24c64Eeprom::PAGE_SIZE )
+			{
+				uint8_t dataToWrite[Cat24c64Eeprom::PAGE_SIZE];
+				uint8_t dataRead[Cat24c64Eeprom::PAGE_SIZE];
+				for ( unsigned int byte = 0; byte < Cat24c64Eeprom::PAGE_SIZE; byte++ )
+				{
+					dataToWrite[byte] = ( address + byte ) % 256;
+				}
+
+				if ( ! eeprom.writeBytes(dataToWrite, Cat24c64Eeprom::PAGE_SIZE, address)
+						|| ! eeprom.readBytes(dataRead, Cat24c64Eeprom::PAGE_SIZE, address)
+						|| memcmp(dataRead, dataToWrite, Cat24c64Eeprom::PAGE_SIZE) != 0 )
+				{
+					keepBlinking = false;
+					break;
+				}
+			}
+			*/
+
+			// find the latest copy of each user preset, a blank EEPROM just means every preset is a factory preset
+			// presetJournal.beginMount();
+			presetBootStage = PresetBootStage::MOUNT_JOURNAL;
+
+			return false;
+		case PresetBootStage::MOUNT_JOURNAL:
+			// if ( ! presetJournal.mountNextRecord() )
+			// {
+			// 	return false;
+			// }
+
+			// presetCache.beginLoad();
+			presetBootStage = PresetBootStage::LOAD_CACHE;
+
+			return false;
+		case PresetBootStage::LOAD_CACHE:
+			// if ( ! presetCache.loadNextPreset() )
+			// {
+			// 	return false;
+			// }
+
+			// armor8VoiceManager.setState( ARMor8PresetCodec::unpack(presetCache.retrievePreset(0)) );
+
+			return true;
+		default:
+			return true;
+	}
 }
 
-int main(void)
+void usartTransmitString (const char* str)
 {
-	ARMor8VoiceState state =
-	{
-		// operator 1
-		500.0f, // freq1
-		false, // useRatio
-		OscillatorMode::SAWTOOTH,// wave
-		0.02f, // attack
-		0.0f, // attack expo
-		0.02f, // decay
-		0.0f, // decay expo
-		1.0f, // sustain
-		0.02f, // release
-		0.0f, // release expo
-		false, // amp mod
-		false, // freq mod
-		false, // filter mod
-		0.0f, // op1 mod
-		0.0f, // op2 mod
-		0.0f, // op3 mod
-		0.0f, // op4 mod
-		1.0f, // amplitude
-		20000.0f, // filter freq
-		0.0f, // filter res
-		0.0f, // amp vel sens
-		0.0f, // filt vel res
-		0, // detune
-
-		// operator 2
-		500.0f, // freq
-		false, // useRatio
-		OscillatorMode::SINE,// wave
-		0.02f, // attack
-		0.0f, // attack expo
-		0.02f, // decay
-		0.0f, // decay expo
-		1.0f, // sustain
-		0.02f, // release
-		0.0f, // release expo
-		false, // amp mod
-		false, // freq mod
-		false, // filter mod
-		0.0f, // op1 mod
-		0.0f, // op2 mod
-		0.0f, // op3 mod
-		0.0f, // op4 mod
-		0.0f, // amplitude
-		20000.0f, // filter freq
-		0.0f, // filter res
-		0.0f, // amp vel sens
-		0.0f, // filt vel res
-		0, // detune
-
-		// operator 3
-		500.0f, // freq
-		false, // useRatio
-		OscillatorMode::SINE,// wave
-		0.02f, // attack
-		0.0f, // attack expo
-		0.02f, // decay
-		0.0f, // decay expo
-		1.0f, // sustain
-		0.02f, // release
-		0.0f, // release expo
-		false, // amp mod
-		false, // freq mod
-		false, // filter mod
-		0.0f, // op1 mod
-		0.0f, // op2 mod
-		0.0f, // op3 mod
-		0.0f, // op4 mod
-		0.0f, // amplitude
-		20000.0f, // filter freq
-		0.0f, // filter res
-		0.0f, // amp vel sens
-		0.0f, // filt vel res
-		0, // detune
-
-		// operator 4
-		500.0f, // freq
-		false, // useRatio
-		OscillatorMode::SINE,// wave
-		0.02f, // attack
-		0.0f, // attack expo
-		0.02f, // decay
-		0.0f, // decay expo
-		1.0f, // sustain
-		0.02f, // release
-		0.0f, // release expo
-		false, // amp mod
-		false, // freq mod
-		false, // filter mod
-		0.0f, // op1 mod
-		0.0f, // op2 mod
-		0.0f, // op3 mod
-		0.0f, // op4 mod
-		0.0f, // amplitude
-		20000.0f, // filter freq
-		0.0f, // filter res
-		0.0f, // amp vel sens
-		0.0f, // filt vel res
-		0, // detune
-
-		// global
-		false, // monophonic
-		0, // pitch bend semitones
-		0.0f, // glide time
-		false // glide retrigger
-	};
+	while ( *str != '\0' )
+	{
+		LLPD::usart_transmit( USART_NUM::USART_3, *str );
+		str++;
+	}
+}
+
+void usartTransmitNumber (uint32_t num)
+{
+	char digits[10];
+	unsigned int numDigits = 0;
+	do
+	{
+		digits[numDigits] = static_cast<char>( '0' + num % 10 );
+		num /= 10;
+		numDigits++;
+	}
+	while ( num > 0 );
+
+	while ( numDigits > 0 )
+	{
+		numDigits--;
+		LLPD::usart_transmit( USART_NUM::USART_3, digits[numDigits] );
+	}
+}
+
+uint16_t usartTestVal = 0;
+
+// the usart transmission test used to block the boot for a quarter of a second at 9600 baud, now it's a byte a step
+bool bootUsart (void* context)
+{
+	if ( usartTestVal == 0 )
+	{
+		// USART setup
+		LLPD::usart_init( USART_NUM::USART_3, USART_WORD_LENGTH::BITS_8, USART_PARITY::EVEN, USART_CONF::TX_AND_RX,
+					USART_STOP_BITS::BITS_1, SYS_CLOCK_FREQUENCY, 9600 );
+	}
 
+	// quick usart transmission test
+	LLPD::usart_transmit( USART_NUM::USART_3, usartTestVal );
+	usartTestVal++;
+
+	return usartTestVal >= 256;
+}
+
+unsigned int bootReportLine = 0;
+
+// sends how long it took to get the audio running and how long each task took over the usart, a line per step
+bool bootReport (void* context)
+{
+	ARMor8BootSequencer* bootSequencer = static_cast<ARMor8BootSequencer*>( context );
+
+	if ( bootReportLine == 0 )
+	{
+		usartTransmitString( "\r\naudio " );
+		usartTransmitNumber( bootSequencer->getTimeToAudio() );
+		usartTransmitString( "us\r\n" );
+	}
+	else
+	{
+		const ARMor8BootTask& task = bootSequencer->getTask( bootReportLine - 1 );
+		usartTransmitString( task.name );
+		usartTransmitString( " " );
+		usartTransmitNumber( task.elapsedMicroseconds );
+		usartTransmitString( "us in " );
+		usartTransmitNumber( task.numSteps );
+		usartTransmitString( " steps\r\n" );
+	}
+
+	bootReportLine++;
+
+	// the report itself is the last task
+	return bootReportLine >= bootSequencer->getNumTasks();
+}
+
+int main(void)
+{
 	ARMor8Voice armVoiceThing;
 	voice = &armVoiceThing;
 
-	voice->setState( state );
+	// the init preset is in flash, so there's a sound as soon as the audio starts without waiting on any storage
+	voice->setState( ARMor8FactoryPresetStore::getFactoryPreset(0) );
+
+	// oversampling stays off (the default) here, four renders per sample don't fit in the 25us between audio interrupts
+	// at 32MHz. measure the ISR with the cycle counter before ever turning it on
 
 	PolyBLEPOsc polyBlepThing;
 	osc = &polyBlepThing;
@@ -246,8 +697,9 @@ int main(void)
 	LLPD::gpio_enable_clock( GPIO_PORT::B );
 	LLPD::gpio_enable_clock( GPIO_PORT::C );
 
-	// i2c setup (8MHz source 100KHz clock 0x00201D2B, 32MHz source 100KHz clock 0x00B07CB4)
-	LLPD::i2c_master_setup( I2C_NUM::I2C_2, 0x00B07CB4 );
+	// boot timing starts once the clock is at full speed, so the clock setup itself isn't counted
+	enableCycleCounter();
+	ARMor8BootSequencer bootSequencer( bootClock, SYS_CLOCK_FREQUENCY / 1000000 );
 
 	// spi init
 	LLPD::spi_master_init( SPI_NUM::SPI_2, SPI_BAUD_RATE::SYSCLK_DIV_BY_2, SPI_CLK_POL::LOW_IDLE, SPI_CLK_PHASE::FIRST,
@@ -260,13 +712,6 @@ int main(void)
 	// set cs high
 	LLPD::gpio_output_set( GPIO_PORT::B, GPIO_PIN::PIN_12, true );
 
-	// LED pin
-	LLPD::gpio_output_setup( GPIO_PORT::A, GPIO_PIN::PIN_0, GPIO_PUPD::NONE, GPIO_OUTPUT_TYPE::PUSH_PULL,
-					GPIO_OUTPUT_SPEED::HIGH );
-
-	// pushbutton setup example
-	LLPD::gpio_digital_input_setup( GPIO_PORT::A, GPIO_PIN::PIN_1, GPIO_PUPD::PULL_DOWN );
-
 	// audio timer setup (for 40 kHz sampling rate at 32 MHz system clock)
 	LLPD::tim6_counter_setup( 1, 800, 40000 );
 	LLPD::tim6_counter_enable_interrupts();
@@ -277,7 +722,9 @@ int main(void)
 	// audio timer start
 	LLPD::tim6_counter_start();
 
-	// ADC setup (note, this must be done after the tim6_counter_start() call since it uses the delay function)
+	// ADC setup (note, this must be done after the tim6_counter_start() call since it uses the delay function). the
+	// audio interrupt doesn't render while a delay is running, so this has to happen before the audio is running,
+	// otherwise it's a dropout. nothing after this point is allowed to use the delay function
 	LLPD::gpio_analog_setup( GPIO_PORT::A, GPIO_PIN::PIN_1 ); // channel 2
 	LLPD::gpio_analog_setup( GPIO_PORT::A, GPIO_PIN::PIN_2 ); // channel 3
 	LLPD::gpio_analog_setup( GPIO_PORT::A, GPIO_PIN::PIN_3 ); // channel 4
@@ -285,65 +732,38 @@ int main(void)
 	LLPD::adc_init( ADC_CYCLES_PER_SAMPLE::CPS_601p5 );
 	LLPD::adc_set_channel_order( 4, ADC_CHANNEL::CHAN_2, ADC_CHANNEL::CHAN_3, ADC_CHANNEL::CHAN_4, ADC_CHANNEL::CHAN_10 );
 
-	// USART setup
-	LLPD::usart_init( USART_NUM::USART_3, USART_WORD_LENGTH::BITS_8, USART_PARITY::EVEN, USART_CONF::TX_AND_RX,
-				USART_STOP_BITS::BITS_1, SYS_CLOCK_FREQUENCY, 9600 );
-	// quick usart transmission test
-	for ( uint16_t val = 0; val < 256; val++ )
-	{
-		LLPD::usart_transmit( USART_NUM::USART_3, val );
-	}
-
-	/*
-	// test all addresses in SRAM
-	for ( int address = 0; address < SRAM_SIZE; address++)
-	{
-		uint8_t dataToWrite = address % 256;
+	bootSequencer.markAudioRunning();
 
-		writeDataToSRAM( address, dataToWrite );
+	// everything else is run a step at a time from the main loop, with the audio already running
+	bootSequencer.addTask( "controls", bootControls, nullptr );
+	bootSequencer.addTask( "sram", bootSram, nullptr );
+	bootSequencer.addTask( "presets", bootPresets, nullptr );
+	bootSequencer.addTask( "usart", bootUsart, nullptr );
+	bootSequencer.addTask( "report", bootReport, &bootSequencer );
 
-		uint8_t dataRead = readDataFromSRAM(address);
-
-		if ( dataRead == dataToWrite && keepBlinking == true )
-		{
-			keepBlinking = true;
-		}
-		else
-		{
-			keepBlinking = false;
-			break;
-		}
-	}
-
-	// test all addresses in EEPROM
-	for ( int address = 0; address < EEPROM_SIZE; address++ )
+	while (1)
 	{
-		uint8_t dataToWrite = address % 256;
-
-		writeDataToEEPROM( address, dataToWrite );
+		bootSequencer.runNextStep();
 
-		if ( readDataFromEEPROM(address) == dataToWrite && keepBlinking == true )
+		if ( controlsAreSetUp )
 		{
-			keepBlinking = true;
+			// do conversion on 4 channels (note: even though we set channel order, adc_gets can be called in any order)
+			LLPD::adc_perform_conversion_sequence();
+			// uint16_t chan2Val = LLPD::adc_get_channel_value( ADC_CHANNEL::CHAN_2 );
+			// uint16_t chan3Val = LLPD::adc_get_channel_value( ADC_CHANNEL::CHAN_3 );
+			// uint16_t chan4Val = LLPD::adc_get_channel_value( ADC_CHANNEL::CHAN_4 );
+			uint16_t chan10Val = LLPD::adc_get_channel_value( ADC_CHANNEL::CHAN_10 );
+
+			ledMax = chan10Val;
 		}
-		else
-		{
-			keepBlinking = false;
-			break;
-		}
-	}
-	*/
-
-	while (1)
-	{
-		// do conversion on 4 channels (note: even though we set channel order, adc_gets can be called in any order)
-		LLPD::adc_perform_conversion_sequence();
-		// uint16_t chan2Val = LLPD::adc_get_channel_value( ADC_CHANNEL::CHAN_2 );
-		// uint16_t chan3Val = LLPD::adc_get_channel_value( ADC_CHANNEL::CHAN_3 );
-		// uint16_t chan4Val = LLPD::adc_get_channel_value( ADC_CHANNEL::CHAN_4 );
-		uint16_t chan10Val = LLPD::adc_get_channel_value( ADC_CHANNEL::CHAN_10 );
 
-		ledMax = chan10Val;
+		// write edited presets back to the EEPROM one at a time while there's nothing else to do, the audio keeps
+		// running from the timer interrupt in the meantime (the cache is only safe to flush once it's loaded)
+		// if ( bootSequencer.isFinished() )
+		// {
+		// 	presetCache.flushDirtyPreset();
+		// 	presetStorageService.processNextRequest();
+		// }
 
 		/*
 		// test pushbutton
@@ -0,0 +1,55 @@
+#include "ARMor8BootSequencer.hpp"
+
+#include <stdio.h>
+
+// a cycle counter at 32 ticks per microsecond, started just short of wrapping
+static const uint32_t TICKS_PER_MICROSECOND = 32;
+static uint32_t clockTicks = 0xFFFFFFFFu - ( 1000 * TICKS_PER_MICROSECOND );
+
+static uint32_t testClock()
+{
+	return clockTicks;
+}
+
+// each step takes 300us, so the counter wraps during the fourth one
+static bool slowStep (void* context)
+{
+	unsigned int* stepsLeft = static_cast<unsigned int*>( context );
+	clockTicks += 300 * TICKS_PER_MICROSECOND;
+	(*stepsLeft)--;
+
+	return *stepsLeft == 0;
+}
+
+static unsigned int numFailures = 0;
+
+static void check (bool passed, const char* what)
+{
+	if ( ! passed )
+	{
+		printf( "FAILED: %s\n", what );
+		numFailures++;
+	}
+}
+
+int main()
+{
+	ARMor8BootSequencer bootSequencer( testClock, TICKS_PER_MICROSECOND );
+
+	clockTicks += 100 * TICKS_PER_MICROSECOND;
+	bootSequencer.markAudioRunning();
+	check( bootSequencer.getTimeToAudio() == 100, "time to audio is converted to microseconds" );
+
+	unsigned int stepsLeft = 10;
+	bootSequencer.addTask( "slow", slowStep, &stepsLeft );
+
+	while ( bootSequencer.runNextStep() ) {}
+
+	printf( "slow task took %uus, boot took %uus\n", bootSequencer.getTask(0).elapsedMicroseconds,
+		bootSequencer.getTimeToFinish() );
+	check( bootSequencer.getTask(0).elapsedMicroseconds == 3000, "a task's time is right across a wrap" );
+	check( bootSequencer.getTask(0).numSteps == 10, "every step is counted" );
+	check( bootSequencer.getTimeToFinish() == 3100, "the boot's time is right across a wrap" );
+
+	return ( numFailures == 0 ) ? 0 : 1;
+}
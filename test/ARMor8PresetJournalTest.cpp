@@ -0,0 +1,148 @@
+#include "ARMor8PresetJournal.hpp"
+
+#include <stdio.h>
+#include <string.h>
+
+// the CAT24C64, in RAM, counting how many times each byte is written
+class TestEeprom : public IARMor8ExternalMemory
+{
+	public:
+		static const unsigned int SIZE = 8192;
+
+		TestEeprom() :
+			m_Data(),
+			m_NumWrites{ 0 },
+			m_MisalignedWrites( 0 ),
+			m_IsResponding( true )
+		{
+			memset( m_Data, 0xFF, sizeof(m_Data) );
+		}
+		~TestEeprom() override {}
+
+		bool writeBytes (const uint8_t* data, unsigned int sizeInBytes, unsigned int offsetInBytes) override
+		{
+			if ( ! m_IsResponding )
+			{
+				return false;
+			}
+
+			// a record has to start on a page of its own, or a torn write could take a neighbouring record with it
+			if ( offsetInBytes % PRESET_JOURNAL_PAGE_SIZE != 0 || sizeInBytes > PRESET_JOURNAL_RECORD_STRIDE )
+			{
+				m_MisalignedWrites++;
+			}
+
+			for ( unsigned int byte = 0; byte < sizeInBytes; byte++ )
+			{
+				m_Data[offsetInBytes + byte] = data[byte];
+				m_NumWrites[offsetInBytes + byte]++;
+			}
+
+			return true;
+		}
+
+		bool readBytes (uint8_t* data, unsigned int sizeInBytes, unsigned int offsetInBytes) override
+		{
+			memcpy( data, &m_Data[offsetInBytes], sizeInBytes );
+
+			return true;
+		}
+
+		// like the I2C transfers timing out on the target
+		void setResponding (bool isResponding) { m_IsResponding = isResponding; }
+
+		unsigned int getMaxNumWrites()
+		{
+			unsigned int maxNumWrites = 0;
+			for ( unsigned int byte = 0; byte < SIZE; byte++ )
+			{
+				maxNumWrites = ( m_NumWrites[byte] > maxNumWrites ) ? m_NumWrites[byte] : maxNumWrites;
+			}
+
+			return maxNumWrites;
+		}
+
+		unsigned int getNumMisalignedWrites() { return m_MisalignedWrites; }
+
+	private:
+		uint8_t      m_Data[SIZE];
+		unsigned int m_NumWrites[SIZE];
+		unsigned int m_MisalignedWrites;
+		bool         m_IsResponding;
+};
+
+static unsigned int numFailures = 0;
+
+static void check (bool passed, const char* what)
+{
+	if ( ! passed )
+	{
+		printf( "FAILED: %s\n", what );
+		numFailures++;
+	}
+}
+
+static ARMor8PackedPreset makePreset (unsigned int seed)
+{
+	ARMor8PackedPreset preset;
+	for ( unsigned int byte = 0; byte < ARMOR8_PACKED_PRESET_SIZE; byte++ )
+	{
+		preset.data[byte] = static_cast<uint8_t>( seed + byte );
+	}
+
+	return preset;
+}
+
+int main()
+{
+	const unsigned int NUM_SAVES = 1000;
+
+	TestEeprom eeprom;
+	ARMor8PresetJournal journal( &eeprom, TestEeprom::SIZE );
+	check( ! journal.mount(), "blank eeprom mounts with no presets" );
+
+	const unsigned int numPresets = journal.getMaxNumPresets();
+	check( numPresets == (TestEeprom::SIZE / PRESET_JOURNAL_RECORD_STRIDE) - PRESET_JOURNAL_SPARE_RECORDS,
+		"every record past the spares holds a preset" );
+
+	// fill the bank, then keep saving the same preset
+	for ( unsigned int presetNum = 0; presetNum < numPresets; presetNum++ )
+	{
+		check( journal.writePreset(makePreset(presetNum), presetNum), "presets are written to a working eeprom" );
+	}
+
+	for ( unsigned int save = 0; save < NUM_SAVES; save++ )
+	{
+		journal.writePreset( makePreset(save), 0 );
+	}
+
+	// a write the eeprom doesn't take is reported, and the last good copy is kept
+	eeprom.setResponding( false );
+	check( ! journal.writePreset(makePreset(NUM_SAVES), 0), "a failed write is reported" );
+	eeprom.setResponding( true );
+
+	// the saves rotate over the spares and the preset's own record, plus the write that filled the bank
+	const unsigned int maxNumWrites = eeprom.getMaxNumWrites();
+	printf( "%u saves of one preset on a full bank, at most %u writes to the same byte\n", NUM_SAVES, maxNumWrites );
+	check( maxNumWrites <= (NUM_SAVES / (PRESET_JOURNAL_SPARE_RECORDS + 1)) + 2, "saves are spread over the spare records" );
+	check( eeprom.getNumMisalignedWrites() == 0, "records are written a whole page stride at a time" );
+
+	// nothing is lost across a remount
+	ARMor8PresetJournal remounted( &eeprom, TestEeprom::SIZE );
+	check( remounted.mount(), "written eeprom mounts" );
+
+	ARMor8PackedPreset expected = makePreset( NUM_SAVES - 1 );
+	check( memcmp(journal.retrievePreset(0).data, expected.data, ARMOR8_PACKED_PRESET_SIZE) == 0,
+		"the last good save of preset 0 is still served after a failed write" );
+	check( memcmp(remounted.retrievePreset(0).data, expected.data, ARMOR8_PACKED_PRESET_SIZE) == 0,
+		"the last save of preset 0 survives a remount" );
+
+	for ( unsigned int presetNum = 1; presetNum < numPresets; presetNum++ )
+	{
+		expected = makePreset( presetNum );
+		check( memcmp(remounted.retrievePreset(presetNum).data, expected.data, ARMOR8_PACKED_PRESET_SIZE) == 0,
+			"the other presets survive a remount" );
+	}
+
+	return ( numFailures == 0 ) ? 0 : 1;
+}
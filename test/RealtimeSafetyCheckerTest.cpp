@@ -0,0 +1,87 @@
+#include "RealtimeSafetyChecker.h"
+
+#include <malloc.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static unsigned int numFailures = 0;
+
+static void check (bool passed, const char* what)
+{
+	if ( ! passed )
+	{
+		printf( "FAILED: %s\n", what );
+		numFailures++;
+	}
+}
+
+// volatile so the compiler can't drop an allocation that's freed right away
+static void* volatile allocation = nullptr;
+
+int main()
+{
+	// nothing outside of a scope counts
+	allocation = malloc( 16 );
+	free( allocation );
+	check( RealtimeSafetyChecker::getNumViolations() == 0, "allocations outside of a scope aren't violations" );
+
+	{
+		RealtimeSafetyScope realtimeSafetyScope;
+		allocation = malloc( 16 );
+	}
+	check( RealtimeSafetyChecker::getNumViolations() > 0, "malloc in a scope is a violation" );
+	free( allocation );
+
+	unsigned int numViolations = RealtimeSafetyChecker::getNumViolations();
+	{
+		RealtimeSafetyScope realtimeSafetyScope;
+		void* ptr = nullptr;
+		if ( posix_memalign(&ptr, 64, 64) == 0 )
+		{
+			allocation = ptr;
+		}
+	}
+	check( RealtimeSafetyChecker::getNumViolations() > numViolations, "posix_memalign in a scope is a violation" );
+	free( allocation );
+
+	numViolations = RealtimeSafetyChecker::getNumViolations();
+	{
+		RealtimeSafetyScope realtimeSafetyScope;
+		allocation = aligned_alloc( 64, 64 );
+	}
+	check( RealtimeSafetyChecker::getNumViolations() > numViolations, "aligned_alloc in a scope is a violation" );
+	free( allocation );
+
+	numViolations = RealtimeSafetyChecker::getNumViolations();
+	{
+		RealtimeSafetyScope realtimeSafetyScope;
+		allocation = memalign( 64, 64 );
+	}
+	check( RealtimeSafetyChecker::getNumViolations() > numViolations, "memalign in a scope is a violation" );
+	free( allocation );
+
+	pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+	numViolations = RealtimeSafetyChecker::getNumViolations();
+	{
+		RealtimeSafetyScope realtimeSafetyScope;
+		if ( pthread_mutex_trylock(&mutex) == 0 )
+		{
+			pthread_mutex_unlock( &mutex );
+		}
+	}
+	check( RealtimeSafetyChecker::getNumViolations() > numViolations, "pthread_mutex_trylock in a scope is a violation" );
+
+	sem_t semaphore;
+	sem_init( &semaphore, 0, 1 );
+	numViolations = RealtimeSafetyChecker::getNumViolations();
+	{
+		RealtimeSafetyScope realtimeSafetyScope;
+		sem_wait( &semaphore ); // already posted, so this doesn't actually wait
+	}
+	check( RealtimeSafetyChecker::getNumViolations() > numViolations, "sem_wait in a scope is a violation" );
+	sem_destroy( &semaphore );
+
+	return ( numFailures == 0 ) ? 0 : 1;
+}